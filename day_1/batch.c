@@ -0,0 +1,53 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cfac/darray.h>
+#include <cfac/log.h>
+#include <cfac/stat.h>
+
+#include "common.h"
+#include "driver.h"
+#include "input.h"
+#include "lib.h"
+
+static STAT_Val solve_input(const InputFile * input, char * result, size_t result_size) {
+  DigitAutomaton automaton = {0};
+  DigitAutomaton reversed  = {0};
+  TRY(build_digit_automaton(&automaton));
+  TRY(build_reversed_digit_automaton(&reversed));
+
+  const SPN_Span buffer        = {.begin = input->data, .element_size = sizeof(char), .len = input->size};
+  uint64_t       sum_of_values = 0;
+  TRY(get_calibration_sum(&automaton, &reversed, buffer, &sum_of_values));
+
+  snprintf(result, result_size, "sum_of_values: %llu", (unsigned long long)sum_of_values);
+
+  return OK;
+}
+
+static STAT_Val solve_file(const char * filename, char * result, size_t result_size) {
+  InputFile input = {0};
+  TRY(map_input_file(filename, &input));
+
+  // the mapping is released whether or not the input could be solved
+  const STAT_Val solve_st = solve_input(&input, result, result_size);
+  TRY(destroy_input_file(&input));
+  TRY(solve_st);
+
+  return OK;
+}
+
+int main(int argc, char ** argv) {
+  BatchConfig config = {0};
+  TRY(parse_batch_args(argc, argv, &config));
+
+  size_t num_failed = 0;
+  TRY(run_batch(&config, solve_file, &num_failed));
+
+  const size_t num_files = config.input_filenames.size;
+  TRY(destroy_batch_config(&config));
+
+  if(num_failed > 0) return LOG_STAT(STAT_ERR_INTERNAL, "failed to solve %zu of %zu files", num_failed, num_files);
+
+  return OK;
+}
@@ -0,0 +1,100 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cfac/log.h>
+#include <cfac/stat.h>
+
+#include "benchmark.h"
+#include "common.h"
+#include "input.h"
+#include "lib.h"
+
+typedef struct Context {
+  const char *   filename;
+  InputFile      input;
+  DigitAutomaton automaton;
+  DigitAutomaton reversed;
+  int            sum_of_values;
+  uint64_t       bulk_sum_of_values;
+} Context;
+
+static STAT_Val parse(void * p) {
+  Context * ctx = p;
+  TRY(map_input_file(ctx->filename, &ctx->input));
+  return OK;
+}
+
+static STAT_Val unparse(void * p) {
+  Context * ctx = p;
+  TRY(destroy_input_file(&ctx->input));
+  return OK;
+}
+
+static STAT_Val solve(void * p) {
+  Context * ctx = p;
+
+  ctx->sum_of_values = 0;
+  for(const SPN_Span * line = DAR_first(&ctx->input.lines); line != DAR_end(&ctx->input.lines); line++) {
+    int value = 0;
+    TRY(get_calibration_value(*line, &value));
+    ctx->sum_of_values += value;
+  }
+
+  return OK;
+}
+
+static STAT_Val solve_with_automaton(void * p) {
+  Context * ctx = p;
+
+  ctx->sum_of_values = 0;
+  for(const SPN_Span * line = DAR_first(&ctx->input.lines); line != DAR_end(&ctx->input.lines); line++) {
+    int value = 0;
+    TRY(get_calibration_value_with_automaton(&ctx->automaton, *line, &value));
+    ctx->sum_of_values += value;
+  }
+
+  return OK;
+}
+
+static STAT_Val solve_from_both_ends(void * p) {
+  Context * ctx = p;
+
+  ctx->sum_of_values = 0;
+  for(const SPN_Span * line = DAR_first(&ctx->input.lines); line != DAR_end(&ctx->input.lines); line++) {
+    int value = 0;
+    TRY(get_calibration_value_from_both_ends(&ctx->automaton, &ctx->reversed, *line, &value));
+    ctx->sum_of_values += value;
+  }
+
+  return OK;
+}
+
+static STAT_Val solve_bulk(void * p) {
+  Context * ctx = p;
+
+  const SPN_Span buffer = {.begin = ctx->input.data, .element_size = sizeof(char), .len = ctx->input.size};
+  TRY(get_calibration_sum(&ctx->automaton, &ctx->reversed, buffer, &ctx->bulk_sum_of_values));
+
+  return OK;
+}
+
+int main(int argc, char ** argv) {
+  BenchConfig config = {0};
+  TRY(parse_bench_args(argc, argv, &config));
+
+  Context ctx = {.filename = config.input_filename};
+  TRY(build_digit_automaton(&ctx.automaton));
+  TRY(build_reversed_digit_automaton(&ctx.reversed));
+
+  const BenchPhase phases[] = {
+      {.name = "parse", .run = parse, .teardown = unparse},
+      {.name = "solve", .setup = parse, .run = solve, .teardown = unparse},
+      {.name = "solve_automaton", .setup = parse, .run = solve_with_automaton, .teardown = unparse},
+      {.name = "solve_from_both_ends", .setup = parse, .run = solve_from_both_ends, .teardown = unparse},
+      {.name = "solve_bulk", .setup = parse, .run = solve_bulk, .teardown = unparse},
+  };
+
+  TRY(run_bench(&config, "day_1", phases, sizeof(phases) / sizeof(phases[0]), &ctx));
+
+  return OK;
+}
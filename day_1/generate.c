@@ -0,0 +1,52 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cfac/log.h>
+#include <cfac/stat.h>
+
+#include "common.h"
+#include "generator.h"
+
+// writes num_lines calibration lines, each of them random letters with at least one digit or spelled-out digit in it
+
+static const char * digit_names[] = {"one", "two", "three", "four", "five", "six", "seven", "eight", "nine"};
+
+static void write_letters(FILE * file, Rng * rng, size_t max_num_letters) {
+  const size_t num_letters = get_random_below(rng, max_num_letters + 1);
+  for(size_t i = 0; i < num_letters; i++) { fputc('a' + (int)get_random_below(rng, 26), file); }
+}
+
+static void write_line(FILE * file, Rng * rng) {
+  const size_t num_digits = get_random_in_range(rng, 1, 4);
+
+  write_letters(file, rng, 8);
+  for(size_t i = 0; i < num_digits; i++) {
+    const size_t digit = get_random_in_range(rng, 1, 9);
+    if(get_random_below(rng, 2) == 0) {
+      fputc('0' + (int)digit, file);
+    } else {
+      fputs(digit_names[digit - 1], file);
+    }
+    write_letters(file, rng, 8);
+  }
+  fputc('\n', file);
+}
+
+int main(int argc, char ** argv) {
+  GeneratorConfig config = {.seed = 1, .sizes = {1000}};
+  TRY(parse_generator_args(argc, argv, "[num_lines]", 1, &config));
+
+  const size_t num_lines = config.sizes[0];
+
+  Rng rng = {0};
+  seed_rng(&rng, config.seed);
+
+  FILE * file = NULL;
+  TRY(open_generator_output(&config, &file));
+
+  for(size_t i = 0; i < num_lines; i++) { write_line(file, &rng); }
+
+  TRY(close_generator_output(file));
+
+  return OK;
+}
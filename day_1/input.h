@@ -0,0 +1,40 @@
+#ifndef input_h
+#define input_h
+
+#include <cfac/darray.h>
+#include <cfac/span.h>
+#include <cfac/stat.h>
+
+#include <stdbool.h>
+
+typedef struct InputFile {
+  const char * data; // read-only mapping of the whole file
+  size_t       size;
+  DAR_DArray   lines; // contains SPN_Span of char, pointing into data, each including its trailing '\n' (if any)
+} InputFile;
+
+STAT_Val map_input_file(const char * filename, InputFile * input);
+
+STAT_Val destroy_input_file(InputFile * input);
+
+#define LINE_READER_BUFFER_SIZE (64 * 1024)
+
+typedef struct LineReader {
+  int    fd;
+  bool   owns_fd;
+  bool   is_eof;
+  size_t begin;       // start of the data not yet handed out as lines
+  size_t scanned_end; // end of the data already searched for a newline
+  size_t end;         // end of the data read into the buffer
+  char   buffer[LINE_READER_BUFFER_SIZE];
+} LineReader;
+
+// filename "-" reads from stdin
+STAT_Val open_line_reader(const char * filename, LineReader * reader);
+
+// line stays valid until the next call, includes its trailing '\n' (if any), returns STAT_OK_NOT_FOUND when done
+STAT_Val read_next_line(LineReader * reader, SPN_Span * line);
+
+STAT_Val close_line_reader(LineReader * reader);
+
+#endif
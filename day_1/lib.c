@@ -5,6 +5,12 @@
 #include <cfac/darray.h>
 
 #include <math.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HAS_X86_SIMD
+#endif
 
 #include "common.h"
 
@@ -67,4 +73,416 @@ STAT_Val get_calibration_value(SPN_Span line, int * value) {
   TRY(DAR_destroy(&digits));
 
   return STAT_OK;
-}
\ No newline at end of file
+}
+
+typedef struct AutomatonBuilder {
+  DigitAutomaton * automaton;
+  size_t           num_states;
+  size_t           num_symbols;
+} AutomatonBuilder;
+
+static STAT_Val add_digit_word(AutomatonBuilder * builder, const char * word, int digit, bool is_reversed) {
+  DigitAutomaton * automaton = builder->automaton;
+
+  const size_t len = strlen(word);
+
+  size_t state = 0;
+  for(size_t i = 0; i < len; i++) {
+    const char c      = word[is_reversed ? (len - 1 - i) : i];
+    uint8_t *  symbol = &automaton->symbols[(uint8_t)c];
+    if(*symbol == 0) {
+      CHECK(builder->num_symbols < DIGIT_AUTOMATON_NUM_SYMBOLS);
+      *symbol = (uint8_t)(builder->num_symbols++);
+    }
+
+    // while building, a zero transition means there is no child yet (the root is never a child)
+    if(automaton->next_states[state][*symbol] == 0) {
+      CHECK(builder->num_states < DIGIT_AUTOMATON_NUM_STATES);
+      automaton->next_states[state][*symbol] = (uint8_t)(builder->num_states++);
+    }
+    state = automaton->next_states[state][*symbol];
+  }
+
+  automaton->digits[state] = (int8_t)digit;
+
+  return OK;
+}
+
+static STAT_Val build_automaton(DigitAutomaton * automaton, bool is_reversed) {
+  CHECK(automaton != NULL);
+
+  *automaton = (DigitAutomaton){0};
+  memset(automaton->digits, -1, sizeof(automaton->digits));
+
+  AutomatonBuilder builder = {.automaton = automaton, .num_states = 1 /* the root */, .num_symbols = 1 /* the rest */};
+  for(int digit = 0; digit <= 9; digit++) {
+    const char numeric[] = {(char)('0' + digit), '\0'};
+    TRY(add_digit_word(&builder, numeric, digit, is_reversed));
+    TRY(add_digit_word(&builder, g_text_digits[digit], digit, is_reversed));
+  }
+  CHECK(builder.num_symbols == DIGIT_AUTOMATON_NUM_SYMBOLS);
+
+  // breadth first, so the failure state of every state is complete before it is used
+  uint8_t failures[DIGIT_AUTOMATON_NUM_STATES] = {0};
+  uint8_t queue[DIGIT_AUTOMATON_NUM_STATES]    = {0};
+  size_t  queue_begin                          = 0;
+  size_t  queue_end                            = 0;
+
+  queue[queue_end++] = 0;
+  while(queue_begin != queue_end) {
+    const uint8_t state = queue[queue_begin++];
+
+    for(size_t symbol = 0; symbol < DIGIT_AUTOMATON_NUM_SYMBOLS; symbol++) {
+      uint8_t *     next    = &automaton->next_states[state][symbol];
+      const uint8_t failure = (state == 0) ? 0 : automaton->next_states[failures[state]][symbol];
+
+      if(*next == 0) {
+        *next = failure; // no child, continue from the longest suffix that is a prefix of some word
+        continue;
+      }
+
+      failures[*next] = failure;
+      if(automaton->digits[*next] < 0) automaton->digits[*next] = automaton->digits[failure];
+
+      CHECK(queue_end < DIGIT_AUTOMATON_NUM_STATES);
+      queue[queue_end++] = *next;
+    }
+  }
+
+  return OK;
+}
+
+STAT_Val build_digit_automaton(DigitAutomaton * automaton) { return build_automaton(automaton, false); }
+
+STAT_Val build_reversed_digit_automaton(DigitAutomaton * automaton) { return build_automaton(automaton, true); }
+
+STAT_Val get_calibration_value_with_automaton(const DigitAutomaton * automaton, SPN_Span line, int * value) {
+  CHECK(automaton != NULL);
+  CHECK(value != NULL);
+  CHECK(line.len >= 2);
+
+  const uint8_t * bytes = line.begin;
+
+  int    first_digit = -1;
+  int    last_digit  = -1;
+  size_t state       = 0;
+  for(size_t i = 0; i < line.len; i++) {
+    state = automaton->next_states[state][automaton->symbols[bytes[i]]];
+
+    const int digit = automaton->digits[state];
+    if(digit >= 0) {
+      if(first_digit < 0) first_digit = digit;
+      last_digit = digit;
+    }
+  }
+
+  CHECK(first_digit >= 0);
+
+  *value = (first_digit * 10) + last_digit;
+
+  return OK;
+}
+
+// returns STAT_OK_NOT_FOUND if there is no digit in bytes
+static STAT_Val find_first_digit(const DigitAutomaton * automaton, const uint8_t * bytes, size_t len, int * digit) {
+  size_t state = 0;
+  for(size_t i = 0; i < len; i++) {
+    state = automaton->next_states[state][automaton->symbols[bytes[i]]];
+    if(automaton->digits[state] >= 0) {
+      *digit = automaton->digits[state];
+      return OK;
+    }
+  }
+
+  return STAT_OK_NOT_FOUND;
+}
+
+static STAT_Val find_last_digit(const DigitAutomaton * reversed, const uint8_t * bytes, size_t len, int * digit) {
+  size_t state = 0;
+  for(size_t i = len; i > 0; i--) {
+    state = reversed->next_states[state][reversed->symbols[bytes[i - 1]]];
+    if(reversed->digits[state] >= 0) {
+      *digit = reversed->digits[state];
+      return OK;
+    }
+  }
+
+  return STAT_OK_NOT_FOUND;
+}
+
+STAT_Val get_calibration_value_from_both_ends(const DigitAutomaton * automaton,
+                                              const DigitAutomaton * reversed,
+                                              SPN_Span               line,
+                                              int *                  value) {
+  CHECK(automaton != NULL);
+  CHECK(reversed != NULL);
+  CHECK(value != NULL);
+  CHECK(line.len >= 2);
+
+  int first_digit = 0;
+  int last_digit  = 0;
+  CHECK(find_first_digit(automaton, line.begin, line.len, &first_digit) == OK);
+  CHECK(find_last_digit(reversed, line.begin, line.len, &last_digit) == OK);
+
+  *value = (first_digit * 10) + last_digit;
+
+  return OK;
+}
+
+#define NO_POS SIZE_MAX
+
+// bitmasks of the newlines and the numeric digits in 64 bytes, bit i is byte i
+typedef uint64_t (*GetBlockMasksFn)(const uint8_t * block, uint64_t * digits);
+
+#ifdef HAS_X86_SIMD
+static inline uint64_t get_block_masks_sse2(const uint8_t * block, uint64_t * digits) {
+  const __m128i newline = _mm_set1_epi8('\n');
+  const __m128i zero    = _mm_set1_epi8('0');
+  const __m128i nine    = _mm_set1_epi8(9);
+
+  uint64_t newlines = 0;
+  *digits           = 0;
+  for(size_t i = 0; i < 64; i += 16) {
+    const __m128i bytes  = _mm_loadu_si128((const __m128i *)&block[i]);
+    const __m128i offset = _mm_sub_epi8(bytes, zero); // a digit iff 0 <= offset <= 9, unsigned
+
+    newlines |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, newline)) << i;
+    *digits |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(offset, nine), offset)) << i;
+  }
+
+  return newlines;
+}
+
+__attribute__((target("avx2"))) static inline uint64_t get_block_masks_avx2(const uint8_t * block, uint64_t * digits) {
+  const __m256i newline = _mm256_set1_epi8('\n');
+  const __m256i zero    = _mm256_set1_epi8('0');
+  const __m256i nine    = _mm256_set1_epi8(9);
+
+  uint64_t newlines = 0;
+  *digits           = 0;
+  for(size_t i = 0; i < 64; i += 32) {
+    const __m256i bytes  = _mm256_loadu_si256((const __m256i *)&block[i]);
+    const __m256i offset = _mm256_sub_epi8(bytes, zero);
+
+    newlines |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, newline)) << i;
+    *digits |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_min_epu8(offset, nine), offset)) << i;
+  }
+
+  return newlines;
+}
+#else
+static inline uint64_t get_block_masks_scalar(const uint8_t * block, uint64_t * digits) {
+  uint64_t newlines = 0;
+  *digits           = 0;
+  for(size_t i = 0; i < 64; i++) {
+    newlines |= (uint64_t)(block[i] == '\n') << i;
+    *digits |= (uint64_t)((uint8_t)(block[i] - '0') <= 9) << i;
+  }
+
+  return newlines;
+}
+#endif
+
+// the numeric digits are already known, spelled ones can only come before the first or after the last of them
+static STAT_Val add_line_value(const DigitAutomaton * automaton,
+                               const DigitAutomaton * reversed,
+                               const uint8_t *        bytes,
+                               size_t                 line_begin,
+                               size_t                 line_end,
+                               size_t                 first_pos,
+                               size_t                 last_pos,
+                               uint64_t *             sum) {
+  int first_digit = 0;
+  int last_digit  = 0;
+
+  const size_t prefix_end = (first_pos == NO_POS) ? line_end : first_pos;
+  if(find_first_digit(automaton, &bytes[line_begin], prefix_end - line_begin, &first_digit) != OK) {
+    CHECK(first_pos != NO_POS); // a line without digits
+    first_digit = bytes[first_pos] - '0';
+  }
+
+  const size_t suffix_begin = (last_pos == NO_POS) ? line_begin : (last_pos + 1);
+  if(find_last_digit(reversed, &bytes[suffix_begin], line_end - suffix_begin, &last_digit) != OK) {
+    CHECK(last_pos != NO_POS);
+    last_digit = bytes[last_pos] - '0';
+  }
+
+  *sum += (uint64_t)((first_digit * 10) + last_digit);
+
+  return OK;
+}
+
+static inline __attribute__((always_inline)) STAT_Val sum_calibration_values(const DigitAutomaton * automaton,
+                                                                             const DigitAutomaton * reversed,
+                                                                             const uint8_t *        bytes,
+                                                                             size_t                 len,
+                                                                             GetBlockMasksFn        get_block_masks,
+                                                                             uint64_t *             sum) {
+  size_t line_begin = 0;
+  size_t first_pos  = NO_POS; // of a numeric digit in the current line
+  size_t last_pos   = NO_POS;
+
+  uint8_t tail[64] = {0}; // the last partial block is copied here, so no load reads past the buffer
+
+  for(size_t block_begin = 0; block_begin < len; block_begin += 64) {
+    const size_t    block_len = ((len - block_begin) < 64) ? (len - block_begin) : 64;
+    const uint8_t * block     = &bytes[block_begin];
+    if(block_len < 64) {
+      memcpy(tail, block, block_len);
+      block = tail;
+    }
+
+    uint64_t digits   = 0;
+    uint64_t newlines = get_block_masks(block, &digits);
+    if(block_len < 64) {
+      const uint64_t in_buffer = (1ull << block_len) - 1;
+      digits &= in_buffer;
+      newlines &= in_buffer;
+    }
+
+    while(true) {
+      const uint64_t before_newline = (newlines == 0) ? UINT64_MAX : ((newlines & -newlines) - 1);
+      const uint64_t line_digits    = digits & before_newline;
+      if(line_digits != 0) {
+        if(first_pos == NO_POS) first_pos = block_begin + (size_t)__builtin_ctzll(line_digits);
+        last_pos = block_begin + 63 - (size_t)__builtin_clzll(line_digits);
+      }
+
+      if(newlines == 0) break; // the line continues in the next block
+
+      const size_t newline_pos = block_begin + (size_t)__builtin_ctzll(newlines);
+      TRY(add_line_value(automaton, reversed, bytes, line_begin, newline_pos, first_pos, last_pos, sum));
+
+      line_begin = newline_pos + 1;
+      first_pos  = NO_POS;
+      last_pos   = NO_POS;
+
+      const uint64_t through_newline = newlines ^ (newlines - 1);
+      digits &= ~through_newline;
+      newlines &= ~through_newline;
+    }
+  }
+
+  if(line_begin < len) TRY(add_line_value(automaton, reversed, bytes, line_begin, len, first_pos, last_pos, sum));
+
+  return OK;
+}
+
+#ifdef HAS_X86_SIMD
+__attribute__((target("avx2"))) static STAT_Val sum_calibration_values_avx2(const DigitAutomaton * automaton,
+                                                                            const DigitAutomaton * reversed,
+                                                                            const uint8_t *        bytes,
+                                                                            size_t                 len,
+                                                                            uint64_t *             sum) {
+  return sum_calibration_values(automaton, reversed, bytes, len, get_block_masks_avx2, sum);
+}
+#endif
+
+STAT_Val get_calibration_sum(const DigitAutomaton * automaton,
+                             const DigitAutomaton * reversed,
+                             SPN_Span               buffer,
+                             uint64_t *             sum) {
+  CHECK(automaton != NULL);
+  CHECK(reversed != NULL);
+  CHECK(buffer.element_size == sizeof(char));
+  CHECK(sum != NULL);
+
+  *sum = 0;
+
+#ifdef HAS_X86_SIMD
+  if(__builtin_cpu_supports("avx2")) {
+    return sum_calibration_values_avx2(automaton, reversed, buffer.begin, buffer.len, sum);
+  }
+  return sum_calibration_values(automaton, reversed, buffer.begin, buffer.len, get_block_masks_sse2, sum);
+#else
+  return sum_calibration_values(automaton, reversed, buffer.begin, buffer.len, get_block_masks_scalar, sum);
+#endif
+}
+
+STAT_Val create_calibration_document(CalibrationDocument * document) {
+  CHECK(document != NULL);
+
+  *document = (CalibrationDocument){0};
+
+  TRY(build_digit_automaton(&document->automaton));
+  TRY(build_reversed_digit_automaton(&document->reversed));
+  TRY(DAR_create(&document->values, sizeof(int)));
+  TRY(DAR_create(&document->partial_line, sizeof(char)));
+
+  return OK;
+}
+
+STAT_Val destroy_calibration_document(CalibrationDocument * document) {
+  CHECK(document != NULL);
+
+  TRY(DAR_destroy(&document->values));
+  TRY(DAR_destroy(&document->partial_line));
+
+  *document = (CalibrationDocument){0};
+
+  return OK;
+}
+
+static STAT_Val append_calibration_line(CalibrationDocument * document, SPN_Span line) {
+  int value = 0;
+  TRY(get_calibration_value_from_both_ends(&document->automaton, &document->reversed, line, &value));
+  TRY(DAR_push_back(&document->values, &value));
+
+  document->sum += (uint64_t)value;
+
+  return OK;
+}
+
+STAT_Val append_calibration_data(CalibrationDocument * document, SPN_Span data) {
+  CHECK(document != NULL);
+  CHECK(data.element_size == sizeof(char));
+
+  const char * p   = data.begin;
+  const char * end = p + data.len;
+  while(p < end) {
+    const char * newline = memchr(p, '\n', (size_t)(end - p));
+    if(newline == NULL) {
+      TRY(DAR_push_back_array(&document->partial_line, p, (size_t)(end - p)));
+      break;
+    }
+
+    SPN_Span line = {.begin = p, .element_size = sizeof(char), .len = (size_t)(newline + 1 - p)};
+    if(!DAR_is_empty(&document->partial_line)) {
+      TRY(DAR_push_back_array(&document->partial_line, line.begin, line.len));
+      line = DAR_to_span(&document->partial_line);
+    }
+
+    TRY(append_calibration_line(document, line));
+    TRY(DAR_clear(&document->partial_line));
+
+    p = newline + 1;
+  }
+
+  return OK;
+}
+
+STAT_Val flush_calibration_data(CalibrationDocument * document) {
+  CHECK(document != NULL);
+
+  if(DAR_is_empty(&document->partial_line)) return OK;
+
+  TRY(append_calibration_line(document, DAR_to_span(&document->partial_line)));
+  TRY(DAR_clear(&document->partial_line));
+
+  return OK;
+}
+
+STAT_Val replace_calibration_line(CalibrationDocument * document, size_t line_idx, SPN_Span line) {
+  CHECK(document != NULL);
+  CHECK(line_idx < document->values.size);
+
+  int new_value = 0;
+  TRY(get_calibration_value_from_both_ends(&document->automaton, &document->reversed, line, &new_value));
+
+  int * value = DAR_get(&document->values, line_idx);
+  document->sum -= (uint64_t)*value;
+  document->sum += (uint64_t)new_value;
+  *value = new_value;
+
+  return OK;
+}
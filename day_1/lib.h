@@ -2,8 +2,64 @@
 #define lib_h
 
 #include <cfac/stat.h>
+#include <cfac/darray.h>
 #include <cfac/span.h>
 
+#include <stdint.h>
+
 STAT_Val get_calibration_value(SPN_Span line, int * value);
 
+#define DIGIT_AUTOMATON_NUM_STATES  48 // root, '0' to '9', and every prefix of "zero" to "nine" (46 when reversed)
+#define DIGIT_AUTOMATON_NUM_SYMBOLS 26 // '0' to '9', the letters used by "zero" to "nine", and everything else
+
+// Aho-Corasick automaton matching '0' to '9' and "zero" to "nine" in a single pass, overlapping matches included
+// (e.g. "twone" yields 2 and 1), build it once and share it, scanning a line does not allocate
+typedef struct DigitAutomaton {
+  uint8_t symbols[256]; // byte -> symbol, 0 for bytes that are not part of any digit
+  uint8_t next_states[DIGIT_AUTOMATON_NUM_STATES][DIGIT_AUTOMATON_NUM_SYMBOLS];
+  int8_t  digits[DIGIT_AUTOMATON_NUM_STATES]; // digit matched on entering a state, -1 if none
+} DigitAutomaton;
+
+STAT_Val build_digit_automaton(DigitAutomaton * automaton);
+
+// matches the same digits, but fed the bytes of a line back to front
+STAT_Val build_reversed_digit_automaton(DigitAutomaton * automaton);
+
+// same result as get_calibration_value, in time linear in the line length
+STAT_Val get_calibration_value_with_automaton(const DigitAutomaton * automaton, SPN_Span line, int * value);
+
+// same result again, but only scans forward up to the first digit and backward down to the last one,
+// so the cost depends on where the digits are rather than on the line length
+STAT_Val get_calibration_value_from_both_ends(const DigitAutomaton * automaton,
+                                              const DigitAutomaton * reversed,
+                                              SPN_Span               line,
+                                              int *                  value);
+
+// sum of the calibration values of all '\n' separated lines in buffer, the newlines and numeric digits are found
+// 64 bytes at a time with SSE2 or AVX2 compares, the automata only see the bytes around them that may spell a digit
+STAT_Val get_calibration_sum(const DigitAutomaton * automaton,
+                             const DigitAutomaton * reversed,
+                             SPN_Span               buffer,
+                             uint64_t *             sum);
+
+// running calibration total of a document that grows or is edited, only the changed lines are looked at again
+typedef struct CalibrationDocument {
+  DigitAutomaton automaton;
+  DigitAutomaton reversed;
+  DAR_DArray     values;       // contains int, one per complete line
+  DAR_DArray     partial_line; // contains char, data appended after the last newline
+  uint64_t       sum;
+} CalibrationDocument;
+
+STAT_Val create_calibration_document(CalibrationDocument * document);
+STAT_Val destroy_calibration_document(CalibrationDocument * document);
+
+// data may end in the middle of a line, that line is counted once the rest of it (and its newline) is appended
+STAT_Val append_calibration_data(CalibrationDocument * document, SPN_Span data);
+
+// counts the partial line at the end of the data as a line of its own, e.g. at the end of the input
+STAT_Val flush_calibration_data(CalibrationDocument * document);
+
+STAT_Val replace_calibration_line(CalibrationDocument * document, size_t line_idx, SPN_Span line);
+
 #endif
\ No newline at end of file
@@ -10,6 +10,9 @@
 static Result setup(void ** env_pp);
 static Result teardown(void ** env_pp);
 
+#define LONG_FILLER                                                                                                    \
+  "abcdfghjklmpqyabcdfghjklmpqyabcdfghjklmpqyabcdfghjklmpqyabcdfghjklmpqyabcdfghjklmpqyabcdfghjklmpqy"
+
 static Result tst_fixture(void * env) {
   Result r = PASS;
 
@@ -87,10 +90,138 @@ static Result tst_get_calibration_value_part_b(void) {
   return r;
 }
 
+static Result tst_get_calibration_value_with_automaton(void) {
+  Result r = PASS;
+
+  DigitAutomaton automaton = {0};
+  DigitAutomaton reversed  = {0};
+  EXPECT_OK(&r, build_digit_automaton(&automaton));
+  EXPECT_OK(&r, build_reversed_digit_automaton(&reversed));
+
+  const char * lines[] = {
+      "12",
+      "25sdasere4",
+      "pqr3stu8vwx",
+      "treb7uchet",
+      "two1nine",
+      "eightwothree",
+      "xtwone3four",
+      "zoneight234",
+      "7pqrstsixteen",
+      "zerozero1\n",
+      "sesevseven2",
+      "thrthreex",
+      "fivone",
+      "nineight",
+      "eightwo",
+      "3seveneightwo",
+      "oneight\n",
+  };
+
+  for(size_t i = 0; i < sizeof(lines) / sizeof(lines[0]); i++) {
+    int expected       = 0;
+    int value          = 0;
+    int value_from_end = 0;
+    EXPECT_OK(&r, get_calibration_value(SPN_from_cstr(lines[i]), &expected));
+    EXPECT_OK(&r, get_calibration_value_with_automaton(&automaton, SPN_from_cstr(lines[i]), &value));
+    EXPECT_OK(&r,
+              get_calibration_value_from_both_ends(&automaton, &reversed, SPN_from_cstr(lines[i]), &value_from_end));
+    EXPECT_EQ(&r, expected, value);
+    EXPECT_EQ(&r, expected, value_from_end);
+    if(HAS_FAILED(&r)) {
+      printf("%s: %d != %d, %d\n", lines[i], expected, value, value_from_end);
+      return r;
+    }
+  }
+
+  return r;
+}
+
+static Result tst_get_calibration_sum(void) {
+  Result r = PASS;
+
+  DigitAutomaton automaton = {0};
+  DigitAutomaton reversed  = {0};
+  EXPECT_OK(&r, build_digit_automaton(&automaton));
+  EXPECT_OK(&r, build_reversed_digit_automaton(&reversed));
+
+  uint64_t sum = 0;
+
+  const char * example = "two1nine\n"
+                         "eightwothree\n"
+                         "abcone2threexyz\n"
+                         "xtwone3four\n"
+                         "4nineeightseven2\n"
+                         "zoneight234\n"
+                         "7pqrstsixteen\n";
+  EXPECT_OK(&r, get_calibration_sum(&automaton, &reversed, SPN_from_cstr(example), &sum));
+  EXPECT_EQ(&r, 281, sum);
+
+  // lines crossing 64 byte blocks, digits only spelled out, and a last line without a newline
+  char buffer[512] = {0};
+  snprintf(buffer,
+           sizeof(buffer),
+           "%.100s%s%.70s%s%.40s%s\n%.80sseven%.80s\n5",
+           LONG_FILLER,
+           "one",
+           LONG_FILLER,
+           "8",
+           LONG_FILLER,
+           "nine",
+           LONG_FILLER,
+           LONG_FILLER);
+  EXPECT_OK(&r, get_calibration_sum(&automaton, &reversed, SPN_from_cstr(buffer), &sum));
+  EXPECT_EQ(&r, 19 + 77 + 55, sum);
+
+  EXPECT_OK(&r, get_calibration_sum(&automaton, &reversed, SPN_from_cstr(""), &sum));
+  EXPECT_EQ(&r, 0, sum);
+
+  EXPECT_EQ(&r, STAT_ERR_ASSERTION, get_calibration_sum(&automaton, &reversed, SPN_from_cstr("1\nabc\n"), &sum));
+
+  return r;
+}
+
+static Result tst_calibration_document(void) {
+  Result r = PASS;
+
+  CalibrationDocument document = {0};
+  EXPECT_OK(&r, create_calibration_document(&document));
+
+  // appended in pieces that split lines (and a spelled digit) in odd places
+  EXPECT_OK(&r, append_calibration_data(&document, SPN_from_cstr("two1nine\neigh")));
+  EXPECT_EQ(&r, 1, document.values.size);
+  EXPECT_EQ(&r, 29, document.sum);
+
+  EXPECT_OK(&r, append_calibration_data(&document, SPN_from_cstr("twothree\nabcone2threexyz\n")));
+  EXPECT_OK(&r, append_calibration_data(&document, SPN_from_cstr("xtwone3four")));
+  EXPECT_EQ(&r, 3, document.values.size);
+  EXPECT_EQ(&r, 29 + 83 + 13, document.sum);
+
+  EXPECT_OK(&r, flush_calibration_data(&document));
+  EXPECT_EQ(&r, 4, document.values.size);
+  EXPECT_EQ(&r, 29 + 83 + 13 + 24, document.sum);
+
+  EXPECT_OK(&r, replace_calibration_line(&document, 1, SPN_from_cstr("7pqrstsixteen\n")));
+  EXPECT_EQ(&r, 29 + 76 + 13 + 24, document.sum);
+  EXPECT_EQ(&r, 76, *(int *)DAR_get(&document.values, 1));
+
+  // a bad edit leaves the document as it was
+  EXPECT_EQ(&r, STAT_ERR_ASSERTION, replace_calibration_line(&document, 0, SPN_from_cstr("nothing\n")));
+  EXPECT_EQ(&r, STAT_ERR_ASSERTION, replace_calibration_line(&document, 4, SPN_from_cstr("1\n")));
+  EXPECT_EQ(&r, 29 + 76 + 13 + 24, document.sum);
+
+  EXPECT_OK(&r, destroy_calibration_document(&document));
+
+  return r;
+}
+
 int main(void) {
   Test tests[] = {
       tst_get_calibration_value_part_a,
       tst_get_calibration_value_part_b,
+      tst_get_calibration_value_with_automaton,
+      tst_get_calibration_sum,
+      tst_calibration_document,
   };
 
   TestWithFixture tests_with_fixture[] = {
@@ -5,61 +5,51 @@
 #include <cfac/log.h>
 
 #include "lib.h"
-
-#include <cfac/darray.h>
+#include "metrics.h"
+#include "input.h"
 
 #include "common.h"
 
-static STAT_Val read_lines_from_file(const char * filename, DAR_DArray * lines){
-  CHECK(lines != NULL);
-  CHECK(DAR_is_initialized(lines));
-
-  FILE * file_ptr = fopen(filename, "r");
-  CHECK(file_ptr != NULL);
-  
-  char * line_raw = NULL;
-  size_t len = 0;
-  ssize_t read = 0;
-  
-  while((read = getline(&line_raw, &len, file_ptr)) != -1) {
-    DAR_DArray line = {0};
-    TRY(DAR_create_from_cstr(&line, line_raw));
-    TRY(DAR_push_back(lines, &line));
-  }
-
-  fclose(file_ptr);
-  free(line_raw);
-  
-  return OK;
-}
-
-static STAT_Val destroy_lines(DAR_DArray * lines) {
-  CHECK(lines != NULL);
+int main(int argc, char ** argv) {
+  const char * filename = (argc > 1) ? argv[1] : "input.txt"; // "-" reads from stdin
 
-  for(DAR_DArray * p = DAR_first(lines); p != DAR_end(lines); p++){
-    TRY(DAR_destroy(p));
-  }
-  
-  TRY(DAR_destroy(lines));
+  Metrics metrics = {0};
+  start_metrics(&metrics, "day_1");
 
-  return OK;
-}
+  LineReader reader = {0};
+  begin_phase(&metrics, PHASE_READ);
+  TRY(open_line_reader(filename, &reader));
+  end_phase(&metrics);
 
-int main(void) {
+  begin_phase(&metrics, PHASE_PARSE);
+  DigitAutomaton automaton = {0};
+  DigitAutomaton reversed  = {0};
+  TRY(build_digit_automaton(&automaton));
+  TRY(build_reversed_digit_automaton(&reversed));
+  end_phase(&metrics);
 
-  DAR_DArray lines = {0};
-  TRY(DAR_create(&lines, sizeof(DAR_DArray)));
+  int sum_of_values = 0;
 
-  TRY(read_lines_from_file("input.txt", &lines));
+  SPN_Span line    = {0};
+  STAT_Val read_st = OK;
+  begin_phase(&metrics, PHASE_READ);
+  while((read_st = read_next_line(&reader, &line)) == OK) {
+    end_phase(&metrics);
 
-  int sum_of_values = 0;
-  for(DAR_DArray * line = DAR_first(&lines); line != DAR_end(&lines); line++){
+    begin_phase(&metrics, PHASE_PART1);
     int value = 0;
-    TRY(get_calibration_value(DAR_to_span(line), &value));
+    TRY(get_calibration_value_from_both_ends(&automaton, &reversed, line, &value));
     sum_of_values += value;
+    end_phase(&metrics);
+
+    begin_phase(&metrics, PHASE_READ);
   }
+  end_phase(&metrics);
+  TRY(read_st);
   
-  TRY(destroy_lines(&lines));
+  TRY(close_line_reader(&reader));
+
+  TRY(write_metrics(&metrics));
 
   return LOG_STAT(STAT_OK, "sum_of_values: %d", sum_of_values);
 }
\ No newline at end of file
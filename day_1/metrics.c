@@ -0,0 +1,148 @@
+#include <cfac/log.h>
+
+#include "common.h"
+#include "metrics.h"
+
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <time.h>
+
+static const char * g_phase_names[] = {
+    [PHASE_READ]  = "read",
+    [PHASE_PARSE] = "parse",
+    [PHASE_PART1] = "part1",
+    [PHASE_PART2] = "part2",
+};
+
+static atomic_uint_fast64_t g_num_allocs  = 0;
+static atomic_uint_fast64_t g_alloc_bytes = 0;
+static atomic_uint_fast64_t g_num_frees   = 0;
+
+// the linker sends every malloc/calloc/realloc/free in the executable (cfac's DAR_* and LST_* included) through
+// these, see the --wrap link options on the metrics library
+void * __real_malloc(size_t size);
+void * __real_calloc(size_t num, size_t size);
+void * __real_realloc(void * ptr, size_t size);
+void   __real_free(void * ptr);
+
+void * __wrap_malloc(size_t size);
+void * __wrap_calloc(size_t num, size_t size);
+void * __wrap_realloc(void * ptr, size_t size);
+void   __wrap_free(void * ptr);
+
+static void count_alloc(size_t size) {
+  atomic_fetch_add_explicit(&g_num_allocs, 1, memory_order_relaxed);
+  atomic_fetch_add_explicit(&g_alloc_bytes, size, memory_order_relaxed);
+}
+
+void * __wrap_malloc(size_t size) {
+  count_alloc(size);
+  return __real_malloc(size);
+}
+
+void * __wrap_calloc(size_t num, size_t size) {
+  count_alloc(num * size);
+  return __real_calloc(num, size);
+}
+
+void * __wrap_realloc(void * ptr, size_t size) {
+  count_alloc(size);
+  return __real_realloc(ptr, size);
+}
+
+void __wrap_free(void * ptr) {
+  if(ptr != NULL) atomic_fetch_add_explicit(&g_num_frees, 1, memory_order_relaxed);
+  __real_free(ptr);
+}
+
+AllocStats get_alloc_stats(void) {
+  return (AllocStats){
+      .num_allocs  = atomic_load_explicit(&g_num_allocs, memory_order_relaxed),
+      .alloc_bytes = atomic_load_explicit(&g_alloc_bytes, memory_order_relaxed),
+      .num_frees   = atomic_load_explicit(&g_num_frees, memory_order_relaxed),
+  };
+}
+
+static uint64_t get_time_ns(void) {
+  struct timespec ts = {0};
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ((uint64_t)ts.tv_sec * 1000000000ull) + (uint64_t)ts.tv_nsec;
+}
+
+void start_metrics(Metrics * metrics, const char * name) {
+  *metrics = (Metrics){
+      .name          = name,
+      .filename      = getenv("METRICS_FILE"),
+      .current_phase = NUM_PHASES,
+      .start_ns      = get_time_ns(),
+  };
+}
+
+void begin_phase(Metrics * metrics, MetricsPhase phase) {
+  if(metrics->filename == NULL) return; // nobody reads the phases, so the clock and the counters are not touched
+
+  const AllocStats alloc_stats = get_alloc_stats();
+
+  metrics->current_phase           = phase;
+  metrics->phase_start_num_allocs  = alloc_stats.num_allocs;
+  metrics->phase_start_alloc_bytes = alloc_stats.alloc_bytes;
+  metrics->phase_start_ns          = get_time_ns();
+}
+
+void end_phase(Metrics * metrics) {
+  if(metrics->current_phase == NUM_PHASES) return;
+
+  const uint64_t   end_ns      = get_time_ns();
+  const AllocStats alloc_stats = get_alloc_stats();
+
+  PhaseMetrics * phase = &metrics->phases[metrics->current_phase];
+  phase->wall_ns += end_ns - metrics->phase_start_ns;
+  phase->num_allocs += alloc_stats.num_allocs - metrics->phase_start_num_allocs;
+  phase->alloc_bytes += alloc_stats.alloc_bytes - metrics->phase_start_alloc_bytes;
+
+  metrics->current_phase = NUM_PHASES;
+}
+
+STAT_Val write_metrics(const Metrics * metrics) {
+  CHECK(metrics != NULL);
+  CHECK(metrics->name != NULL);
+
+  const char * filename = metrics->filename;
+  if(filename == NULL) return OK;
+
+  const uint64_t   total_ns    = get_time_ns() - metrics->start_ns;
+  const AllocStats alloc_stats = get_alloc_stats();
+
+  struct rusage usage = {0};
+  CHECK(getrusage(RUSAGE_SELF, &usage) == 0);
+
+  FILE * file = (strcmp(filename, "-") == 0) ? stdout : fopen(filename, "a");
+  if(file == NULL) return LOG_STAT(STAT_ERR_ARGS, "failed to open '%s' for writing", filename);
+
+  fprintf(file, "{\"name\": \"%s\", \"total_ns\": %llu, \"phases\": {", metrics->name, (unsigned long long)total_ns);
+
+  for(MetricsPhase p = PHASE_READ; p != NUM_PHASES; p++) {
+    const PhaseMetrics * phase = &metrics->phases[p];
+    fprintf(file,
+            "%s\"%s\": {\"wall_ns\": %llu, \"allocs\": %llu, \"alloc_bytes\": %llu}",
+            (p == PHASE_READ) ? "" : ", ",
+            g_phase_names[p],
+            (unsigned long long)phase->wall_ns,
+            (unsigned long long)phase->num_allocs,
+            (unsigned long long)phase->alloc_bytes);
+  }
+
+  fprintf(file,
+          "}, \"allocs\": %llu, \"alloc_bytes\": %llu, \"frees\": %llu, \"peak_rss_kb\": %ld}\n",
+          (unsigned long long)alloc_stats.num_allocs,
+          (unsigned long long)alloc_stats.alloc_bytes,
+          (unsigned long long)alloc_stats.num_frees,
+          usage.ru_maxrss); // kilobytes on linux
+
+  if(file != stdout) CHECK(fclose(file) == 0);
+
+  return OK;
+}
@@ -0,0 +1,62 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cfac/darray.h>
+#include <cfac/log.h>
+#include <cfac/stat.h>
+
+#include "common.h"
+#include "driver.h"
+#include "input.h"
+#include "lib.h"
+
+static STAT_Val solve_input(const InputFile * input, char * result, size_t result_size) {
+  size_t   max_dist     = 0;
+  size_t   num_enclosed = 0;
+  Position max_dist_pos = {0};
+
+  PipeSketch sketch = {0};
+  TRY(parse_sketch_cached(input, &sketch));
+  TRY(calculate_distances_from_start(&sketch));
+  TRY(get_max_distance_from_start(&sketch, &max_dist, &max_dist_pos));
+  TRY(determine_enclosed_tiles(&sketch, &num_enclosed));
+
+  TRY(destroy_sketch(&sketch));
+
+  snprintf(result,
+           result_size,
+           "max_dist: %zu, max_dist_pos: (%zu,%zu), num_enclosed: %zu",
+           max_dist,
+           max_dist_pos.x,
+           max_dist_pos.y,
+           num_enclosed);
+
+  return OK;
+}
+
+static STAT_Val solve_file(const char * filename, char * result, size_t result_size) {
+  InputFile input = {0};
+  TRY(map_input_file(filename, &input));
+
+  // the mapping is released whether or not the input could be solved
+  const STAT_Val solve_st = solve_input(&input, result, result_size);
+  TRY(destroy_input_file(&input));
+  TRY(solve_st);
+
+  return OK;
+}
+
+int main(int argc, char ** argv) {
+  BatchConfig config = {0};
+  TRY(parse_batch_args(argc, argv, &config));
+
+  size_t num_failed = 0;
+  TRY(run_batch(&config, solve_file, &num_failed));
+
+  const size_t num_files = config.input_filenames.size;
+  TRY(destroy_batch_config(&config));
+
+  if(num_failed > 0) return LOG_STAT(STAT_ERR_INTERNAL, "failed to solve %zu of %zu files", num_failed, num_files);
+
+  return OK;
+}
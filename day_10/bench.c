@@ -0,0 +1,58 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cfac/log.h>
+#include <cfac/stat.h>
+
+#include "benchmark.h"
+#include "common.h"
+#include "input.h"
+#include "lib.h"
+
+typedef struct Context {
+  InputFile  input;
+  PipeSketch sketch;
+  size_t     max_dist;
+  Position   max_dist_pos;
+  size_t     num_enclosed;
+} Context;
+
+static STAT_Val parse(void * p) {
+  Context * ctx = p;
+  TRY(parse_sketch(&ctx->input.lines, &ctx->sketch));
+  return OK;
+}
+
+static STAT_Val unparse(void * p) {
+  Context * ctx = p;
+  TRY(destroy_sketch(&ctx->sketch));
+  return OK;
+}
+
+static STAT_Val solve(void * p) {
+  Context * ctx = p;
+  TRY(calculate_distances_from_start(&ctx->sketch));
+  TRY(get_max_distance_from_start(&ctx->sketch, &ctx->max_dist, &ctx->max_dist_pos));
+  TRY(determine_enclosed_tiles(&ctx->sketch, &ctx->num_enclosed));
+  return OK;
+}
+
+int main(int argc, char ** argv) {
+  BenchConfig config = {0};
+  TRY(parse_bench_args(argc, argv, &config));
+
+  Context ctx = {0};
+  TRY(map_input_file(config.input_filename, &ctx.input));
+
+  // solving marks up the sketch, so each run gets a freshly parsed one
+  const BenchPhase phases[] = {
+      {.name = "parse", .run = parse, .teardown = unparse},
+      {.name = "solve", .setup = parse, .run = solve, .teardown = unparse},
+  };
+
+  TRY(run_bench(&config, "day_10", phases, sizeof(phases) / sizeof(phases[0]), &ctx));
+
+  TRY(destroy_input_file(&ctx.input));
+
+  return OK;
+}
@@ -24,6 +24,16 @@
     if(!STAT_is_OK(st)) return LOG_STAT(st, "failed: %s", #x);                                                         \
   } while(false)
 
+// for the static inline kernels in the hot loops, their public entry point CHECKs everything once up front,
+// so these only stay in for DEBUG builds (Debug configurations, or the KERNEL_CHECKS cmake option)
+#ifdef DEBUG
+#define KERNEL_CHECK(x)               CHECK(x)
+#define KERNEL_CHECK_WITH_MSG(x, ...) CHECK_WITH_MSG(x, __VA_ARGS__)
+#else
+#define KERNEL_CHECK(x)               do { } while(false)
+#define KERNEL_CHECK_WITH_MSG(x, ...) do { } while(false)
+#endif
+
 static inline size_t min_sz(size_t a, size_t b) { return (a < b) ? a : b; }
 static inline size_t max_sz(size_t a, size_t b) { return (a > b) ? a : b; }
 
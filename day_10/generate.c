@@ -0,0 +1,162 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cfac/darray.h>
+#include <cfac/log.h>
+#include <cfac/stat.h>
+
+#include "common.h"
+#include "generator.h"
+#include "lib.h"
+
+// writes a width x height sketch with one loop through the start tile, and random pipe pieces everywhere else. The loop
+// runs left to right along a random top edge above the middle row, down the last column, right to left along a random
+// bottom edge below the middle row, and up the first column. That keeps it from crossing itself, and the middle row
+// always has enclosed tiles.
+
+static const char junk_pieces[] = "|-LJ7F.......";
+
+static size_t clamp(size_t v, size_t min, size_t max) { return (v < min) ? min : ((v > max) ? max : v); }
+
+static size_t random_walk_step(Rng * rng, size_t v, size_t min, size_t max) {
+  const size_t step = get_random_below(rng, 5); // -2 to +2
+  return clamp((v + step >= 2) ? (v + step - 2) : 0, min, max);
+}
+
+static STAT_Val push_position(DAR_DArray * loop, size_t x, size_t y) {
+  const Position pos = {.x = x, .y = y};
+  TRY(DAR_push_back(loop, &pos));
+  return OK;
+}
+
+static STAT_Val push_vertical(DAR_DArray * loop, size_t x, size_t from_y, size_t to_y) { // excludes from_y
+  while(from_y != to_y) {
+    from_y = (from_y < to_y) ? (from_y + 1) : (from_y - 1);
+    TRY(push_position(loop, x, from_y));
+  }
+  return OK;
+}
+
+static char get_loop_piece(Position prev, Position pos, Position next) {
+  const bool north = (prev.y < pos.y) || (next.y < pos.y);
+  const bool south = (prev.y > pos.y) || (next.y > pos.y);
+  const bool west  = (prev.x < pos.x) || (next.x < pos.x);
+  const bool east  = (prev.x > pos.x) || (next.x > pos.x);
+
+  if(north && south) return '|';
+  if(west && east) return '-';
+  if(north && east) return 'L';
+  if(north && west) return 'J';
+  if(south && west) return '7';
+  return 'F';
+}
+
+static STAT_Val make_loop(Rng * rng, size_t width, size_t height, DAR_DArray * loop) {
+  const size_t mid = height / 2;
+
+  DAR_DArray tops    = {0}; // contains size_t, the row of the top edge per column
+  DAR_DArray bottoms = {0}; // contains size_t, the row of the bottom edge per column
+  TRY(DAR_create(&tops, sizeof(size_t)));
+  TRY(DAR_create(&bottoms, sizeof(size_t)));
+
+  size_t top    = get_random_below(rng, mid);
+  size_t bottom = get_random_in_range(rng, mid + 1, height - 1);
+  for(size_t x = 0; x < width; x++) {
+    TRY(DAR_push_back(&tops, &top));
+    TRY(DAR_push_back(&bottoms, &bottom));
+    top    = random_walk_step(rng, top, 0, mid - 1);
+    bottom = random_walk_step(rng, bottom, mid + 1, height - 1);
+  }
+
+  // the edges go straight into the corners of the loop, so the columns there are only walked once
+  *(size_t *)DAR_last(&tops)     = *(const size_t *)DAR_get(&tops, width - 2);
+  *(size_t *)DAR_first(&bottoms) = *(const size_t *)DAR_get(&bottoms, 1);
+
+  const size_t * t = DAR_first(&tops);
+  const size_t * b = DAR_first(&bottoms);
+
+  TRY(push_position(loop, 0, t[0]));
+  for(size_t x = 0; (x + 1) < width; x++) {
+    TRY(push_position(loop, x + 1, t[x]));
+    TRY(push_vertical(loop, x + 1, t[x], t[x + 1]));
+  }
+  TRY(push_vertical(loop, width - 1, t[width - 1], b[width - 1]));
+  for(size_t x = width - 1; x > 0; x--) {
+    TRY(push_position(loop, x - 1, b[x]));
+    TRY(push_vertical(loop, x - 1, b[x], b[x - 1]));
+  }
+  TRY(push_vertical(loop, 0, b[0], t[0] + 1));
+
+  TRY(DAR_destroy(&tops));
+  TRY(DAR_destroy(&bottoms));
+
+  return OK;
+}
+
+int main(int argc, char ** argv) {
+  GeneratorConfig config = {.seed = 1, .sizes = {140, 140}};
+  TRY(parse_generator_args(argc, argv, "[width [height]]", 2, &config));
+
+  const size_t width  = config.sizes[0];
+  const size_t height = config.sizes[1];
+
+  if(width < 2 || height < 3) return LOG_STAT(STAT_ERR_ARGS, "the sketch needs to be at least 2 x 3");
+
+  Rng rng = {0};
+  seed_rng(&rng, config.seed);
+
+  DAR_DArray tiles = {0}; // contains char, row by row
+  DAR_DArray loop  = {0}; // contains Position, in the order the loop is walked
+  TRY(DAR_create(&tiles, sizeof(char)));
+  TRY(DAR_create(&loop, sizeof(Position)));
+
+  for(size_t i = 0; i < width * height; i++) {
+    const char junk = junk_pieces[get_random_below(&rng, sizeof(junk_pieces) - 1)];
+    TRY(DAR_push_back(&tiles, &junk));
+  }
+
+  TRY(make_loop(&rng, width, height, &loop));
+
+  char *           t = DAR_first(&tiles);
+  const Position * l = DAR_first(&loop);
+
+  // put the start somewhere on the loop, and clear the junk around it, so the only pipes that could connect to the
+  // start are the two that actually do
+  const size_t   start_idx = get_random_below(&rng, loop.size);
+  const Position start     = l[start_idx];
+
+  const Position neighbours[] = {
+      {.x = start.x, .y = start.y - 1},
+      {.x = start.x, .y = start.y + 1},
+      {.x = start.x - 1, .y = start.y},
+      {.x = start.x + 1, .y = start.y},
+  };
+  for(size_t i = 0; i < (sizeof(neighbours) / sizeof(neighbours[0])); i++) {
+    const Position n = neighbours[i];
+    if(n.x >= width || n.y >= height) continue; // also catches wrapping around below zero
+    t[n.x + (n.y * width)] = '.';
+  }
+
+  // then draw the loop over that, its pieces only connect to each other
+  for(size_t i = 0; i < loop.size; i++) {
+    const Position prev = l[(i + loop.size - 1) % loop.size];
+    const Position next = l[(i + 1) % loop.size];
+    t[l[i].x + (l[i].y * width)] = get_loop_piece(prev, l[i], next);
+  }
+  t[start.x + (start.y * width)] = 'S';
+
+  FILE * file = NULL;
+  TRY(open_generator_output(&config, &file));
+
+  for(size_t y = 0; y < height; y++) {
+    fwrite(&t[y * width], sizeof(char), width, file);
+    fputc('\n', file);
+  }
+
+  TRY(close_generator_output(file));
+
+  TRY(DAR_destroy(&loop));
+  TRY(DAR_destroy(&tiles));
+
+  return OK;
+}
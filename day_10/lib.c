@@ -1,5 +1,6 @@
 #include <cfac/log.h>
 
+#include "cache.h"
 #include "common.h"
 #include "lib.h"
 #include <stdio.h>
@@ -19,7 +20,7 @@ static STAT_Val init_sketch(PipeSketch * sketch) {
 
 static bool is_pipe(const Piece * piece) { return (piece->type != GROUND) && (piece->dist_from_start != SIZE_MAX); }
 
-static void print_pipe(const PipeSketch * sketch) {
+void print_pipe(const PipeSketch * sketch) {
   Position pos = {0};
   for(pos.y = 0; pos.y < sketch->height; pos.y++) {
     for(pos.x = 0; pos.x < sketch->width; pos.x++) {
@@ -34,28 +35,28 @@ static void print_pipe(const PipeSketch * sketch) {
   }
 }
 
-STAT_Val parse_sketch(const DAR_DArray * lines, PipeSketch * sketch) {
+STAT_Val parse_sketch(const DAR_DArray * lines /* contains SPN_Span */, PipeSketch * sketch) {
   CHECK(lines != NULL);
   CHECK(DAR_is_initialized(lines) && !DAR_is_empty(lines));
-  CHECK(lines->element_size == sizeof(DAR_DArray));
+  CHECK(lines->element_size == sizeof(SPN_Span));
   CHECK(sketch != NULL);
 
   TRY(init_sketch(sketch));
 
   size_t y = 0;
-  for(const DAR_DArray * line = DAR_first(lines); line != DAR_end(lines); line++, y++) {
-    size_t last_char = line->size - 1;
-    while(!is_valid_sketch_char(*(const char *)DAR_get(line, last_char))) {
+  for(const SPN_Span * line = DAR_first(lines); line != DAR_end(lines); line++, y++) {
+    size_t last_char = line->len - 1;
+    while(!is_valid_sketch_char(*(const char *)SPN_get(*line, last_char))) {
       if(last_char == 0) break;
       last_char--;
     }
     if(last_char > 0) {
       if((sketch->width != (last_char + 1)) && (sketch->width != 0)) {
-        return LOG_STAT(STAT_ERR_READ, "malformed sketch line '%s'", (const char *)line->data);
+        return LOG_STAT(STAT_ERR_READ, "malformed sketch line '%.*s'", (int)line->len, (const char *)line->begin);
       }
       sketch->width = (last_char + 1);
 
-      const char * raw_line = line->data;
+      const char * raw_line = line->begin;
       for(size_t i = 0; i <= last_char; i++) {
         Piece piece = {.type = char_to_piece_type(raw_line[i]), .dist_from_start = SIZE_MAX, .region_id = 0};
         TRY(DAR_push_back(&sketch->pieces, &piece));
@@ -69,6 +70,78 @@ STAT_Val parse_sketch(const DAR_DArray * lines, PipeSketch * sketch) {
   return OK;
 }
 
+// only the piece types are cached, one byte each, the rest of a piece is not known until after parsing
+static STAT_Val read_sketch_from_cache(CacheReader * reader, PipeSketch * sketch) {
+  TRY(init_sketch(sketch));
+  TRY(read_from_cache(reader, &sketch->width, sizeof(sketch->width)));
+  TRY(read_from_cache(reader, &sketch->height, sizeof(sketch->height)));
+  TRY(read_from_cache(reader, &sketch->start_pos, sizeof(sketch->start_pos)));
+
+  const size_t    num_pieces = sketch->width * sketch->height;
+  const uint8_t * types      = NULL;
+  TRY(view_from_cache(reader, num_pieces, (const void **)&types));
+
+  TRY(DAR_reserve(&sketch->pieces, num_pieces));
+  for(size_t i = 0; i < num_pieces; i++) {
+    CHECK(types[i] <= ANIMAL_START);
+    const Piece piece = {.type = (PieceType)types[i], .dist_from_start = SIZE_MAX, .region_id = 0};
+    TRY(DAR_push_back(&sketch->pieces, &piece));
+  }
+
+  TRY(check_cache_fully_read(reader));
+
+  return OK;
+}
+
+static STAT_Val write_sketch_to_cache(CacheWriter * writer, const PipeSketch * sketch) {
+  TRY(write_to_cache(writer, &sketch->width, sizeof(sketch->width)));
+  TRY(write_to_cache(writer, &sketch->height, sizeof(sketch->height)));
+  TRY(write_to_cache(writer, &sketch->start_pos, sizeof(sketch->start_pos)));
+
+  for(const Piece * piece = DAR_first(&sketch->pieces); piece != DAR_end(&sketch->pieces); piece++) {
+    const uint8_t type = (uint8_t)piece->type;
+    TRY(write_to_cache(writer, &type, sizeof(type)));
+  }
+
+  return OK;
+}
+
+STAT_Val parse_sketch_cached(const InputFile * input, PipeSketch * sketch) {
+  CHECK(input != NULL);
+  CHECK(sketch != NULL);
+
+  CacheReader    reader    = {0};
+  const STAT_Val reader_st = open_cache_reader("day_10", input, &reader);
+  TRY(reader_st);
+  if(reader_st == OK) {
+    // a bad entry is still an error, but neither the mapping nor what was read of it so far are left behind
+    const STAT_Val read_st = read_sketch_from_cache(&reader, sketch);
+    TRY(close_cache_reader(&reader));
+    if(!STAT_is_OK(read_st)) TRY(destroy_sketch(sketch));
+    TRY(read_st);
+    return OK;
+  }
+
+  TRY(parse_sketch(&input->lines, sketch));
+
+  CacheWriter    writer    = {0};
+  const STAT_Val writer_st = open_cache_writer("day_10", input, &writer);
+  TRY(writer_st);
+  if(writer_st == OK) {
+    // likewise a failed write drops the partly written entry, and the parsed result with it
+    STAT_Val write_st = write_sketch_to_cache(&writer, sketch);
+    if(STAT_is_OK(write_st)) {
+      write_st = commit_cache_writer(&writer);
+    } else {
+      TRY(abort_cache_writer(&writer));
+    }
+    if(!STAT_is_OK(write_st)) TRY(destroy_sketch(sketch));
+    TRY(write_st);
+  }
+
+  return OK;
+}
+
 STAT_Val destroy_sketch(PipeSketch * sketch) {
   CHECK(sketch != NULL);
   CHECK(DAR_is_initialized(&sketch->pieces));
@@ -79,15 +152,16 @@ STAT_Val destroy_sketch(PipeSketch * sketch) {
   return OK;
 }
 
-static STAT_Val are_pieces_connected(const PipeSketch * sketch, Position pos_a, Position pos_b, bool * out) {
-  CHECK(sketch != NULL);
-  CHECK(out != NULL);
-  CHECK(DAR_is_initialized(&sketch->pieces));
-  CHECK(!DAR_is_empty(&sketch->pieces));
-  CHECK_WITH_MSG(pos_a.x < sketch->width, "pos_a.x < sketch->width: (%zu < %zu)", pos_a.x, sketch->width);
-  CHECK_WITH_MSG(pos_a.y < sketch->height, "pos_a.y < sketch->height: (%zu < %zu)", pos_a.y, sketch->height);
-  CHECK_WITH_MSG(pos_b.x < sketch->width, "pos_b.x < sketch->width: (%zu < %zu)", pos_b.x, sketch->width);
-  CHECK_WITH_MSG(pos_b.y < sketch->height, "pos_b.y < sketch->height: (%zu < %zu)", pos_b.y, sketch->height);
+// kernel, calculate_distances_from_start has already checked the sketch, and the positions come from its own loops
+static inline STAT_Val are_pieces_connected(const PipeSketch * sketch, Position pos_a, Position pos_b, bool * out) {
+  KERNEL_CHECK(sketch != NULL);
+  KERNEL_CHECK(out != NULL);
+  KERNEL_CHECK(DAR_is_initialized(&sketch->pieces));
+  KERNEL_CHECK(!DAR_is_empty(&sketch->pieces));
+  KERNEL_CHECK_WITH_MSG(pos_a.x < sketch->width, "pos_a.x < sketch->width: (%zu < %zu)", pos_a.x, sketch->width);
+  KERNEL_CHECK_WITH_MSG(pos_a.y < sketch->height, "pos_a.y < sketch->height: (%zu < %zu)", pos_a.y, sketch->height);
+  KERNEL_CHECK_WITH_MSG(pos_b.x < sketch->width, "pos_b.x < sketch->width: (%zu < %zu)", pos_b.x, sketch->width);
+  KERNEL_CHECK_WITH_MSG(pos_b.y < sketch->height, "pos_b.y < sketch->height: (%zu < %zu)", pos_b.y, sketch->height);
 
   const Piece * a = get_piece(sketch, pos_a);
   const Piece * b = get_piece(sketch, pos_b);
@@ -103,24 +177,29 @@ static STAT_Val are_pieces_connected(const PipeSketch * sketch, Position pos_a,
   } else if(((pos_a.y + 1) == pos_b.y) && pos_a.x == pos_b.x) {
     // a is SOUTH of b, b is NORTH of a
     *out = (is_connected_to_north(b->type) && is_connected_to_south(a->type));
-  } else if(((pos_a.y - 1) == pos_b.y) && pos_a.x == pos_b.x) {
+  } else {
+    KERNEL_CHECK_WITH_MSG(((pos_a.y - 1) == pos_b.y) && pos_a.x == pos_b.x,
+                          "positions not adjacent: {%zu,%zu} {%zu,%zu}",
+                          pos_a.x,
+                          pos_a.y,
+                          pos_b.x,
+                          pos_b.y);
     // a is NORTH of b, b is SOUTH of a
     *out = (is_connected_to_south(b->type) && is_connected_to_north(a->type));
-  } else {
-    return LOG_STAT(STAT_ERR_ARGS, "positions not adjacent: {%zu,%zu} {%zu,%zu}", pos_a.x, pos_a.y, pos_b.x, pos_b.y);
   }
 
   return OK;
 }
 
-static STAT_Val set_distance_from_start(PipeSketch * sketch, Position pos) {
-  CHECK(sketch != NULL);
-  CHECK(DAR_is_initialized(&sketch->pieces));
-  CHECK(!DAR_is_empty(&sketch->pieces));
-  CHECK(pos.x < sketch->width);
-  CHECK(pos.y < sketch->height);
+// kernel, see are_pieces_connected
+static inline STAT_Val set_distance_from_start(PipeSketch * sketch, Position pos) {
+  KERNEL_CHECK(sketch != NULL);
+  KERNEL_CHECK(DAR_is_initialized(&sketch->pieces));
+  KERNEL_CHECK(!DAR_is_empty(&sketch->pieces));
+  KERNEL_CHECK(pos.x < sketch->width);
+  KERNEL_CHECK(pos.y < sketch->height);
 
-  Piece * target = DAR_get(&sketch->pieces, pos_to_idx(sketch, pos));
+  Piece * target = get_piece(sketch, pos);
 
   const Position adjacents[] = {
       {.x = ((pos.x == 0) ? 0 : (pos.x - 1)), .y = pos.y},      // WEST
@@ -154,14 +233,17 @@ static STAT_Val set_distance_from_start(PipeSketch * sketch, Position pos) {
 STAT_Val calculate_distances_from_start(PipeSketch * sketch) {
   CHECK(sketch != NULL);
   CHECK(DAR_is_initialized(&sketch->pieces));
+  CHECK(!DAR_is_empty(&sketch->pieces));
+  CHECK(sketch->pieces.size == (sketch->width * sketch->height));
+  CHECK(sketch->start_pos.x < sketch->width);
+  CHECK(sketch->start_pos.y < sketch->height);
 
   get_piece(sketch, sketch->start_pos)->dist_from_start = 0;
 
   // fill in all distances repeatedly until we reach a fixed point (i.e. the values stop changing)
   // THIS IS VERY INEFFICIENT, I started with the idea that it would be more efficient than recursion if done properly,
   // but I never got around to doing it properly. It works though.
-  size_t num_iterations = 0;
-  bool   is_fixed_point = false;
+  bool is_fixed_point = false;
   do {
     is_fixed_point = true;
 
@@ -178,15 +260,8 @@ STAT_Val calculate_distances_from_start(PipeSketch * sketch) {
         }
       }
     }
-    num_iterations++;
-
-    if((num_iterations & 0xff) == 0) LOG_STAT(STAT_OK, "iteration %zu", num_iterations);
   } while(!is_fixed_point);
 
-  LOG_STAT(STAT_OK, "took %zu iterations to get to fixed point", num_iterations);
-
-  print_pipe(sketch);
-
   return OK;
 }
 
@@ -241,7 +316,7 @@ static STAT_Val grow_region_of_ground(PipeSketch * sketch, Position pos, size_t
   return OK;
 }
 
-static void print_sketch(const PipeSketch * sketch) {
+void print_sketch(const PipeSketch * sketch) {
   Position pos = {0};
   for(pos.y = 0; pos.y < sketch->height; pos.y++) {
     for(pos.x = 0; pos.x < sketch->width; pos.x++) {
@@ -318,8 +393,6 @@ STAT_Val determine_enclosed_tiles(PipeSketch * sketch, size_t * num_enclosed) {
     }
   }
 
-  print_sketch(sketch);
-
   for(pos.x = 0; pos.x < sketch->width; pos.x++) {
     for(pos.y = 0; pos.y < sketch->height; pos.y++) {
       is_enclosed = false;
@@ -363,8 +436,6 @@ STAT_Val determine_enclosed_tiles(PipeSketch * sketch, size_t * num_enclosed) {
     }
   }
 
-  print_sketch(sketch);
-
   *num_enclosed = 0;
 
   for(pos.y = 0; pos.y < sketch->height; pos.y++) {
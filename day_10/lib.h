@@ -5,6 +5,8 @@
 #include <cfac/log.h>
 #include <cfac/stat.h>
 
+#include "input.h"
+
 typedef enum PieceType {
   GROUND = 0,         // '.'
   VERTICAL,           // '|',
@@ -97,7 +99,10 @@ static inline const Piece * get_piece_const(const PipeSketch * sketch, Position
   return DAR_get(&sketch->pieces, pos_to_idx(sketch, pos));
 }
 
-STAT_Val parse_sketch(const DAR_DArray * lines, PipeSketch * sketch);
+STAT_Val parse_sketch(const DAR_DArray * lines /* contains SPN_Span */, PipeSketch * sketch);
+
+// same as parse_sketch, but reuses the parsed sketch from an earlier run when PARSE_CACHE_DIR is set
+STAT_Val parse_sketch_cached(const InputFile * input, PipeSketch * sketch);
 
 STAT_Val calculate_distances_from_start(PipeSketch * sketch);
 
@@ -107,4 +112,10 @@ STAT_Val determine_enclosed_tiles(PipeSketch * sketch, size_t * num_enclosed);
 
 STAT_Val destroy_sketch(PipeSketch * sketch);
 
+// the pipe loop only, once the distances are calculated
+void print_pipe(const PipeSketch * sketch);
+
+// the pipe loop with every ground tile marked O(utside) or I(nside), once the enclosed tiles are determined
+void print_sketch(const PipeSketch * sketch);
+
 #endif
\ No newline at end of file
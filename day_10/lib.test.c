@@ -1,7 +1,9 @@
+#include "cache.h"
 #include "lib.h"
 #include "common.h"
 
 #include <stdlib.h>
+#include <unistd.h>
 
 #include <cfac/test_utils.h>
 
@@ -9,11 +11,10 @@ static Result setup(void ** env_pp);
 static Result teardown(void ** env_pp);
 
 static STAT_Val create_lines(const char ** lines_raw, size_t n, DAR_DArray * lines_darr) {
-  TRY(DAR_create(lines_darr, sizeof(DAR_DArray)));
+  TRY(DAR_create(lines_darr, sizeof(SPN_Span)));
 
   for(size_t i = 0; i < n; i++) {
-    DAR_DArray line = {0};
-    TRY(DAR_create_from_cstr(&line, lines_raw[i]));
+    const SPN_Span line = SPN_from_cstr(lines_raw[i]);
     TRY(DAR_push_back(lines_darr, &line));
   }
 
@@ -23,8 +24,6 @@ static STAT_Val create_lines(const char ** lines_raw, size_t n, DAR_DArray * lin
 static STAT_Val destroy_lines(DAR_DArray * lines) {
   CHECK(lines != NULL);
 
-  for(DAR_DArray * p = DAR_first(lines); p != DAR_end(lines); p++) { TRY(DAR_destroy(p)); }
-
   TRY(DAR_destroy(lines));
 
   return OK;
@@ -73,6 +72,68 @@ static Result tst_parse_sketch_example_1(void) {
   return r;
 }
 
+static Result tst_parse_sketch_cached(void) {
+  Result r = PASS;
+  const char raw_input[] = "-L|F7\n"
+                           "7S-7|\n"
+                           "L|7||\n"
+                           "-L-J|\n"
+                           "L|-JF\n";
+
+  char dir[]            = "/tmp/day_10_cache_XXXXXX";
+  char input_filename[] = "/tmp/day_10_cache_XXXXXX/input.txt";
+  EXPECT_NE(&r, NULL, mkdtemp(dir));
+  if(HAS_FAILED(&r)) return r;
+  memcpy(input_filename, dir, strlen(dir));
+
+  FILE * file = fopen(input_filename, "w");
+  EXPECT_NE(&r, NULL, file);
+  if(HAS_FAILED(&r)) return r;
+  fputs(raw_input, file);
+  fclose(file);
+
+  InputFile input = {0};
+  EXPECT_OK(&r, map_input_file(input_filename, &input));
+
+  EXPECT_EQ(&r, 0, setenv("PARSE_CACHE_DIR", dir, 1));
+
+  // first run parses and writes the entry, second run reads it back
+  PipeSketch parsed = {0};
+  PipeSketch cached = {0};
+  EXPECT_OK(&r, parse_sketch_cached(&input, &parsed));
+  EXPECT_OK(&r, parse_sketch_cached(&input, &cached));
+
+  EXPECT_EQ(&r, parsed.width, cached.width);
+  EXPECT_EQ(&r, parsed.height, cached.height);
+  EXPECT_TRUE(&r, is_positions_equal(parsed.start_pos, cached.start_pos));
+  EXPECT_EQ(&r, parsed.pieces.size, cached.pieces.size);
+  EXPECT_ARREQ(&r, Piece, parsed.pieces.data, cached.pieces.data, parsed.pieces.size);
+
+  size_t   max_dist = 0;
+  Position max_pos  = {0};
+  EXPECT_OK(&r, calculate_distances_from_start(&cached));
+  EXPECT_OK(&r, get_max_distance_from_start(&cached, &max_dist, &max_pos));
+  EXPECT_EQ(&r, 4, max_dist);
+
+  EXPECT_EQ(&r, 0, unsetenv("PARSE_CACHE_DIR"));
+
+  char cache_filename[sizeof(dir) + 32] = {0};
+  snprintf(cache_filename,
+           sizeof(cache_filename),
+           "%s/day_10-%016llx.bin",
+           dir,
+           (unsigned long long)hash_input(input.data, input.size));
+  EXPECT_EQ(&r, 0, unlink(cache_filename));
+  EXPECT_EQ(&r, 0, unlink(input_filename));
+  EXPECT_EQ(&r, 0, rmdir(dir));
+
+  EXPECT_OK(&r, destroy_sketch(&parsed));
+  EXPECT_OK(&r, destroy_sketch(&cached));
+  EXPECT_OK(&r, destroy_input_file(&input));
+
+  return r;
+}
+
 static Result tst_calculate_distances_from_start_example_1(void) {
   Result r = PASS;
 
@@ -292,6 +353,7 @@ static Result tst_fixture(void * env) {
 int main(void) {
   Test tests[] = {
       tst_parse_sketch_example_1,
+      tst_parse_sketch_cached,
       tst_calculate_distances_from_start_example_1,
       tst_get_max_distance_from_start_example_1,
       tst_get_max_distance_from_start_example_2,
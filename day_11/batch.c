@@ -0,0 +1,74 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cfac/darray.h>
+#include <cfac/log.h>
+#include <cfac/stat.h>
+
+#include "common.h"
+#include "driver.h"
+#include "input.h"
+#include "lib.h"
+
+static STAT_Val solve_input(const InputFile * input, char * result, size_t result_size) {
+  Universe   universe               = {0};
+  DAR_DArray galaxy_positions       = {0};
+  DAR_DArray distances              = {0};
+  size_t     sum_of_distances_part1 = 0;
+  size_t     sum_of_distances_part2 = 0;
+
+  TRY(DAR_create(&galaxy_positions, sizeof(Position)));
+  TRY(DAR_create(&distances, sizeof(size_t)));
+
+  TRY(parse_universe_cached(input, &universe));
+
+  TRY(calculate_galaxy_distances(&universe, &galaxy_positions, &distances));
+  TRY(sum_galaxy_distances(&universe, &distances, galaxy_positions.size, &sum_of_distances_part1));
+
+  TRY(DAR_clear(&galaxy_positions));
+  TRY(DAR_clear(&distances));
+
+  TRY(increase_space_density_for_gaps(&universe, 1000000));
+
+  TRY(calculate_galaxy_distances(&universe, &galaxy_positions, &distances));
+  TRY(sum_galaxy_distances(&universe, &distances, galaxy_positions.size, &sum_of_distances_part2));
+
+  TRY(DAR_destroy(&galaxy_positions));
+  TRY(DAR_destroy(&distances));
+  TRY(destroy_universe(&universe));
+
+  snprintf(result,
+           result_size,
+           "sum_of_distances_part1: %zu, sum_of_distances_part2: %zu",
+           sum_of_distances_part1,
+           sum_of_distances_part2);
+
+  return OK;
+}
+
+static STAT_Val solve_file(const char * filename, char * result, size_t result_size) {
+  InputFile input = {0};
+  TRY(map_input_file(filename, &input));
+
+  // the mapping is released whether or not the input could be solved
+  const STAT_Val solve_st = solve_input(&input, result, result_size);
+  TRY(destroy_input_file(&input));
+  TRY(solve_st);
+
+  return OK;
+}
+
+int main(int argc, char ** argv) {
+  BatchConfig config = {0};
+  TRY(parse_batch_args(argc, argv, &config));
+
+  size_t num_failed = 0;
+  TRY(run_batch(&config, solve_file, &num_failed));
+
+  const size_t num_files = config.input_filenames.size;
+  TRY(destroy_batch_config(&config));
+
+  if(num_failed > 0) return LOG_STAT(STAT_ERR_INTERNAL, "failed to solve %zu of %zu files", num_failed, num_files);
+
+  return OK;
+}
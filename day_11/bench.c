@@ -0,0 +1,77 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cfac/darray.h>
+#include <cfac/log.h>
+#include <cfac/stat.h>
+
+#include "benchmark.h"
+#include "common.h"
+#include "input.h"
+#include "lib.h"
+
+typedef struct Context {
+  InputFile  input;
+  Universe   universe;
+  DAR_DArray galaxy_positions; // contains Position
+  DAR_DArray distances;        // contains size_t
+  size_t     sum_of_distances_part1;
+  size_t     sum_of_distances_part2;
+} Context;
+
+static STAT_Val parse(void * p) {
+  Context * ctx = p;
+  TRY(parse_universe(&ctx->input.lines, &ctx->universe));
+  return OK;
+}
+
+static STAT_Val unparse(void * p) {
+  Context * ctx = p;
+  TRY(destroy_universe(&ctx->universe));
+  TRY(DAR_clear(&ctx->galaxy_positions));
+  TRY(DAR_clear(&ctx->distances));
+  return OK;
+}
+
+static STAT_Val solve(void * p) {
+  Context * ctx = p;
+
+  TRY(calculate_galaxy_distances(&ctx->universe, &ctx->galaxy_positions, &ctx->distances));
+  TRY(sum_galaxy_distances(
+      &ctx->universe, &ctx->distances, ctx->galaxy_positions.size, &ctx->sum_of_distances_part1));
+
+  TRY(DAR_clear(&ctx->galaxy_positions));
+  TRY(DAR_clear(&ctx->distances));
+
+  TRY(increase_space_density_for_gaps(&ctx->universe, 1000000));
+
+  TRY(calculate_galaxy_distances(&ctx->universe, &ctx->galaxy_positions, &ctx->distances));
+  TRY(sum_galaxy_distances(
+      &ctx->universe, &ctx->distances, ctx->galaxy_positions.size, &ctx->sum_of_distances_part2));
+
+  return OK;
+}
+
+int main(int argc, char ** argv) {
+  BenchConfig config = {0};
+  TRY(parse_bench_args(argc, argv, &config));
+
+  Context ctx = {0};
+  TRY(map_input_file(config.input_filename, &ctx.input));
+  TRY(DAR_create(&ctx.galaxy_positions, sizeof(Position)));
+  TRY(DAR_create(&ctx.distances, sizeof(size_t)));
+
+  // solving changes the density of the gaps, so each run gets a freshly parsed universe
+  const BenchPhase phases[] = {
+      {.name = "parse", .run = parse, .teardown = unparse},
+      {.name = "solve", .setup = parse, .run = solve, .teardown = unparse},
+  };
+
+  TRY(run_bench(&config, "day_11", phases, sizeof(phases) / sizeof(phases[0]), &ctx));
+
+  TRY(DAR_destroy(&ctx.galaxy_positions));
+  TRY(DAR_destroy(&ctx.distances));
+  TRY(destroy_input_file(&ctx.input));
+
+  return OK;
+}
@@ -0,0 +1,47 @@
+#ifndef cache_h
+#define cache_h
+
+#include <cfac/darray.h>
+#include <cfac/stat.h>
+
+#include "input.h"
+
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// opt-in binary cache of parsed inputs, enabled by setting the PARSE_CACHE_DIR environment variable
+// entries are named after the solver and a hash of the input content, so an edited input never hits a stale entry
+
+#define CACHE_FORMAT_VERSION 1
+
+typedef struct CacheReader {
+  const char * data; // read-only mapping of the whole cache file
+  size_t       size;
+  size_t       pos; // next byte to read
+} CacheReader;
+
+typedef struct CacheWriter {
+  FILE * file;
+  char   filename[PATH_MAX];
+  char   tmp_filename[PATH_MAX]; // written first, then renamed, so readers never see a partial entry
+} CacheWriter;
+
+uint64_t hash_input(const char * data, size_t size);
+
+// returns STAT_OK_NOT_FOUND if caching is off or there is no valid entry for this input
+STAT_Val open_cache_reader(const char * name, const InputFile * input, CacheReader * reader);
+STAT_Val read_from_cache(CacheReader * reader, void * dst, size_t size);
+STAT_Val view_from_cache(CacheReader * reader, size_t size, const void ** view); // valid until the reader is closed
+STAT_Val read_darray_from_cache(CacheReader * reader, DAR_DArray * array); // array must be created and empty
+STAT_Val check_cache_fully_read(const CacheReader * reader); // fails if the entry has trailing data
+STAT_Val close_cache_reader(CacheReader * reader);
+
+// returns STAT_OK_NOT_FOUND if caching is off, or if the cache directory cannot be written to
+STAT_Val open_cache_writer(const char * name, const InputFile * input, CacheWriter * writer);
+STAT_Val write_to_cache(CacheWriter * writer, const void * src, size_t size);
+STAT_Val write_darray_to_cache(CacheWriter * writer, const DAR_DArray * array);
+STAT_Val commit_cache_writer(CacheWriter * writer); // drops the entry itself if it fails
+STAT_Val abort_cache_writer(CacheWriter * writer);  // drops a partly written entry
+
+#endif
@@ -0,0 +1,29 @@
+#ifndef driver_h
+#define driver_h
+
+#include <cfac/darray.h>
+#include <cfac/stat.h>
+
+#include <stddef.h>
+
+#define BATCH_RESULT_SIZE 256
+
+// solves the puzzle in one input file, writing its answers as a single line of text (without newline) into result
+typedef STAT_Val (*BatchSolveFn)(const char * input_filename, char * result, size_t result_size);
+
+typedef struct BatchConfig {
+  size_t     num_threads;
+  DAR_DArray input_filenames; // contains char *, owned by the config
+} BatchConfig;
+
+// usage: batch [-j num_threads] input_file_or_dir...
+// directories contribute every regular file directly inside them, in name order
+STAT_Val parse_batch_args(int argc, char ** argv, BatchConfig * config);
+
+STAT_Val destroy_batch_config(BatchConfig * config);
+
+// solves all input files on a pool of worker threads, then prints "<file>: <result>" for each of them in order,
+// a file that fails to solve gets an error line and is counted in num_failed, the others are unaffected
+STAT_Val run_batch(const BatchConfig * config, BatchSolveFn solve, size_t * num_failed);
+
+#endif
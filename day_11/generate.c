@@ -0,0 +1,52 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cfac/darray.h>
+#include <cfac/log.h>
+#include <cfac/stat.h>
+
+#include "common.h"
+#include "generator.h"
+
+#include <stdbool.h>
+
+// writes a width x height image with roughly one galaxy in every fifty cells. About one in ten rows and one in ten
+// columns are kept empty, so there is space to expand.
+
+int main(int argc, char ** argv) {
+  GeneratorConfig config = {.seed = 1, .sizes = {140, 140}};
+  TRY(parse_generator_args(argc, argv, "[width [height]]", 2, &config));
+
+  const size_t width  = config.sizes[0];
+  const size_t height = config.sizes[1];
+
+  Rng rng = {0};
+  seed_rng(&rng, config.seed);
+
+  DAR_DArray is_empty_column = {0}; // contains bool
+  TRY(DAR_create(&is_empty_column, sizeof(bool)));
+  for(size_t x = 0; x < width; x++) {
+    const bool is_empty = (get_random_below(&rng, 10) == 0);
+    TRY(DAR_push_back(&is_empty_column, &is_empty));
+  }
+
+  FILE * file = NULL;
+  TRY(open_generator_output(&config, &file));
+
+  for(size_t y = 0; y < height; y++) {
+    const bool is_empty_row = (get_random_below(&rng, 10) == 0);
+
+    for(size_t x = 0; x < width; x++) {
+      const bool is_empty  = is_empty_row || *(const bool *)DAR_get(&is_empty_column, x);
+      const bool is_galaxy = !is_empty && (get_random_below(&rng, 50) == 0);
+      fputc(is_galaxy ? '#' : '.', file);
+    }
+    fputc('\n', file);
+  }
+
+  TRY(close_generator_output(file));
+
+  TRY(DAR_destroy(&is_empty_column));
+
+  return OK;
+}
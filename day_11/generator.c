@@ -0,0 +1,88 @@
+#include <cfac/log.h>
+
+#include "common.h"
+#include "generator.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+void seed_rng(Rng * rng, uint64_t seed) { rng->state = seed; }
+
+uint64_t get_random(Rng * rng) {
+  // splitmix64, small and good enough to make up puzzle inputs, and the same on every platform for a given seed
+  uint64_t z = (rng->state += 0x9e3779b97f4a7c15ull);
+  z          = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+  z          = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+  return z ^ (z >> 31);
+}
+
+size_t get_random_below(Rng * rng, size_t bound) { return (size_t)(get_random(rng) % bound); }
+
+static STAT_Val parse_number(const char * str, uint64_t * number) {
+  CHECK(str != NULL);
+  CHECK(number != NULL);
+
+  char * end = NULL;
+  errno      = 0;
+
+  const unsigned long long value = strtoull(str, &end, 10);
+  if(errno != 0 || end == str || *end != '\0') return LOG_STAT(STAT_ERR_ARGS, "expected a number, got '%s'", str);
+
+  *number = (uint64_t)value;
+
+  return OK;
+}
+
+STAT_Val parse_generator_args(int argc, char ** argv, const char * size_names, size_t num_sizes, GeneratorConfig * config) {
+  CHECK(argv != NULL);
+  CHECK(size_names != NULL);
+  CHECK(num_sizes <= GENERATOR_MAX_NUM_SIZES);
+  CHECK(config != NULL);
+
+  int opt = 0;
+  while((opt = getopt(argc, argv, "s:o:")) != -1) {
+    switch(opt) {
+    case 's': TRY(parse_number(optarg, &config->seed)); break;
+    case 'o': config->output_filename = optarg; break;
+    default: return LOG_STAT(STAT_ERR_ARGS, "usage: %s [-s seed] [-o output] %s", argv[0], size_names);
+    }
+  }
+
+  if((size_t)(argc - optind) > num_sizes) {
+    return LOG_STAT(STAT_ERR_ARGS, "usage: %s [-s seed] [-o output] %s", argv[0], size_names);
+  }
+
+  for(size_t i = 0; optind < argc; i++, optind++) {
+    uint64_t size = 0;
+    TRY(parse_number(argv[optind], &size));
+    if(size == 0) return LOG_STAT(STAT_ERR_ARGS, "sizes must be non-zero");
+    config->sizes[i] = (size_t)size;
+  }
+
+  return OK;
+}
+
+STAT_Val open_generator_output(const GeneratorConfig * config, FILE ** file) {
+  CHECK(config != NULL);
+  CHECK(file != NULL);
+
+  if(config->output_filename == NULL) {
+    *file = stdout;
+    return OK;
+  }
+
+  *file = fopen(config->output_filename, "w");
+  if(*file == NULL) return LOG_STAT(STAT_ERR_ARGS, "failed to open '%s' for writing", config->output_filename);
+
+  return OK;
+}
+
+STAT_Val close_generator_output(FILE * file) {
+  CHECK(file != NULL);
+
+  CHECK(fflush(file) == 0);
+  if(file != stdout) CHECK(fclose(file) == 0);
+
+  return OK;
+}
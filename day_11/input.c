@@ -0,0 +1,109 @@
+#include <cfac/log.h>
+
+#include "common.h"
+#include "input.h"
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static size_t count_lines(const char * data, size_t size) {
+  size_t num_lines = 0;
+
+  const char * p   = data;
+  const char * end = data + size;
+  while(p < end) {
+    const char * newline = memchr(p, '\n', (size_t)(end - p));
+    num_lines++;
+    if(newline == NULL) break;
+    p = newline + 1;
+  }
+
+  return num_lines;
+}
+
+static STAT_Val split_lines(const char * data, size_t size, DAR_DArray * lines) {
+  CHECK(lines != NULL);
+  CHECK(DAR_is_initialized(lines));
+  CHECK(lines->element_size == sizeof(SPN_Span));
+
+  const char * p   = data;
+  const char * end = data + size;
+  while(p < end) {
+    const char * newline  = memchr(p, '\n', (size_t)(end - p));
+    const char * line_end = (newline == NULL) ? end : (newline + 1); // keep the newline, like getline does
+
+    const SPN_Span line = {.begin = p, .element_size = sizeof(char), .len = (size_t)(line_end - p)};
+    TRY(DAR_push_back(lines, &line));
+
+    p = line_end;
+  }
+
+  return OK;
+}
+
+static STAT_Val create_lines(InputFile * input) {
+  TRY(DAR_create(&input->lines, sizeof(SPN_Span)));
+
+  if(input->data != NULL) {
+    TRY(DAR_reserve(&input->lines, count_lines(input->data, input->size)));
+    TRY(split_lines(input->data, input->size, &input->lines));
+  }
+
+  return OK;
+}
+
+STAT_Val map_input_file(const char * filename, InputFile * input) {
+  CHECK(filename != NULL);
+  CHECK(input != NULL);
+
+  *input = (InputFile){0};
+
+  const int fd = open(filename, O_RDONLY);
+  if(fd < 0) return LOG_STAT(STAT_ERR_READ, "failed to open '%s'", filename);
+
+  struct stat file_stat = {0};
+  if(fstat(fd, &file_stat) != 0) {
+    close(fd);
+    return LOG_STAT(STAT_ERR_READ, "failed to stat '%s'", filename);
+  }
+
+  input->size = (size_t)file_stat.st_size;
+
+  if(input->size > 0) { // mmap does not accept a length of zero, an empty file simply has no lines
+    void * data = mmap(NULL, input->size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // the mapping keeps its own reference to the file
+
+    if(data == MAP_FAILED) return LOG_STAT(STAT_ERR_READ, "failed to map '%s'", filename);
+    madvise(data, input->size, MADV_SEQUENTIAL);
+
+    input->data = data;
+  } else {
+    close(fd);
+  }
+
+  const STAT_Val lines_st = create_lines(input);
+  if(!STAT_is_OK(lines_st)) {
+    // nothing is handed to the caller, so the mapping must not outlive this call
+    if(DAR_is_initialized(&input->lines)) DAR_destroy(&input->lines);
+    if(input->data != NULL) munmap((void *)input->data, input->size);
+    *input = (InputFile){0};
+    return LOG_STAT(lines_st, "failed to split '%s' into lines", filename);
+  }
+
+  return OK;
+}
+
+STAT_Val destroy_input_file(InputFile * input) {
+  CHECK(input != NULL);
+
+  TRY(DAR_destroy(&input->lines));
+
+  if(input->data != NULL) CHECK(munmap((void *)input->data, input->size) == 0);
+
+  *input = (InputFile){0};
+
+  return OK;
+}
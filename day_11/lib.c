@@ -1,6 +1,7 @@
 #include <cfac/darray.h>
 #include <cfac/log.h>
 
+#include "cache.h"
 #include "common.h"
 #include "lib.h"
 
@@ -17,20 +18,21 @@ static STAT_Val init_universe(Universe * universe) {
   return OK;
 }
 
-STAT_Val parse_universe(const DAR_DArray * lines, Universe * universe) {
+STAT_Val parse_universe(const DAR_DArray * lines /* contains SPN_Span */, Universe * universe) {
   CHECK(lines != NULL);
   CHECK(DAR_is_initialized(lines));
   CHECK(!DAR_is_empty(lines));
+  CHECK(lines->element_size == sizeof(SPN_Span));
   CHECK(universe != NULL);
 
   TRY(init_universe(universe));
 
   Position pos = {0};
-  for(const DAR_DArray * line = DAR_first(lines); line != DAR_end(lines); line++, pos.y++) {
+  for(const SPN_Span * line = DAR_first(lines); line != DAR_end(lines); line++, pos.y++) {
     pos.x        = 0;
     size_t width = 0;
 
-    for(const char * p = DAR_first(line); p != DAR_end(line); p++, pos.x++) {
+    for(const char * p = SPN_first(*line); p != SPN_end(*line); p++, pos.x++) {
       if(*p == '\n') break;
       Space space = {.type = char_to_space_type(*p)};
       TRY(DAR_push_back(&universe->spaces, &space));
@@ -91,6 +93,78 @@ static STAT_Val get_empty_columns(const Universe * universe, DAR_DArray * empty_
   return OK;
 }
 
+// only the space types are cached, one byte each, the densities are cheap to derive from them again
+static STAT_Val read_universe_from_cache(CacheReader * reader, Universe * universe) {
+  TRY(init_universe(universe));
+  TRY(read_from_cache(reader, &universe->width, sizeof(universe->width)));
+  TRY(read_from_cache(reader, &universe->height, sizeof(universe->height)));
+
+  const size_t    num_spaces = universe->width * universe->height;
+  const uint8_t * types      = NULL;
+  TRY(view_from_cache(reader, num_spaces, (const void **)&types));
+
+  TRY(DAR_reserve(&universe->spaces, num_spaces));
+  for(size_t i = 0; i < num_spaces; i++) {
+    CHECK(types[i] <= GALAXY);
+    const Space space = {.type = (SpaceType)types[i]};
+    TRY(DAR_push_back(&universe->spaces, &space));
+  }
+
+  TRY(set_space_densities(universe));
+
+  TRY(check_cache_fully_read(reader));
+
+  return OK;
+}
+
+static STAT_Val write_universe_to_cache(CacheWriter * writer, const Universe * universe) {
+  TRY(write_to_cache(writer, &universe->width, sizeof(universe->width)));
+  TRY(write_to_cache(writer, &universe->height, sizeof(universe->height)));
+
+  for(const Space * space = DAR_first(&universe->spaces); space != DAR_end(&universe->spaces); space++) {
+    const uint8_t type = (uint8_t)space->type;
+    TRY(write_to_cache(writer, &type, sizeof(type)));
+  }
+
+  return OK;
+}
+
+STAT_Val parse_universe_cached(const InputFile * input, Universe * universe) {
+  CHECK(input != NULL);
+  CHECK(universe != NULL);
+
+  CacheReader    reader    = {0};
+  const STAT_Val reader_st = open_cache_reader("day_11", input, &reader);
+  TRY(reader_st);
+  if(reader_st == OK) {
+    // a bad entry is still an error, but neither the mapping nor what was read of it so far are left behind
+    const STAT_Val read_st = read_universe_from_cache(&reader, universe);
+    TRY(close_cache_reader(&reader));
+    if(!STAT_is_OK(read_st)) TRY(destroy_universe(universe));
+    TRY(read_st);
+    return OK;
+  }
+
+  TRY(parse_universe(&input->lines, universe));
+
+  CacheWriter    writer    = {0};
+  const STAT_Val writer_st = open_cache_writer("day_11", input, &writer);
+  TRY(writer_st);
+  if(writer_st == OK) {
+    // likewise a failed write drops the partly written entry, and the parsed result with it
+    STAT_Val write_st = write_universe_to_cache(&writer, universe);
+    if(STAT_is_OK(write_st)) {
+      write_st = commit_cache_writer(&writer);
+    } else {
+      TRY(abort_cache_writer(&writer));
+    }
+    if(!STAT_is_OK(write_st)) TRY(destroy_universe(universe));
+    TRY(write_st);
+  }
+
+  return OK;
+}
+
 static STAT_Val set_space_densities(Universe * universe) {
   CHECK(universe != NULL);
 
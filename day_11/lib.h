@@ -5,6 +5,7 @@
 #include <cfac/stat.h>
 
 #include "common.h"
+#include "input.h"
 
 typedef enum SpaceType { EMPTY, GALAXY } SpaceType;
 
@@ -58,7 +59,10 @@ static inline const Space * get_space_const(const Universe * universe, Position
   return DAR_get(&universe->spaces, pos_to_idx(universe, pos));
 }
 
-STAT_Val parse_universe(const DAR_DArray * lines, Universe * universe);
+STAT_Val parse_universe(const DAR_DArray * lines /* contains SPN_Span */, Universe * universe);
+
+// same as parse_universe, but reuses the parsed universe from an earlier run when PARSE_CACHE_DIR is set
+STAT_Val parse_universe_cached(const InputFile * input, Universe * universe);
 
 STAT_Val increase_space_density_for_gaps(Universe * universe, size_t new_density_of_gaps);
 
@@ -1,6 +1,8 @@
+#include "cache.h"
 #include "lib.h"
 
 #include <stdlib.h>
+#include <unistd.h>
 
 #include <cfac/test_utils.h>
 
@@ -8,11 +10,10 @@ static Result setup(void ** env_pp);
 static Result teardown(void ** env_pp);
 
 static STAT_Val create_lines(const char ** lines_raw, size_t n, DAR_DArray * lines_darr) {
-  TRY(DAR_create(lines_darr, sizeof(DAR_DArray)));
+  TRY(DAR_create(lines_darr, sizeof(SPN_Span)));
 
   for(size_t i = 0; i < n; i++) {
-    DAR_DArray line = {0};
-    TRY(DAR_create_from_cstr(&line, lines_raw[i]));
+    const SPN_Span line = SPN_from_cstr(lines_raw[i]);
     TRY(DAR_push_back(lines_darr, &line));
   }
 
@@ -22,8 +23,6 @@ static STAT_Val create_lines(const char ** lines_raw, size_t n, DAR_DArray * lin
 static STAT_Val destroy_lines(DAR_DArray * lines) {
   CHECK(lines != NULL);
 
-  for(DAR_DArray * p = DAR_first(lines); p != DAR_end(lines); p++) { TRY(DAR_destroy(p)); }
-
   TRY(DAR_destroy(lines));
 
   return OK;
@@ -80,6 +79,78 @@ static Result tst_parse_universe_example(void) {
   return r;
 }
 
+static Result tst_parse_universe_cached(void) {
+  Result r = PASS;
+  const char raw_input[] = "...#......\n"
+                           ".......#..\n"
+                           "#.........\n"
+                           "..........\n"
+                           "......#...\n"
+                           ".#........\n"
+                           ".........#\n"
+                           "..........\n"
+                           ".......#..\n"
+                           "#...#.....\n";
+
+  char dir[]            = "/tmp/day_11_cache_XXXXXX";
+  char input_filename[] = "/tmp/day_11_cache_XXXXXX/input.txt";
+  EXPECT_NE(&r, NULL, mkdtemp(dir));
+  if(HAS_FAILED(&r)) return r;
+  memcpy(input_filename, dir, strlen(dir));
+
+  FILE * file = fopen(input_filename, "w");
+  EXPECT_NE(&r, NULL, file);
+  if(HAS_FAILED(&r)) return r;
+  fputs(raw_input, file);
+  fclose(file);
+
+  InputFile input = {0};
+  EXPECT_OK(&r, map_input_file(input_filename, &input));
+
+  EXPECT_EQ(&r, 0, setenv("PARSE_CACHE_DIR", dir, 1));
+
+  // first run parses and writes the entry, second run reads it back
+  Universe parsed = {0};
+  Universe cached = {0};
+  EXPECT_OK(&r, parse_universe_cached(&input, &parsed));
+  EXPECT_OK(&r, parse_universe_cached(&input, &cached));
+
+  EXPECT_EQ(&r, parsed.width, cached.width);
+  EXPECT_EQ(&r, parsed.height, cached.height);
+  EXPECT_EQ(&r, parsed.spaces.size, cached.spaces.size);
+  EXPECT_ARREQ(&r, Space, parsed.spaces.data, cached.spaces.data, parsed.spaces.size);
+
+  DAR_DArray galaxy_positions = {0};
+  DAR_DArray distances        = {0};
+  EXPECT_OK(&r, DAR_create(&galaxy_positions, sizeof(Position)));
+  EXPECT_OK(&r, DAR_create(&distances, sizeof(size_t)));
+
+  size_t sum_of_distances = 0;
+  EXPECT_OK(&r, calculate_galaxy_distances(&cached, &galaxy_positions, &distances));
+  EXPECT_OK(&r, sum_galaxy_distances(&cached, &distances, galaxy_positions.size, &sum_of_distances));
+  EXPECT_EQ(&r, 374, sum_of_distances);
+
+  EXPECT_EQ(&r, 0, unsetenv("PARSE_CACHE_DIR"));
+
+  char cache_filename[sizeof(dir) + 32] = {0};
+  snprintf(cache_filename,
+           sizeof(cache_filename),
+           "%s/day_11-%016llx.bin",
+           dir,
+           (unsigned long long)hash_input(input.data, input.size));
+  EXPECT_EQ(&r, 0, unlink(cache_filename));
+  EXPECT_EQ(&r, 0, unlink(input_filename));
+  EXPECT_EQ(&r, 0, rmdir(dir));
+
+  EXPECT_OK(&r, DAR_destroy(&galaxy_positions));
+  EXPECT_OK(&r, DAR_destroy(&distances));
+  EXPECT_OK(&r, destroy_universe(&parsed));
+  EXPECT_OK(&r, destroy_universe(&cached));
+  EXPECT_OK(&r, destroy_input_file(&input));
+
+  return r;
+}
+
 static Result tst_calculate_galaxy_distances_example(void) {
   Result r = PASS;
 
@@ -201,6 +272,7 @@ static Result tst_fixture(void * env) {
 int main(void) {
   Test tests[] = {
       tst_parse_universe_example,
+      tst_parse_universe_cached,
       tst_calculate_galaxy_distances_example,
       tst_calculate_galaxy_distances_example_part2,
   };
@@ -6,46 +6,18 @@
 #include <cfac/stat.h>
 
 #include "common.h"
+#include "input.h"
 #include "lib.h"
-
-static STAT_Val read_lines_from_file(const char * filename, DAR_DArray * lines) {
-  CHECK(lines != NULL);
-  CHECK(DAR_is_initialized(lines));
-
-  FILE * file_ptr = fopen(filename, "r");
-  CHECK(file_ptr != NULL);
-
-  char *  line_raw = NULL;
-  size_t  len      = 0;
-  ssize_t read     = 0;
-
-  while((read = getline(&line_raw, &len, file_ptr)) != -1) {
-    DAR_DArray line = {0};
-    TRY(DAR_create_from_cstr(&line, line_raw));
-    TRY(DAR_push_back(lines, &line));
-  }
-
-  fclose(file_ptr);
-  free(line_raw);
-
-  return OK;
-}
-
-static STAT_Val destroy_lines(DAR_DArray * lines) {
-  CHECK(lines != NULL);
-
-  for(DAR_DArray * p = DAR_first(lines); p != DAR_end(lines); p++) { TRY(DAR_destroy(p)); }
-
-  TRY(DAR_destroy(lines));
-
-  return OK;
-}
+#include "metrics.h"
 
 int main(void) {
-  DAR_DArray lines = {0};
-  TRY(DAR_create(&lines, sizeof(DAR_DArray)));
+  Metrics metrics = {0};
+  start_metrics(&metrics, "day_11");
 
-  TRY(read_lines_from_file("input.txt", &lines));
+  begin_phase(&metrics, PHASE_READ);
+  InputFile input = {0};
+  TRY(map_input_file("input.txt", &input));
+  end_phase(&metrics);
 
   Universe   universe               = {0};
   DAR_DArray galaxy_positions       = {0};
@@ -56,23 +28,31 @@ int main(void) {
   TRY(DAR_create(&galaxy_positions, sizeof(Position)));
   TRY(DAR_create(&distances, sizeof(size_t)));
 
-  TRY(parse_universe(&lines, &universe));
+  begin_phase(&metrics, PHASE_PARSE);
+  TRY(parse_universe_cached(&input, &universe));
+  end_phase(&metrics);
 
+  begin_phase(&metrics, PHASE_PART1);
   TRY(calculate_galaxy_distances(&universe, &galaxy_positions, &distances));
   TRY(sum_galaxy_distances(&universe, &distances, galaxy_positions.size, &sum_of_distances_part1));
+  end_phase(&metrics);
 
   TRY(DAR_clear(&galaxy_positions));
   TRY(DAR_clear(&distances));
 
+  begin_phase(&metrics, PHASE_PART2);
   TRY(increase_space_density_for_gaps(&universe, 1000000));
 
   TRY(calculate_galaxy_distances(&universe, &galaxy_positions, &distances));
   TRY(sum_galaxy_distances(&universe, &distances, galaxy_positions.size, &sum_of_distances_part2));
+  end_phase(&metrics);
 
   TRY(DAR_destroy(&galaxy_positions));
   TRY(DAR_destroy(&distances));
   TRY(destroy_universe(&universe));
-  TRY(destroy_lines(&lines));
+  TRY(destroy_input_file(&input));
+
+  TRY(write_metrics(&metrics));
 
   return LOG_STAT(STAT_OK,
                   "sum_of_distances_part1: %zu, sum_of_distances_part2: %zu",
@@ -0,0 +1,69 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cfac/darray.h>
+#include <cfac/log.h>
+#include <cfac/stat.h>
+
+#include "common.h"
+#include "driver.h"
+#include "input.h"
+#include "lib.h"
+
+static STAT_Val solve_input(const InputFile * input, char * result, size_t result_size) {
+  size_t num_possibilities_part1 = 0;
+  size_t num_possibilities_part2 = 0;
+
+  DAR_DArray records = {0};
+  TRY(DAR_create(&records, sizeof(Record)));
+  TRY(parse_records_cached(input, &records));
+
+  for(Record * record = DAR_first(&records); record != DAR_end(&records); record++) {
+    size_t num_possibilities = 0;
+    TRY(get_num_possibilities_for_record(record, &num_possibilities));
+    num_possibilities_part1 += num_possibilities;
+
+    TRY(expand_record_for_part2(record));
+
+    TRY(get_num_possibilities_for_record(record, &num_possibilities));
+    num_possibilities_part2 += num_possibilities;
+  }
+
+  TRY(destroy_records(&records));
+  TRY(DAR_destroy(&records));
+
+  snprintf(result,
+           result_size,
+           "num_possibilities_part1: %zu, num_possibilities_part2: %zu",
+           num_possibilities_part1,
+           num_possibilities_part2);
+
+  return OK;
+}
+
+static STAT_Val solve_file(const char * filename, char * result, size_t result_size) {
+  InputFile input = {0};
+  TRY(map_input_file(filename, &input));
+
+  // the mapping is released whether or not the input could be solved
+  const STAT_Val solve_st = solve_input(&input, result, result_size);
+  TRY(destroy_input_file(&input));
+  TRY(solve_st);
+
+  return OK;
+}
+
+int main(int argc, char ** argv) {
+  BatchConfig config = {0};
+  TRY(parse_batch_args(argc, argv, &config));
+
+  size_t num_failed = 0;
+  TRY(run_batch(&config, solve_file, &num_failed));
+
+  const size_t num_files = config.input_filenames.size;
+  TRY(destroy_batch_config(&config));
+
+  if(num_failed > 0) return LOG_STAT(STAT_ERR_INTERNAL, "failed to solve %zu of %zu files", num_failed, num_files);
+
+  return OK;
+}
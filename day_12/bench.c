@@ -0,0 +1,61 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cfac/darray.h>
+#include <cfac/log.h>
+#include <cfac/stat.h>
+
+#include "benchmark.h"
+#include "common.h"
+#include "input.h"
+#include "lib.h"
+
+typedef struct Context {
+  InputFile  input;
+  DAR_DArray records; // contains Record
+  size_t     num_possibilities_part1;
+  size_t     num_possibilities_part2;
+} Context;
+
+static STAT_Val parse(void * p) {
+  Context * ctx = p;
+  TRY(parse_records(&ctx->input.lines, &ctx->records));
+  return OK;
+}
+
+static STAT_Val unparse(void * p) {
+  Context * ctx = p;
+  TRY(destroy_records(&ctx->records));
+  TRY(DAR_clear(&ctx->records));
+  return OK;
+}
+
+static STAT_Val solve(void * p) {
+  Context * ctx = p;
+  TRY(get_num_possibilities_for_all_records(&ctx->records, &ctx->num_possibilities_part1));
+  TRY(expand_records_for_part2(&ctx->records));
+  TRY(get_num_possibilities_for_all_records(&ctx->records, &ctx->num_possibilities_part2));
+  return OK;
+}
+
+int main(int argc, char ** argv) {
+  BenchConfig config = {0};
+  TRY(parse_bench_args(argc, argv, &config));
+
+  Context ctx = {0};
+  TRY(map_input_file(config.input_filename, &ctx.input));
+  TRY(DAR_create(&ctx.records, sizeof(Record)));
+
+  // solving expands the records for part 2, so each run gets freshly parsed ones
+  const BenchPhase phases[] = {
+      {.name = "parse", .run = parse, .teardown = unparse},
+      {.name = "solve", .setup = parse, .run = solve, .teardown = unparse},
+  };
+
+  TRY(run_bench(&config, "day_12", phases, sizeof(phases) / sizeof(phases[0]), &ctx));
+
+  TRY(DAR_destroy(&ctx.records));
+  TRY(destroy_input_file(&ctx.input));
+
+  return OK;
+}
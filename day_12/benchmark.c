@@ -0,0 +1,175 @@
+#include <cfac/darray.h>
+#include <cfac/log.h>
+
+#include "benchmark.h"
+#include "common.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#define DEFAULT_NUM_WARMUPS    3
+#define DEFAULT_NUM_ITERATIONS 100
+
+uint64_t get_monotonic_time_ns(void) {
+  struct timespec ts = {0};
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ((uint64_t)ts.tv_sec * 1000000000ull) + (uint64_t)ts.tv_nsec;
+}
+
+static STAT_Val parse_count(const char * str, size_t * count) {
+  CHECK(str != NULL);
+  CHECK(count != NULL);
+
+  char * end = NULL;
+  errno      = 0;
+
+  const unsigned long long value = strtoull(str, &end, 10);
+  if(errno != 0 || end == str || *end != '\0') {
+    return LOG_STAT(STAT_ERR_ARGS, "expected a count, got '%s'", str);
+  }
+
+  *count = (size_t)value;
+
+  return OK;
+}
+
+STAT_Val parse_bench_args(int argc, char ** argv, BenchConfig * config) {
+  CHECK(argv != NULL);
+  CHECK(config != NULL);
+
+  *config = (BenchConfig){
+      .input_filename  = "input.txt",
+      .output_filename = NULL,
+      .num_warmups     = DEFAULT_NUM_WARMUPS,
+      .num_iterations  = DEFAULT_NUM_ITERATIONS,
+  };
+
+  int opt = 0;
+  while((opt = getopt(argc, argv, "w:n:o:")) != -1) {
+    switch(opt) {
+    case 'w': TRY(parse_count(optarg, &config->num_warmups)); break;
+    case 'n': TRY(parse_count(optarg, &config->num_iterations)); break;
+    case 'o': config->output_filename = optarg; break;
+    default:
+      return LOG_STAT(STAT_ERR_ARGS, "usage: %s [-w num_warmups] [-n num_iterations] [-o output.json] [input]", argv[0]);
+    }
+  }
+
+  if(optind < argc) config->input_filename = argv[optind];
+
+  if(config->num_iterations == 0) return LOG_STAT(STAT_ERR_ARGS, "need at least one iteration");
+
+  return OK;
+}
+
+static int compare_samples(const void * a, const void * b) {
+  const uint64_t lhs = *(const uint64_t *)a;
+  const uint64_t rhs = *(const uint64_t *)b;
+  return (lhs > rhs) - (lhs < rhs);
+}
+
+STAT_Val get_bench_stats(uint64_t * samples_ns, size_t num_samples, BenchStats * stats) {
+  CHECK(samples_ns != NULL);
+  CHECK(num_samples > 0);
+  CHECK(stats != NULL);
+
+  qsort(samples_ns, num_samples, sizeof(uint64_t), compare_samples);
+
+  // nearest-rank percentiles, so every reported value is an actual sample
+  const size_t p99_rank = ((num_samples * 99) + 99) / 100;
+
+  stats->min_ns    = samples_ns[0];
+  stats->median_ns = samples_ns[(num_samples - 1) / 2];
+  stats->p99_ns    = samples_ns[p99_rank - 1];
+
+  return OK;
+}
+
+static STAT_Val run_phase_once(const BenchPhase * phase, void * context, uint64_t * duration_ns) {
+  if(phase->setup != NULL) TRY(phase->setup(context));
+
+  const uint64_t start_ns = get_monotonic_time_ns();
+  TRY(phase->run(context));
+  const uint64_t end_ns = get_monotonic_time_ns();
+
+  if(phase->teardown != NULL) TRY(phase->teardown(context));
+
+  *duration_ns = end_ns - start_ns;
+
+  return OK;
+}
+
+static void write_json_string(FILE * file, const char * str) {
+  fputc('"', file);
+  for(const char * c = str; *c != '\0'; c++) {
+    if(*c == '"' || *c == '\\') fputc('\\', file);
+    fputc(*c, file);
+  }
+  fputc('"', file);
+}
+
+STAT_Val run_bench(const BenchConfig * config,
+                   const char *        name,
+                   const BenchPhase *  phases,
+                   size_t              num_phases,
+                   void *              context) {
+  CHECK(config != NULL);
+  CHECK(config->num_iterations > 0);
+  CHECK(name != NULL);
+  CHECK(phases != NULL);
+  CHECK(num_phases > 0);
+
+  DAR_DArray samples = {0};
+  DAR_DArray stats   = {0};
+  TRY(DAR_create(&samples, sizeof(uint64_t)));
+  TRY(DAR_create(&stats, sizeof(BenchStats)));
+  TRY(DAR_resize_zeroed(&samples, config->num_iterations));
+
+  for(const BenchPhase * phase = phases; phase != &phases[num_phases]; phase++) {
+    CHECK(phase->name != NULL);
+    CHECK(phase->run != NULL);
+
+    uint64_t duration_ns = 0;
+    for(size_t i = 0; i < config->num_warmups; i++) { TRY(run_phase_once(phase, context, &duration_ns)); }
+
+    for(uint64_t * sample = DAR_first(&samples); sample != DAR_end(&samples); sample++) {
+      TRY(run_phase_once(phase, context, sample));
+    }
+
+    BenchStats phase_stats = {0};
+    TRY(get_bench_stats(DAR_first(&samples), samples.size, &phase_stats));
+    TRY(DAR_push_back(&stats, &phase_stats));
+  }
+
+  FILE * file = (config->output_filename == NULL) ? stdout : fopen(config->output_filename, "w");
+  if(file == NULL) return LOG_STAT(STAT_ERR_ARGS, "failed to open '%s' for writing", config->output_filename);
+
+  fprintf(file, "{\"name\": ");
+  write_json_string(file, name);
+  fprintf(file, ", \"input\": ");
+  write_json_string(file, config->input_filename);
+  fprintf(file, ", \"warmups\": %zu, \"iterations\": %zu, \"phases\": [", config->num_warmups, config->num_iterations);
+
+  for(size_t i = 0; i < num_phases; i++) {
+    const BenchStats * phase_stats = DAR_get(&stats, i);
+
+    fprintf(file, "%s{\"name\": ", (i == 0) ? "" : ", ");
+    write_json_string(file, phases[i].name);
+    fprintf(file,
+            ", \"min_ns\": %llu, \"median_ns\": %llu, \"p99_ns\": %llu}",
+            (unsigned long long)phase_stats->min_ns,
+            (unsigned long long)phase_stats->median_ns,
+            (unsigned long long)phase_stats->p99_ns);
+  }
+
+  fprintf(file, "]}\n");
+
+  if(file != stdout) CHECK(fclose(file) == 0);
+
+  TRY(DAR_destroy(&stats));
+  TRY(DAR_destroy(&samples));
+
+  return OK;
+}
@@ -0,0 +1,76 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cfac/log.h>
+#include <cfac/stat.h>
+
+#include "common.h"
+#include "generator.h"
+
+#include <stdbool.h>
+
+// writes num_records records of between half and all of max_record_length springs. Each record starts out as a random
+// row of operational and damaged springs, its groups are taken from that row, and then about half of the springs are
+// turned into unknowns. So every record has at least one valid arrangement.
+
+// the conditions are kept as 128 bit masks, and part 2 turns a record of length n into one of length 5n + 4
+#define MAX_RECORD_LENGTH 24
+
+static void write_record(FILE * file, Rng * rng, size_t length) {
+  bool is_damaged[MAX_RECORD_LENGTH] = {0};
+
+  bool has_damage = false;
+  for(size_t i = 0; i < length; i++) {
+    is_damaged[i] = (get_random_below(rng, 2) == 0);
+    has_damage |= is_damaged[i];
+  }
+  if(!has_damage) is_damaged[get_random_below(rng, length)] = true; // a record needs at least one group
+
+  for(size_t i = 0; i < length; i++) {
+    const bool is_unknown = (get_random_below(rng, 2) == 0);
+    fputc(is_unknown ? '?' : (is_damaged[i] ? '#' : '.'), file);
+  }
+
+  fputc(' ', file);
+
+  bool   is_first_group = true;
+  size_t group_size     = 0;
+  for(size_t i = 0; i <= length; i++) {
+    if(i < length && is_damaged[i]) {
+      group_size++;
+    } else if(group_size > 0) {
+      fprintf(file, "%s%zu", is_first_group ? "" : ",", group_size);
+      is_first_group = false;
+      group_size     = 0;
+    }
+  }
+
+  fputc('\n', file);
+}
+
+int main(int argc, char ** argv) {
+  GeneratorConfig config = {.seed = 1, .sizes = {1000, 20}};
+  TRY(parse_generator_args(argc, argv, "[num_records [max_record_length]]", 2, &config));
+
+  const size_t num_records       = config.sizes[0];
+  const size_t max_record_length = config.sizes[1];
+
+  if(max_record_length > MAX_RECORD_LENGTH) {
+    return LOG_STAT(STAT_ERR_ARGS, "records can be at most %d springs long", MAX_RECORD_LENGTH);
+  }
+
+  Rng rng = {0};
+  seed_rng(&rng, config.seed);
+
+  FILE * file = NULL;
+  TRY(open_generator_output(&config, &file));
+
+  const size_t min_record_length = (max_record_length + 1) / 2;
+  for(size_t i = 0; i < num_records; i++) {
+    write_record(file, &rng, get_random_in_range(&rng, min_record_length, max_record_length));
+  }
+
+  TRY(close_generator_output(file));
+
+  return OK;
+}
@@ -0,0 +1,210 @@
+#include <cfac/log.h>
+
+#include "common.h"
+#include "input.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static size_t count_lines(const char * data, size_t size) {
+  size_t num_lines = 0;
+
+  const char * p   = data;
+  const char * end = data + size;
+  while(p < end) {
+    const char * newline = memchr(p, '\n', (size_t)(end - p));
+    num_lines++;
+    if(newline == NULL) break;
+    p = newline + 1;
+  }
+
+  return num_lines;
+}
+
+static STAT_Val split_lines(const char * data, size_t size, DAR_DArray * lines) {
+  CHECK(lines != NULL);
+  CHECK(DAR_is_initialized(lines));
+  CHECK(lines->element_size == sizeof(SPN_Span));
+
+  const char * p   = data;
+  const char * end = data + size;
+  while(p < end) {
+    const char * newline  = memchr(p, '\n', (size_t)(end - p));
+    const char * line_end = (newline == NULL) ? end : (newline + 1); // keep the newline, like getline does
+
+    const SPN_Span line = {.begin = p, .element_size = sizeof(char), .len = (size_t)(line_end - p)};
+    TRY(DAR_push_back(lines, &line));
+
+    p = line_end;
+  }
+
+  return OK;
+}
+
+static STAT_Val create_lines(InputFile * input) {
+  TRY(DAR_create(&input->lines, sizeof(SPN_Span)));
+
+  if(input->data != NULL) {
+    TRY(DAR_reserve(&input->lines, count_lines(input->data, input->size)));
+    TRY(split_lines(input->data, input->size, &input->lines));
+  }
+
+  return OK;
+}
+
+STAT_Val map_input_file(const char * filename, InputFile * input) {
+  CHECK(filename != NULL);
+  CHECK(input != NULL);
+
+  *input = (InputFile){0};
+
+  const int fd = open(filename, O_RDONLY);
+  if(fd < 0) return LOG_STAT(STAT_ERR_READ, "failed to open '%s'", filename);
+
+  struct stat file_stat = {0};
+  if(fstat(fd, &file_stat) != 0) {
+    close(fd);
+    return LOG_STAT(STAT_ERR_READ, "failed to stat '%s'", filename);
+  }
+
+  input->size = (size_t)file_stat.st_size;
+
+  if(input->size > 0) { // mmap does not accept a length of zero, an empty file simply has no lines
+    void * data = mmap(NULL, input->size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // the mapping keeps its own reference to the file
+
+    if(data == MAP_FAILED) return LOG_STAT(STAT_ERR_READ, "failed to map '%s'", filename);
+    madvise(data, input->size, MADV_SEQUENTIAL);
+
+    input->data = data;
+  } else {
+    close(fd);
+  }
+
+  const STAT_Val lines_st = create_lines(input);
+  if(!STAT_is_OK(lines_st)) {
+    // nothing is handed to the caller, so the mapping must not outlive this call
+    if(DAR_is_initialized(&input->lines)) DAR_destroy(&input->lines);
+    if(input->data != NULL) munmap((void *)input->data, input->size);
+    *input = (InputFile){0};
+    return LOG_STAT(lines_st, "failed to split '%s' into lines", filename);
+  }
+
+  return OK;
+}
+
+STAT_Val destroy_input_file(InputFile * input) {
+  CHECK(input != NULL);
+
+  TRY(DAR_destroy(&input->lines));
+
+  if(input->data != NULL) CHECK(munmap((void *)input->data, input->size) == 0);
+
+  *input = (InputFile){0};
+
+  return OK;
+}
+
+STAT_Val open_line_reader(const char * filename, LineReader * reader) {
+  CHECK(filename != NULL);
+  CHECK(reader != NULL);
+
+  reader->begin       = 0;
+  reader->scanned_end = 0;
+  reader->end         = 0;
+  reader->is_eof      = false;
+
+  if(strcmp(filename, "-") == 0) {
+    reader->fd      = STDIN_FILENO;
+    reader->owns_fd = false;
+  } else {
+    reader->fd      = open(filename, O_RDONLY);
+    reader->owns_fd = true;
+    if(reader->fd < 0) return LOG_STAT(STAT_ERR_READ, "failed to open '%s'", filename);
+  }
+
+  return OK;
+}
+
+static STAT_Val fill_buffer(LineReader * reader) {
+  CHECK(reader != NULL);
+
+  // move the partial line that is left to the front, to make room behind it
+  if(reader->begin > 0) {
+    const size_t remaining = reader->end - reader->begin;
+    memmove(reader->buffer, &reader->buffer[reader->begin], remaining);
+    reader->scanned_end -= reader->begin;
+    reader->end          = remaining;
+    reader->begin        = 0;
+  }
+
+  if(reader->end == LINE_READER_BUFFER_SIZE) {
+    return LOG_STAT(STAT_ERR_READ, "line does not fit in reader buffer of %d bytes", LINE_READER_BUFFER_SIZE);
+  }
+
+  ssize_t num_read = 0;
+  do {
+    num_read = read(reader->fd, &reader->buffer[reader->end], LINE_READER_BUFFER_SIZE - reader->end);
+  } while(num_read < 0 && errno == EINTR);
+
+  if(num_read < 0) return LOG_STAT(STAT_ERR_READ, "failed to read input: %s", strerror(errno));
+
+  if(num_read == 0) reader->is_eof = true;
+  reader->end += (size_t)num_read;
+
+  return OK;
+}
+
+STAT_Val read_next_line(LineReader * reader, SPN_Span * line) {
+  CHECK(reader != NULL);
+  CHECK(line != NULL);
+
+  while(true) {
+    const char * newline = memchr(&reader->buffer[reader->scanned_end], '\n', reader->end - reader->scanned_end);
+
+    if(newline != NULL) {
+      const size_t line_end = (size_t)(newline - reader->buffer) + 1;
+
+      *line = (SPN_Span){
+          .begin        = &reader->buffer[reader->begin],
+          .element_size = sizeof(char),
+          .len          = line_end - reader->begin,
+      };
+      reader->begin       = line_end;
+      reader->scanned_end = line_end;
+      return OK;
+    }
+
+    reader->scanned_end = reader->end;
+
+    if(reader->is_eof) {
+      if(reader->begin == reader->end) return STAT_OK_NOT_FOUND;
+
+      // last line without a trailing newline
+      *line = (SPN_Span){
+          .begin        = &reader->buffer[reader->begin],
+          .element_size = sizeof(char),
+          .len          = reader->end - reader->begin,
+      };
+      reader->begin = reader->end;
+      return OK;
+    }
+
+    TRY(fill_buffer(reader));
+  }
+}
+
+STAT_Val close_line_reader(LineReader * reader) {
+  CHECK(reader != NULL);
+
+  if(reader->owns_fd) CHECK(close(reader->fd) == 0);
+
+  reader->fd      = -1;
+  reader->owns_fd = false;
+
+  return OK;
+}
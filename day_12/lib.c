@@ -2,10 +2,11 @@
 #include <cfac/span.h>
 
 #include <stdio.h>
-#include <time.h>
 
+#include "cache.h"
 #include "common.h"
 #include "lib.h"
+#include "scan.h"
 
 void print_binary(__uint128_t n, size_t num_bits_to_print) {
   putc('0', stdout);
@@ -64,8 +65,9 @@ static STAT_Val parse_groups(SPN_Span str, DAR_DArray * groups) {
     const char * p = str.begin;
     if(*p == delim) continue;
 
-    size_t n = 0;
-    CHECK(sscanf(p, "%zu", &n) == 1);
+    size_t n            = 0;
+    size_t num_consumed = 0;
+    CHECK(scan_size(str, &n, &num_consumed) == OK);
     TRY(DAR_push_back(groups, &n));
 
     size_t start_of_next_num = 0;
@@ -87,27 +89,117 @@ static STAT_Val init_record(Record * record) {
   return OK;
 }
 
-STAT_Val parse_records(const DAR_DArray * lines, DAR_DArray * records /*contains Record*/) {
+STAT_Val parse_record(SPN_Span line, Record * record) {
+  CHECK(record != NULL);
+
+  size_t     space_idx = 0;
+  const char space     = ' ';
+  CHECK(SPN_find(line, &space, &space_idx) == STAT_OK);
+
+  TRY(init_record(record));
+
+  TRY(parse_conditions(SPN_subspan(line, 0, space_idx), record));
+  TRY(parse_groups(SPN_subspan(line, space_idx + 1, line.len - (space_idx + 1)), &record->groups));
+
+  return OK;
+}
+
+STAT_Val parse_records(const DAR_DArray * lines /* contains SPN_Span */, DAR_DArray * records /*contains Record*/) {
   CHECK(lines != NULL);
   CHECK(DAR_is_initialized(lines));
-  CHECK(lines->element_size == sizeof(DAR_DArray));
+  CHECK(lines->element_size == sizeof(SPN_Span));
   CHECK(!DAR_is_empty(lines));
   CHECK(records != NULL);
   CHECK(DAR_is_initialized(records));
   CHECK(records->element_size == sizeof(Record));
   CHECK(DAR_is_empty(records));
 
-  for(const DAR_DArray * line = DAR_first(lines); line != DAR_end(lines); line++) {
-    size_t     space_idx = 0;
-    const char space     = ' ';
-    CHECK(SPN_find(DAR_to_span(line), &space, &space_idx) == STAT_OK);
+  for(const SPN_Span * line = DAR_first(lines); line != DAR_end(lines); line++) {
+    Record record = {0};
+    TRY(parse_record(*line, &record));
+    TRY(DAR_push_back(records, &record));
+  }
+
+  return OK;
+}
+
+static STAT_Val read_records_from_cache(CacheReader * reader, DAR_DArray * records) {
+  uint64_t num_records = 0;
+  TRY(read_from_cache(reader, &num_records, sizeof(num_records)));
+  TRY(DAR_reserve(records, num_records));
 
+  for(uint64_t i = 0; i < num_records; i++) {
+    // pushed before it is read into, so a record that fails halfway is destroyed with the rest
     Record record = {0};
     TRY(init_record(&record));
-
-    TRY(parse_conditions(SPN_subspan(DAR_to_span(line), 0, space_idx), &record));
-    TRY(parse_groups(SPN_subspan(DAR_to_span(line), space_idx + 1, line->size - (space_idx + 1)), &record.groups));
     TRY(DAR_push_back(records, &record));
+
+    Record * cached = DAR_last(records);
+    TRY(read_from_cache(reader, &cached->operational_bits, sizeof(cached->operational_bits)));
+    TRY(read_from_cache(reader, &cached->damaged_bits, sizeof(cached->damaged_bits)));
+    TRY(read_from_cache(reader, &cached->unknown_bits, sizeof(cached->unknown_bits)));
+    TRY(read_darray_from_cache(reader, &cached->groups));
+  }
+
+  TRY(check_cache_fully_read(reader));
+
+  return OK;
+}
+
+static STAT_Val write_records_to_cache(CacheWriter * writer, const DAR_DArray * records) {
+  const uint64_t num_records = records->size;
+  TRY(write_to_cache(writer, &num_records, sizeof(num_records)));
+
+  for(const Record * record = DAR_first(records); record != DAR_end(records); record++) {
+    TRY(write_to_cache(writer, &record->operational_bits, sizeof(record->operational_bits)));
+    TRY(write_to_cache(writer, &record->damaged_bits, sizeof(record->damaged_bits)));
+    TRY(write_to_cache(writer, &record->unknown_bits, sizeof(record->unknown_bits)));
+    TRY(write_darray_to_cache(writer, &record->groups));
+  }
+
+  return OK;
+}
+
+STAT_Val parse_records_cached(const InputFile * input, DAR_DArray * records /*contains Record*/) {
+  CHECK(input != NULL);
+  CHECK(records != NULL);
+  CHECK(DAR_is_initialized(records));
+  CHECK(records->element_size == sizeof(Record));
+  CHECK(DAR_is_empty(records));
+
+  CacheReader    reader    = {0};
+  const STAT_Val reader_st = open_cache_reader("day_12", input, &reader);
+  TRY(reader_st);
+  if(reader_st == OK) {
+    // a bad entry is still an error, but neither the mapping nor what was read of it so far are left behind
+    const STAT_Val read_st = read_records_from_cache(&reader, records);
+    TRY(close_cache_reader(&reader));
+    if(!STAT_is_OK(read_st)) {
+      TRY(destroy_records(records));
+      TRY(DAR_clear(records));
+    }
+    TRY(read_st);
+    return OK;
+  }
+
+  TRY(parse_records(&input->lines, records));
+
+  CacheWriter    writer    = {0};
+  const STAT_Val writer_st = open_cache_writer("day_12", input, &writer);
+  TRY(writer_st);
+  if(writer_st == OK) {
+    // likewise a failed write drops the partly written entry, and the parsed result with it
+    STAT_Val write_st = write_records_to_cache(&writer, records);
+    if(STAT_is_OK(write_st)) {
+      write_st = commit_cache_writer(&writer);
+    } else {
+      TRY(abort_cache_writer(&writer));
+    }
+    if(!STAT_is_OK(write_st)) {
+      TRY(destroy_records(records));
+      TRY(DAR_clear(records));
+    }
+    TRY(write_st);
   }
 
   return OK;
@@ -156,21 +248,27 @@ static STAT_Val expand_conditions(__uint128_t * operational_bits,
   return OK;
 }
 
+STAT_Val expand_record_for_part2(Record * record) {
+  CHECK(record != NULL);
+
+  TRY(expand_groups(&record->groups));
+  TRY(expand_conditions(&record->operational_bits, &record->damaged_bits, &record->unknown_bits));
+
+  return OK;
+}
+
 STAT_Val expand_records_for_part2(DAR_DArray * records) {
   CHECK(records != NULL);
   CHECK(DAR_is_initialized(records));
   CHECK(records->element_size == sizeof(Record));
   CHECK(!DAR_is_empty(records));
 
-  for(Record * record = DAR_first(records); record != DAR_end(records); record++) {
-    TRY(expand_groups(&record->groups));
-    TRY(expand_conditions(&record->operational_bits, &record->damaged_bits, &record->unknown_bits));
-  }
+  for(Record * record = DAR_first(records); record != DAR_end(records); record++) { TRY(expand_record_for_part2(record)); }
 
   return OK;
 }
 
-static STAT_Val destroy_record(Record * record) {
+STAT_Val destroy_record(Record * record) {
   CHECK(record != NULL);
 
   TRY(DAR_destroy(&record->groups));
@@ -296,13 +394,6 @@ STAT_Val get_num_possibilities_for_record(const Record * record, size_t * num_po
   CHECK(record != NULL);
   CHECK(num_possibilities != NULL);
 
-  printf("%s @ ", __func__);
-  {
-    time_t result = time(NULL);
-    if(result != (time_t)(-1)) printf("%s", asctime(gmtime(&result)));
-  }
-  print_record(record);
-
   size_t minimum_required_space = *(const size_t *)DAR_first(&record->groups);
   if(record->groups.size > 1) {
     for(const size_t * g = DAR_get(&record->groups, 1); g != DAR_end(&record->groups); g++) {
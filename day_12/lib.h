@@ -2,8 +2,11 @@
 #define lib_h
 
 #include <cfac/darray.h>
+#include <cfac/span.h>
 #include <cfac/stat.h>
 
+#include "input.h"
+
 typedef struct Record {
   __uint128_t operational_bits;
   __uint128_t damaged_bits;
@@ -13,7 +16,11 @@ typedef struct Record {
 
 void print_binary(__uint128_t n, size_t num_bits_to_print);
 
-STAT_Val parse_records(const DAR_DArray * lines, DAR_DArray * records /*contains Record*/);
+STAT_Val parse_record(SPN_Span line, Record * record);
+STAT_Val parse_records(const DAR_DArray * lines /* contains SPN_Span */, DAR_DArray * records /*contains Record*/);
+// same as parse_records, but reuses the parsed records from an earlier run when PARSE_CACHE_DIR is set
+STAT_Val parse_records_cached(const InputFile * input, DAR_DArray * records /*contains Record*/);
+STAT_Val expand_record_for_part2(Record * record);
 STAT_Val expand_records_for_part2(DAR_DArray * records);
 
 size_t get_num_conditions(const Record * record);
@@ -23,6 +30,7 @@ STAT_Val get_num_possibilities_for_all_records(const DAR_DArray * records, size_
 
 STAT_Val print_records(const DAR_DArray * records);
 
+STAT_Val destroy_record(Record * record);
 STAT_Val destroy_records(DAR_DArray * records);
 
 #endif
\ No newline at end of file
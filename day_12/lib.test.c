@@ -1,8 +1,10 @@
+#include "cache.h"
 #include "lib.h"
 
 #include <cfac/test_utils.h>
 
 #include <stdlib.h>
+#include <unistd.h>
 
 #include "common.h"
 
@@ -10,11 +12,10 @@ static Result setup(void ** env_pp);
 static Result teardown(void ** env_pp);
 
 static STAT_Val create_lines(const char ** lines_raw, size_t n, DAR_DArray * lines_darr) {
-  TRY(DAR_create(lines_darr, sizeof(DAR_DArray)));
+  TRY(DAR_create(lines_darr, sizeof(SPN_Span)));
 
   for(size_t i = 0; i < n; i++) {
-    DAR_DArray line = {0};
-    TRY(DAR_create_from_cstr(&line, lines_raw[i]));
+    const SPN_Span line = SPN_from_cstr(lines_raw[i]);
     TRY(DAR_push_back(lines_darr, &line));
   }
 
@@ -24,8 +25,6 @@ static STAT_Val create_lines(const char ** lines_raw, size_t n, DAR_DArray * lin
 static STAT_Val destroy_lines(DAR_DArray * lines) {
   CHECK(lines != NULL);
 
-  for(DAR_DArray * p = DAR_first(lines); p != DAR_end(lines); p++) { TRY(DAR_destroy(p)); }
-
   TRY(DAR_destroy(lines));
 
   return OK;
@@ -69,6 +68,78 @@ static Result tst_parse_records_example(void) {
   return r;
 }
 
+static Result tst_parse_records_cached(void) {
+  Result r = PASS;
+  const char raw_input[] = "???.### 1,1,3\n"
+                           ".??..??...?##. 1,1,3\n"
+                           "?#?#?#?#?#?#?#? 1,3,1,6\n"
+                           "????.#...#... 4,1,1\n"
+                           "????.######..#####. 1,6,5\n"
+                           "?###???????? 3,2,1\n";
+
+  char dir[]            = "/tmp/day_12_cache_XXXXXX";
+  char input_filename[] = "/tmp/day_12_cache_XXXXXX/input.txt";
+  EXPECT_NE(&r, NULL, mkdtemp(dir));
+  if(HAS_FAILED(&r)) return r;
+  memcpy(input_filename, dir, strlen(dir));
+
+  FILE * file = fopen(input_filename, "w");
+  EXPECT_NE(&r, NULL, file);
+  if(HAS_FAILED(&r)) return r;
+  fputs(raw_input, file);
+  fclose(file);
+
+  InputFile input = {0};
+  EXPECT_OK(&r, map_input_file(input_filename, &input));
+
+  EXPECT_EQ(&r, 0, setenv("PARSE_CACHE_DIR", dir, 1));
+
+  // first run parses and writes the entries, second run reads them back
+  DAR_DArray parsed = {0};
+  DAR_DArray cached = {0};
+  EXPECT_OK(&r, DAR_create(&parsed, sizeof(Record)));
+  EXPECT_OK(&r, DAR_create(&cached, sizeof(Record)));
+  EXPECT_OK(&r, parse_records_cached(&input, &parsed));
+  EXPECT_OK(&r, parse_records_cached(&input, &cached));
+
+  EXPECT_EQ(&r, 6, parsed.size);
+  EXPECT_EQ(&r, parsed.size, cached.size);
+
+  for(size_t i = 0; i < parsed.size && i < cached.size; i++) {
+    const Record * parsed_record = DAR_get(&parsed, i);
+    const Record * cached_record = DAR_get(&cached, i);
+    EXPECT_TRUE(&r, parsed_record->operational_bits == cached_record->operational_bits);
+    EXPECT_TRUE(&r, parsed_record->damaged_bits == cached_record->damaged_bits);
+    EXPECT_TRUE(&r, parsed_record->unknown_bits == cached_record->unknown_bits);
+    EXPECT_EQ(&r, parsed_record->groups.size, cached_record->groups.size);
+    EXPECT_ARREQ(&r, size_t, parsed_record->groups.data, cached_record->groups.data, parsed_record->groups.size);
+  }
+
+  size_t num_possibilities = 0;
+  EXPECT_OK(&r, get_num_possibilities_for_all_records(&cached, &num_possibilities));
+  EXPECT_EQ(&r, 21, num_possibilities);
+
+  EXPECT_EQ(&r, 0, unsetenv("PARSE_CACHE_DIR"));
+
+  char cache_filename[sizeof(dir) + 32] = {0};
+  snprintf(cache_filename,
+           sizeof(cache_filename),
+           "%s/day_12-%016llx.bin",
+           dir,
+           (unsigned long long)hash_input(input.data, input.size));
+  EXPECT_EQ(&r, 0, unlink(cache_filename));
+  EXPECT_EQ(&r, 0, unlink(input_filename));
+  EXPECT_EQ(&r, 0, rmdir(dir));
+
+  EXPECT_OK(&r, destroy_records(&parsed));
+  EXPECT_OK(&r, destroy_records(&cached));
+  EXPECT_OK(&r, DAR_destroy(&parsed));
+  EXPECT_OK(&r, DAR_destroy(&cached));
+  EXPECT_OK(&r, destroy_input_file(&input));
+
+  return r;
+}
+
 static Result tst_get_num_possibilities_for_record_example_line1(void) {
   Result r = PASS;
 
@@ -280,6 +351,7 @@ static Result tst_fixture(void * env) {
 int main(void) {
   Test tests[] = {
       tst_parse_records_example,
+      tst_parse_records_cached,
       tst_get_num_possibilities_for_record_example_line1,
       tst_get_num_possibilities_for_record_example_line2,
       tst_get_num_possibilities_for_record_example,
@@ -6,64 +6,59 @@
 #include <cfac/stat.h>
 
 #include "common.h"
+#include "input.h"
 #include "lib.h"
+#include "metrics.h"
 
-static STAT_Val read_lines_from_file(const char * filename, DAR_DArray * lines) {
-  CHECK(lines != NULL);
-  CHECK(DAR_is_initialized(lines));
+int main(int argc, char ** argv) {
+  const char * filename = (argc > 1) ? argv[1] : "input.txt"; // "-" reads from stdin
 
-  FILE * file_ptr = fopen(filename, "r");
-  CHECK(file_ptr != NULL);
+  Metrics metrics = {0};
+  start_metrics(&metrics, "day_12");
 
-  char *  line_raw = NULL;
-  size_t  len      = 0;
-  ssize_t read     = 0;
+  LineReader reader = {0};
+  begin_phase(&metrics, PHASE_READ);
+  TRY(open_line_reader(filename, &reader));
+  end_phase(&metrics);
 
-  while((read = getline(&line_raw, &len, file_ptr)) != -1) {
-    DAR_DArray line = {0};
-    TRY(DAR_create_from_cstr(&line, line_raw));
-    TRY(DAR_push_back(lines, &line));
-  }
-
-  fclose(file_ptr);
-  free(line_raw);
-
-  return OK;
-}
-
-static STAT_Val destroy_lines(DAR_DArray * lines) {
-  CHECK(lines != NULL);
-
-  for(DAR_DArray * p = DAR_first(lines); p != DAR_end(lines); p++) { TRY(DAR_destroy(p)); }
-
-  TRY(DAR_destroy(lines));
+  size_t num_possibilities_part1 = 0;
+  size_t num_possibilities_part2 = 0;
 
-  return OK;
-}
+  // records are independent of each other, so both parts are solved for one record before the next is read
+  SPN_Span line    = {0};
+  STAT_Val read_st = OK;
+  begin_phase(&metrics, PHASE_READ);
+  while((read_st = read_next_line(&reader, &line)) == OK) {
+    end_phase(&metrics);
 
-int main(void) {
-  DAR_DArray lines = {0};
-  TRY(DAR_create(&lines, sizeof(DAR_DArray)));
+    begin_phase(&metrics, PHASE_PARSE);
+    Record record = {0};
+    TRY(parse_record(line, &record));
+    end_phase(&metrics);
 
-  TRY(read_lines_from_file("input.txt", &lines));
+    begin_phase(&metrics, PHASE_PART1);
+    size_t num_possibilities = 0;
+    TRY(get_num_possibilities_for_record(&record, &num_possibilities));
+    num_possibilities_part1 += num_possibilities;
+    end_phase(&metrics);
 
-  DAR_DArray records = {0};
-  TRY(DAR_create(&records, sizeof(Record)));
+    begin_phase(&metrics, PHASE_PART2);
+    TRY(expand_record_for_part2(&record));
 
-  TRY(parse_records(&lines, &records));
+    TRY(get_num_possibilities_for_record(&record, &num_possibilities));
+    num_possibilities_part2 += num_possibilities;
+    end_phase(&metrics);
 
-  size_t num_possibilities_part1 = 0;
-  TRY(get_num_possibilities_for_all_records(&records, &num_possibilities_part1));
+    TRY(destroy_record(&record));
 
-  TRY(expand_records_for_part2(&records));
-
-  size_t num_possibilities_part2 = 0;
+    begin_phase(&metrics, PHASE_READ);
+  }
+  end_phase(&metrics);
+  TRY(read_st);
 
-  TRY(get_num_possibilities_for_all_records(&records, &num_possibilities_part2));
+  TRY(close_line_reader(&reader));
 
-  TRY(destroy_records(&records));
-  TRY(DAR_destroy(&records));
-  TRY(destroy_lines(&lines));
+  TRY(write_metrics(&metrics));
 
   return LOG_STAT(STAT_OK,
                   "num_possibilities_part1: %zu, num_possibilities_part2: %zu",
@@ -0,0 +1,85 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cfac/darray.h>
+#include <cfac/log.h>
+#include <cfac/stat.h>
+
+#include "common.h"
+#include "driver.h"
+#include "input.h"
+#include "lib.h"
+
+static STAT_Val solve_input(const InputFile * input, char * result, size_t result_size) {
+  const SPN_Span lines_span = DAR_to_span(&input->lines);
+
+  size_t end_cursor   = 0;
+  size_t start_cursor = 0;
+
+  size_t count = 0;
+
+  while((start_cursor < lines_span.len) && (end_cursor < lines_span.len)) {
+    for(end_cursor = start_cursor; end_cursor < lines_span.len; end_cursor++) {
+      const SPN_Span * line = SPN_get(lines_span, end_cursor);
+
+      if(line->len == 0) break;
+
+      const char * first_char = SPN_first(*line);
+      if(!((*first_char == '#') || *first_char == '.')) break;
+    }
+
+    const SPN_Span pattern_span       = SPN_subspan(lines_span, start_cursor, (end_cursor - start_cursor));
+    Pattern        pattern            = {0};
+    Pattern        pattern_transposed = {0};
+    TRY(parse_pattern(pattern_span, &pattern));
+    TRY(transpose_pattern(&pattern, &pattern_transposed));
+
+    size_t mirror_position = 0;
+    bool   has_mirror      = false;
+    TRY(find_mirror(&pattern, &has_mirror, &mirror_position));
+
+    if(has_mirror) count += (100 * mirror_position);
+
+    mirror_position = 0;
+    has_mirror      = false;
+    TRY(find_mirror(&pattern_transposed, &has_mirror, &mirror_position));
+
+    if(has_mirror) count += mirror_position;
+
+    TRY(destroy_pattern(&pattern));
+    TRY(destroy_pattern(&pattern_transposed));
+
+    start_cursor = end_cursor + 1;
+  }
+
+  snprintf(result, result_size, "count: %zu", count);
+
+  return OK;
+}
+
+static STAT_Val solve_file(const char * filename, char * result, size_t result_size) {
+  InputFile input = {0};
+  TRY(map_input_file(filename, &input));
+
+  // the mapping is released whether or not the input could be solved
+  const STAT_Val solve_st = solve_input(&input, result, result_size);
+  TRY(destroy_input_file(&input));
+  TRY(solve_st);
+
+  return OK;
+}
+
+int main(int argc, char ** argv) {
+  BatchConfig config = {0};
+  TRY(parse_batch_args(argc, argv, &config));
+
+  size_t num_failed = 0;
+  TRY(run_batch(&config, solve_file, &num_failed));
+
+  const size_t num_files = config.input_filenames.size;
+  TRY(destroy_batch_config(&config));
+
+  if(num_failed > 0) return LOG_STAT(STAT_ERR_INTERNAL, "failed to solve %zu of %zu files", num_failed, num_files);
+
+  return OK;
+}
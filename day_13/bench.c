@@ -0,0 +1,112 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cfac/darray.h>
+#include <cfac/log.h>
+#include <cfac/stat.h>
+
+#include "benchmark.h"
+#include "common.h"
+#include "input.h"
+#include "lib.h"
+
+typedef struct Context {
+  InputFile  input;
+  DAR_DArray patterns;            // contains Pattern
+  DAR_DArray patterns_transposed; // contains Pattern
+  size_t     count;
+} Context;
+
+static STAT_Val parse(void * p) {
+  Context * ctx = p;
+
+  const SPN_Span lines_span = DAR_to_span(&ctx->input.lines);
+
+  size_t end_cursor   = 0;
+  size_t start_cursor = 0;
+
+  while((start_cursor < lines_span.len) && (end_cursor < lines_span.len)) {
+    for(end_cursor = start_cursor; end_cursor < lines_span.len; end_cursor++) {
+      const SPN_Span * line = SPN_get(lines_span, end_cursor);
+
+      if(line->len == 0) break;
+
+      const char * first_char = SPN_first(*line);
+      if(!((*first_char == '#') || *first_char == '.')) break;
+    }
+
+    const SPN_Span pattern_span       = SPN_subspan(lines_span, start_cursor, (end_cursor - start_cursor));
+    Pattern        pattern            = {0};
+    Pattern        pattern_transposed = {0};
+    TRY(parse_pattern(pattern_span, &pattern));
+    TRY(transpose_pattern(&pattern, &pattern_transposed));
+
+    TRY(DAR_push_back(&ctx->patterns, &pattern));
+    TRY(DAR_push_back(&ctx->patterns_transposed, &pattern_transposed));
+
+    start_cursor = end_cursor + 1;
+  }
+
+  return OK;
+}
+
+static STAT_Val unparse(void * p) {
+  Context * ctx = p;
+
+  for(Pattern * pattern = DAR_first(&ctx->patterns); pattern != DAR_end(&ctx->patterns); pattern++) {
+    TRY(destroy_pattern(pattern));
+  }
+  for(Pattern * pattern = DAR_first(&ctx->patterns_transposed); pattern != DAR_end(&ctx->patterns_transposed);
+      pattern++) {
+    TRY(destroy_pattern(pattern));
+  }
+
+  TRY(DAR_clear(&ctx->patterns));
+  TRY(DAR_clear(&ctx->patterns_transposed));
+
+  return OK;
+}
+
+static STAT_Val solve(void * p) {
+  Context * ctx = p;
+
+  ctx->count = 0;
+  for(size_t i = 0; i < ctx->patterns.size; i++) {
+    size_t mirror_position = 0;
+    bool   has_mirror      = false;
+    TRY(find_mirror(DAR_get(&ctx->patterns, i), &has_mirror, &mirror_position));
+
+    if(has_mirror) ctx->count += (100 * mirror_position);
+
+    mirror_position = 0;
+    has_mirror      = false;
+    TRY(find_mirror(DAR_get(&ctx->patterns_transposed, i), &has_mirror, &mirror_position));
+
+    if(has_mirror) ctx->count += mirror_position;
+  }
+
+  return OK;
+}
+
+int main(int argc, char ** argv) {
+  BenchConfig config = {0};
+  TRY(parse_bench_args(argc, argv, &config));
+
+  Context ctx = {0};
+  TRY(map_input_file(config.input_filename, &ctx.input));
+  TRY(DAR_create(&ctx.patterns, sizeof(Pattern)));
+  TRY(DAR_create(&ctx.patterns_transposed, sizeof(Pattern)));
+
+  const BenchPhase phases[] = {
+      {.name = "parse", .run = parse, .teardown = unparse},
+      {.name = "solve", .setup = parse, .run = solve, .teardown = unparse},
+  };
+
+  TRY(run_bench(&config, "day_13", phases, sizeof(phases) / sizeof(phases[0]), &ctx));
+
+  TRY(DAR_destroy(&ctx.patterns));
+  TRY(DAR_destroy(&ctx.patterns_transposed));
+  TRY(destroy_input_file(&ctx.input));
+
+  return OK;
+}
@@ -0,0 +1,240 @@
+#include <cfac/log.h>
+
+#include "common.h"
+#include "driver.h"
+
+#include <dirent.h>
+#include <errno.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+typedef struct BatchResult {
+  STAT_Val status;
+  char     text[BATCH_RESULT_SIZE];
+} BatchResult;
+
+typedef struct BatchQueue {
+  const BatchConfig * config;
+  BatchSolveFn        solve;
+  BatchResult *       results;
+  atomic_size_t       next_idx; // next input file to hand out to a worker
+} BatchQueue;
+
+static STAT_Val parse_count(const char * str, size_t * count) {
+  CHECK(str != NULL);
+  CHECK(count != NULL);
+
+  char * end = NULL;
+  errno      = 0;
+
+  const unsigned long long value = strtoull(str, &end, 10);
+  if(errno != 0 || end == str || *end != '\0') {
+    return LOG_STAT(STAT_ERR_ARGS, "expected a count, got '%s'", str);
+  }
+
+  *count = (size_t)value;
+
+  return OK;
+}
+
+static STAT_Val join_path(const char * dir, const char * name, char ** path) {
+  CHECK(name != NULL);
+  CHECK(path != NULL);
+
+  const size_t len = ((dir != NULL) ? (strlen(dir) + 1) : 0) + strlen(name) + 1;
+
+  *path = malloc(len);
+  if(*path == NULL) return LOG_STAT(STAT_ERR_ALLOC, "failed to allocate path");
+
+  if(dir != NULL) {
+    snprintf(*path, len, "%s/%s", dir, name);
+  } else {
+    snprintf(*path, len, "%s", name);
+  }
+
+  return OK;
+}
+
+static int compare_filenames(const void * a, const void * b) {
+  return strcmp(*(char * const *)a, *(char * const *)b);
+}
+
+static STAT_Val add_input_dir(BatchConfig * config, const char * dirname) {
+  CHECK(config != NULL);
+  CHECK(dirname != NULL);
+
+  DIR * dir = opendir(dirname);
+  if(dir == NULL) return LOG_STAT(STAT_ERR_READ, "failed to open directory '%s'", dirname);
+
+  const size_t first_idx = config->input_filenames.size;
+
+  struct dirent * entry = NULL;
+  while((entry = readdir(dir)) != NULL) {
+    if(entry->d_name[0] == '.') continue; // skips '.', '..' and hidden files
+
+    char * filename = NULL;
+    TRY(join_path(dirname, entry->d_name, &filename));
+
+    // d_type is not filled in by every file system, so stat to find out what the entry is
+    struct stat entry_stat = {0};
+    if(stat(filename, &entry_stat) == 0 && S_ISREG(entry_stat.st_mode)) {
+      TRY(DAR_push_back(&config->input_filenames, &filename));
+    } else {
+      free(filename);
+    }
+  }
+
+  CHECK(closedir(dir) == 0);
+
+  // readdir gives no particular order, sort to keep the output the same from run to run
+  const size_t num_added = config->input_filenames.size - first_idx;
+  if(num_added > 0) qsort(DAR_get(&config->input_filenames, first_idx), num_added, sizeof(char *), compare_filenames);
+
+  return OK;
+}
+
+static STAT_Val add_input_paths(int num_paths, char ** paths, BatchConfig * config) {
+  CHECK(paths != NULL);
+  CHECK(config != NULL);
+
+  for(int i = 0; i < num_paths; i++) {
+    struct stat path_stat = {0};
+    if(stat(paths[i], &path_stat) != 0) return LOG_STAT(STAT_ERR_READ, "failed to stat '%s'", paths[i]);
+
+    if(S_ISDIR(path_stat.st_mode)) {
+      TRY(add_input_dir(config, paths[i]));
+    } else {
+      char * filename = NULL;
+      TRY(join_path(NULL, paths[i], &filename));
+      TRY(DAR_push_back(&config->input_filenames, &filename));
+    }
+  }
+
+  return OK;
+}
+
+STAT_Val parse_batch_args(int argc, char ** argv, BatchConfig * config) {
+  CHECK(argv != NULL);
+  CHECK(config != NULL);
+
+  *config = (BatchConfig){0};
+
+  const long num_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+  config->num_threads = (num_cpus > 0) ? (size_t)num_cpus : 1;
+
+  int opt = 0;
+  while((opt = getopt(argc, argv, "j:")) != -1) {
+    switch(opt) {
+    case 'j': TRY(parse_count(optarg, &config->num_threads)); break;
+    default: return LOG_STAT(STAT_ERR_ARGS, "usage: %s [-j num_threads] input_file_or_dir...", argv[0]);
+    }
+  }
+
+  if(config->num_threads == 0) return LOG_STAT(STAT_ERR_ARGS, "need at least one thread");
+  if(optind >= argc) return LOG_STAT(STAT_ERR_ARGS, "usage: %s [-j num_threads] input_file_or_dir...", argv[0]);
+
+  TRY(DAR_create(&config->input_filenames, sizeof(char *)));
+
+  // a bad path fails the whole batch up front, rather than showing up as one failed file among many
+  const STAT_Val add_st = add_input_paths(argc - optind, &argv[optind], config);
+  if(!STAT_is_OK(add_st)) {
+    TRY(destroy_batch_config(config));
+    return add_st;
+  }
+
+  return OK;
+}
+
+STAT_Val destroy_batch_config(BatchConfig * config) {
+  CHECK(config != NULL);
+
+  for(char ** filename = DAR_first(&config->input_filenames); filename != DAR_end(&config->input_filenames);
+      filename++) {
+    free(*filename);
+  }
+
+  TRY(DAR_destroy(&config->input_filenames));
+
+  *config = (BatchConfig){0};
+
+  return OK;
+}
+
+static void * run_worker(void * p) {
+  BatchQueue * queue = p;
+
+  const size_t num_files = queue->config->input_filenames.size;
+
+  size_t idx = 0;
+  while((idx = atomic_fetch_add(&queue->next_idx, 1)) < num_files) {
+    const char *  filename = *(char **)DAR_get(&queue->config->input_filenames, idx);
+    BatchResult * result   = &queue->results[idx];
+
+    result->status = queue->solve(filename, result->text, sizeof(result->text));
+  }
+
+  return NULL;
+}
+
+STAT_Val run_batch(const BatchConfig * config, BatchSolveFn solve, size_t * num_failed) {
+  CHECK(config != NULL);
+  CHECK(config->num_threads > 0);
+  CHECK(solve != NULL);
+  CHECK(num_failed != NULL);
+
+  const size_t num_files   = config->input_filenames.size;
+  const size_t num_threads = (config->num_threads < num_files) ? config->num_threads : num_files;
+
+  DAR_DArray results = {0};
+  DAR_DArray threads = {0};
+  TRY(DAR_create(&results, sizeof(BatchResult)));
+  TRY(DAR_create(&threads, sizeof(pthread_t)));
+  TRY(DAR_resize_zeroed(&results, num_files));
+  TRY(DAR_resize_zeroed(&threads, num_threads));
+
+  BatchQueue queue = {.config = config, .solve = solve, .results = DAR_first(&results)};
+  atomic_init(&queue.next_idx, 0);
+
+  // the workers read queue and write results, so every one that started is joined before either goes away
+  STAT_Val    batch_st    = OK;
+  size_t      num_started = 0;
+  pthread_t * thread_ids  = threads.data;
+  for(; num_started < num_threads; num_started++) {
+    const int create_res = pthread_create(&thread_ids[num_started], NULL, run_worker, &queue);
+    if(create_res != 0) {
+      batch_st = LOG_STAT(STAT_ERR_INTERNAL, "failed to create thread: %s", strerror(create_res));
+      break;
+    }
+  }
+
+  for(size_t i = 0; i < num_started; i++) {
+    if(pthread_join(thread_ids[i], NULL) != 0 && STAT_is_OK(batch_st)) {
+      batch_st = LOG_STAT(STAT_ERR_INTERNAL, "failed to join thread");
+    }
+  }
+
+  *num_failed = 0;
+  for(size_t i = 0; i < num_files && STAT_is_OK(batch_st); i++) {
+    const char *        filename = *(char **)DAR_get(&config->input_filenames, i);
+    const BatchResult * result   = DAR_get(&results, i);
+
+    if(STAT_is_OK(result->status)) {
+      printf("%s: %s\n", filename, result->text);
+    } else {
+      printf("%s: error %d\n", filename, (int)result->status);
+      (*num_failed)++;
+    }
+  }
+
+  TRY(DAR_destroy(&threads));
+  TRY(DAR_destroy(&results));
+
+  TRY(batch_st);
+
+  return OK;
+}
@@ -0,0 +1,105 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cfac/log.h>
+#include <cfac/stat.h>
+
+#include "common.h"
+#include "generator.h"
+
+#include <stdbool.h>
+#include <string.h>
+
+// writes num_patterns patterns of ash and rocks, each between 5 x 5 and max_size x max_size. Every pattern has exactly
+// one line of reflection, between two rows or between two columns, like the puzzle input.
+
+#define MIN_SIZE 5
+#define MAX_SIZE 64 // rows and columns are kept as bit masks in a size_t
+
+typedef struct Grid {
+  bool   is_rock[MAX_SIZE][MAX_SIZE];
+  size_t width;
+  size_t height;
+} Grid;
+
+static bool is_row_mirror(const Grid * grid, size_t mirror) { // mirror is between rows mirror - 1 and mirror
+  for(size_t a = mirror, b = mirror - 1; a < grid->height && b < mirror; a++, b--) {
+    if(memcmp(grid->is_rock[a], grid->is_rock[b], grid->width * sizeof(bool)) != 0) return false;
+  }
+  return true;
+}
+
+static bool is_column_mirror(const Grid * grid, size_t mirror) {
+  for(size_t y = 0; y < grid->height; y++) {
+    for(size_t a = mirror, b = mirror - 1; a < grid->width && b < mirror; a++, b--) {
+      if(grid->is_rock[y][a] != grid->is_rock[y][b]) return false;
+    }
+  }
+  return true;
+}
+
+static size_t count_mirrors(const Grid * grid) {
+  size_t count = 0;
+  for(size_t m = 1; m < grid->height; m++) { count += is_row_mirror(grid, m); }
+  for(size_t m = 1; m < grid->width; m++) { count += is_column_mirror(grid, m); }
+  return count;
+}
+
+static void make_pattern(Rng * rng, size_t max_size, Grid * grid) {
+  // a random grid with a mirror between two rows, or its transpose for a mirror between two columns
+  do {
+    const size_t size_a = get_random_in_range(rng, MIN_SIZE, max_size);
+    const size_t size_b = get_random_in_range(rng, MIN_SIZE, max_size);
+    const size_t mirror = get_random_in_range(rng, 1, size_a - 1);
+
+    Grid rows = {.width = size_b, .height = size_a};
+    for(size_t y = 0; y < size_a; y++) {
+      const bool is_reflected = (y >= mirror) && ((2 * mirror) - 1 - y) < mirror; // unsigned, wraps when out of range
+      for(size_t x = 0; x < size_b; x++) {
+        rows.is_rock[y][x] = is_reflected ? rows.is_rock[(2 * mirror) - 1 - y][x] : (get_random_below(rng, 2) == 0);
+      }
+    }
+
+    if(get_random_below(rng, 2) == 0) {
+      *grid = rows;
+    } else {
+      *grid = (Grid){.width = size_a, .height = size_b};
+      for(size_t y = 0; y < size_b; y++) {
+        for(size_t x = 0; x < size_a; x++) { grid->is_rock[y][x] = rows.is_rock[x][y]; }
+      }
+    }
+  } while(count_mirrors(grid) != 1); // small patterns can end up with a second mirror by chance, just try again
+}
+
+int main(int argc, char ** argv) {
+  GeneratorConfig config = {.seed = 1, .sizes = {100, 17}};
+  TRY(parse_generator_args(argc, argv, "[num_patterns [max_size]]", 2, &config));
+
+  const size_t num_patterns = config.sizes[0];
+  const size_t max_size     = config.sizes[1];
+
+  if(max_size < MIN_SIZE || max_size > MAX_SIZE) {
+    return LOG_STAT(STAT_ERR_ARGS, "max_size must be between %d and %d", MIN_SIZE, MAX_SIZE);
+  }
+
+  Rng rng = {0};
+  seed_rng(&rng, config.seed);
+
+  FILE * file = NULL;
+  TRY(open_generator_output(&config, &file));
+
+  Grid grid = {0};
+  for(size_t i = 0; i < num_patterns; i++) {
+    make_pattern(&rng, max_size, &grid);
+
+    if(i > 0) fputc('\n', file);
+    for(size_t y = 0; y < grid.height; y++) {
+      for(size_t x = 0; x < grid.width; x++) { fputc(grid.is_rock[y][x] ? '#' : '.', file); }
+      fputc('\n', file);
+    }
+  }
+
+  TRY(close_generator_output(file));
+
+  return OK;
+}
@@ -36,18 +36,18 @@ static STAT_Val parse_row(SPN_Span line, size_t * row, size_t * width) {
   return OK;
 }
 
-STAT_Val parse_pattern(SPN_Span lines, Pattern * out) {
+STAT_Val parse_pattern(SPN_Span lines /* contains SPN_Span */, Pattern * out) {
   CHECK(!SPN_is_empty(lines));
-  CHECK(lines.element_size == sizeof(DAR_DArray));
+  CHECK(lines.element_size == sizeof(SPN_Span));
   CHECK(out != NULL);
 
   TRY(init_pattern(out));
 
-  for(const DAR_DArray * line = SPN_first(lines); line != SPN_end(lines); line++) {
+  for(const SPN_Span * line = SPN_first(lines); line != SPN_end(lines); line++) {
     size_t width = 0;
     size_t row   = 0;
 
-    TRY(parse_row(DAR_to_span(line), &row, &width));
+    TRY(parse_row(*line, &row, &width));
 
     if(out->width == 0) out->width = width;
     CHECK(out->width == width);
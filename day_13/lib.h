@@ -10,7 +10,7 @@ typedef struct Pattern {
   size_t     width;
 } Pattern;
 
-STAT_Val parse_pattern(SPN_Span lines, Pattern * out);
+STAT_Val parse_pattern(SPN_Span lines /* contains SPN_Span */, Pattern * out);
 
 STAT_Val transpose_pattern(const Pattern * in, Pattern * out);
 
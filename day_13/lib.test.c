@@ -10,11 +10,10 @@ static Result setup(void ** env_pp);
 static Result teardown(void ** env_pp);
 
 static STAT_Val create_lines(const char ** lines_raw, size_t n, DAR_DArray * lines_darr) {
-  TRY(DAR_create(lines_darr, sizeof(DAR_DArray)));
+  TRY(DAR_create(lines_darr, sizeof(SPN_Span)));
 
   for(size_t i = 0; i < n; i++) {
-    DAR_DArray line = {0};
-    TRY(DAR_create_from_cstr(&line, lines_raw[i]));
+    const SPN_Span line = SPN_from_cstr(lines_raw[i]);
     TRY(DAR_push_back(lines_darr, &line));
   }
 
@@ -24,8 +23,6 @@ static STAT_Val create_lines(const char ** lines_raw, size_t n, DAR_DArray * lin
 static STAT_Val destroy_lines(DAR_DArray * lines) {
   CHECK(lines != NULL);
 
-  for(DAR_DArray * p = DAR_first(lines); p != DAR_end(lines); p++) { TRY(DAR_destroy(p)); }
-
   TRY(DAR_destroy(lines));
 
   return OK;
@@ -6,48 +6,20 @@
 #include <cfac/stat.h>
 
 #include "common.h"
+#include "input.h"
 #include "lib.h"
-
-static STAT_Val read_lines_from_file(const char * filename, DAR_DArray * lines) {
-  CHECK(lines != NULL);
-  CHECK(DAR_is_initialized(lines));
-
-  FILE * file_ptr = fopen(filename, "r");
-  CHECK(file_ptr != NULL);
-
-  char *  line_raw = NULL;
-  size_t  len      = 0;
-  ssize_t read     = 0;
-
-  while((read = getline(&line_raw, &len, file_ptr)) != -1) {
-    DAR_DArray line = {0};
-    TRY(DAR_create_from_cstr(&line, line_raw));
-    TRY(DAR_push_back(lines, &line));
-  }
-
-  fclose(file_ptr);
-  free(line_raw);
-
-  return OK;
-}
-
-static STAT_Val destroy_lines(DAR_DArray * lines) {
-  CHECK(lines != NULL);
-
-  for(DAR_DArray * p = DAR_first(lines); p != DAR_end(lines); p++) { TRY(DAR_destroy(p)); }
-
-  TRY(DAR_destroy(lines));
-
-  return OK;
-}
+#include "metrics.h"
 
 int main(void) {
-  DAR_DArray lines = {0};
-  TRY(DAR_create(&lines, sizeof(DAR_DArray)));
+  Metrics metrics = {0};
+  start_metrics(&metrics, "day_13");
 
-  TRY(read_lines_from_file("input.txt", &lines));
+  begin_phase(&metrics, PHASE_READ);
+  InputFile input = {0};
+  TRY(map_input_file("input.txt", &input));
+  end_phase(&metrics);
 
-  SPN_Span lines_span = DAR_to_span(&lines);
+  SPN_Span lines_span = DAR_to_span(&input.lines);
 
   size_t end_cursor   = 0;
   size_t start_cursor = 0;
@@ -56,20 +28,23 @@ int main(void) {
 
   while((start_cursor < lines_span.len) && (end_cursor < lines_span.len)) {
     for(end_cursor = start_cursor; end_cursor < lines_span.len; end_cursor++) {
-      const DAR_DArray * line = SPN_get(lines_span, end_cursor);
+      const SPN_Span * line = SPN_get(lines_span, end_cursor);
 
-      if(line->size == 0) break;
+      if(line->len == 0) break;
 
-      const char * first_char = DAR_first(line);
+      const char * first_char = SPN_first(*line);
       if(!((*first_char == '#') || *first_char == '.')) break;
     }
 
     SPN_Span pattern_span       = SPN_subspan(lines_span, start_cursor, (end_cursor - start_cursor));
     Pattern  pattern            = {0};
     Pattern  pattern_transposed = {0};
+    begin_phase(&metrics, PHASE_PARSE);
     TRY(parse_pattern(pattern_span, &pattern));
     TRY(transpose_pattern(&pattern, &pattern_transposed));
+    end_phase(&metrics);
 
+    begin_phase(&metrics, PHASE_PART1);
     size_t mirror_position = 0;
     bool   has_mirror      = false;
     TRY(find_mirror(&pattern, &has_mirror, &mirror_position));
@@ -81,6 +56,7 @@ int main(void) {
     TRY(find_mirror(&pattern_transposed, &has_mirror, &mirror_position));
 
     if(has_mirror) count += mirror_position;
+    end_phase(&metrics);
 
     TRY(destroy_pattern(&pattern));
     TRY(destroy_pattern(&pattern_transposed));
@@ -88,7 +64,9 @@ int main(void) {
     start_cursor = end_cursor + 1;
   }
 
-  TRY(destroy_lines(&lines));
+  TRY(destroy_input_file(&input));
+
+  TRY(write_metrics(&metrics));
 
   return LOG_STAT(STAT_OK, "count: %zu", count);
 }
@@ -0,0 +1,58 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cfac/darray.h>
+#include <cfac/log.h>
+#include <cfac/stat.h>
+
+#include "common.h"
+#include "driver.h"
+#include "input.h"
+#include "lib.h"
+
+static STAT_Val solve_input(const InputFile * input, char * result, size_t result_size) {
+  int sum_of_possible_ids = 0;
+  int sum_of_powers       = 0;
+  for(const SPN_Span * line = DAR_first(&input->lines); line != DAR_end(&input->lines); line++) {
+    GameResult res = {0};
+    TRY(scan_game_result_from_line(*line, &res));
+
+    if(res.min_color_occurrences[RED] <= 12 && res.min_color_occurrences[GREEN] <= 13 &&
+       res.min_color_occurrences[BLUE] <= 14) {
+      sum_of_possible_ids += res.game_id;
+    }
+    sum_of_powers +=
+        (res.min_color_occurrences[RED] * res.min_color_occurrences[GREEN] * res.min_color_occurrences[BLUE]);
+  }
+
+  snprintf(result, result_size, "sum_of_possible_ids: %d, sum_of_powers: %d", sum_of_possible_ids, sum_of_powers);
+
+  return OK;
+}
+
+static STAT_Val solve_file(const char * filename, char * result, size_t result_size) {
+  InputFile input = {0};
+  TRY(map_input_file(filename, &input));
+
+  // the mapping is released whether or not the input could be solved
+  const STAT_Val solve_st = solve_input(&input, result, result_size);
+  TRY(destroy_input_file(&input));
+  TRY(solve_st);
+
+  return OK;
+}
+
+int main(int argc, char ** argv) {
+  BatchConfig config = {0};
+  TRY(parse_batch_args(argc, argv, &config));
+
+  size_t num_failed = 0;
+  TRY(run_batch(&config, solve_file, &num_failed));
+
+  const size_t num_files = config.input_filenames.size;
+  TRY(destroy_batch_config(&config));
+
+  if(num_failed > 0) return LOG_STAT(STAT_ERR_INTERNAL, "failed to solve %zu of %zu files", num_failed, num_files);
+
+  return OK;
+}
@@ -0,0 +1,163 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cfac/log.h>
+#include <cfac/stat.h>
+
+#include "benchmark.h"
+#include "common.h"
+#include "input.h"
+#include "lib.h"
+
+#define NUM_BENCH_LIMITS (20 * 20 * 20)
+
+typedef struct Context {
+  const char * filename;
+  InputFile    input;
+  Arena        arena; // scratch memory for one line at a time
+  int          sum_of_possible_ids;
+  int          sum_of_powers;
+
+  GameColumns   columns;
+  BagLimitIndex index;
+  BagLimit      limits[NUM_BENCH_LIMITS]; // every combination of 0 to 19 for each color
+  int64_t       sums_of_feasible_ids[NUM_BENCH_LIMITS];
+} Context;
+
+static STAT_Val parse(void * p) {
+  Context * ctx = p;
+  TRY(map_input_file(ctx->filename, &ctx->input));
+  return OK;
+}
+
+static STAT_Val unparse(void * p) {
+  Context * ctx = p;
+  TRY(destroy_input_file(&ctx->input));
+  return OK;
+}
+
+static STAT_Val solve(void * p) {
+  Context * ctx = p;
+
+  ctx->sum_of_possible_ids = 0;
+  ctx->sum_of_powers       = 0;
+  for(const SPN_Span * line = DAR_first(&ctx->input.lines); line != DAR_end(&ctx->input.lines); line++) {
+    GameResult res = {0};
+    TRY(get_game_result_from_line_in_arena(*line, &ctx->arena, &res));
+    TRY(reset_arena(&ctx->arena));
+    if(res.min_color_occurrences[RED] <= 12 && res.min_color_occurrences[GREEN] <= 13 &&
+       res.min_color_occurrences[BLUE] <= 14) {
+      ctx->sum_of_possible_ids += res.game_id;
+    }
+    ctx->sum_of_powers +=
+        (res.min_color_occurrences[RED] * res.min_color_occurrences[GREEN] * res.min_color_occurrences[BLUE]);
+  }
+
+  return OK;
+}
+
+static STAT_Val solve_single_pass(void * p) {
+  Context * ctx = p;
+
+  ctx->sum_of_possible_ids = 0;
+  ctx->sum_of_powers       = 0;
+  for(const SPN_Span * line = DAR_first(&ctx->input.lines); line != DAR_end(&ctx->input.lines); line++) {
+    GameResult res = {0};
+    TRY(scan_game_result_from_line(*line, &res));
+    if(res.min_color_occurrences[RED] <= 12 && res.min_color_occurrences[GREEN] <= 13 &&
+       res.min_color_occurrences[BLUE] <= 14) {
+      ctx->sum_of_possible_ids += res.game_id;
+    }
+    ctx->sum_of_powers +=
+        (res.min_color_occurrences[RED] * res.min_color_occurrences[GREEN] * res.min_color_occurrences[BLUE]);
+  }
+
+  return OK;
+}
+
+static STAT_Val parse_columns(void * p) {
+  Context * ctx = p;
+  TRY(parse(ctx));
+  TRY(create_game_columns(&ctx->columns));
+  for(const SPN_Span * line = DAR_first(&ctx->input.lines); line != DAR_end(&ctx->input.lines); line++) {
+    GameResult res = {0};
+    TRY(scan_game_result_from_line(*line, &res));
+    TRY(push_game_result(&ctx->columns, &res));
+  }
+  return OK;
+}
+
+static STAT_Val unparse_columns(void * p) {
+  Context * ctx = p;
+  TRY(destroy_game_columns(&ctx->columns));
+  TRY(unparse(ctx));
+  return OK;
+}
+
+static STAT_Val build_index(void * p) {
+  Context * ctx = p;
+  TRY(create_bag_limit_index(&ctx->columns, &ctx->index));
+  return OK;
+}
+
+static STAT_Val unbuild_index(void * p) {
+  Context * ctx = p;
+  TRY(destroy_bag_limit_index(&ctx->index));
+  TRY(unparse_columns(ctx));
+  return OK;
+}
+
+static STAT_Val parse_and_build_index(void * p) {
+  Context * ctx = p;
+  TRY(parse_columns(ctx));
+  TRY(build_index(ctx));
+  return OK;
+}
+
+static STAT_Val query_limits_by_filter(void * p) {
+  Context * ctx = p;
+  for(size_t i = 0; i < NUM_BENCH_LIMITS; i++) {
+    TRY(get_sum_of_feasible_ids_by_filter(&ctx->columns, ctx->limits[i], &ctx->sums_of_feasible_ids[i]));
+  }
+  return OK;
+}
+
+static STAT_Val query_limits_by_index(void * p) {
+  Context * ctx = p;
+  TRY(get_sums_of_feasible_ids(&ctx->index, ctx->limits, NUM_BENCH_LIMITS, ctx->sums_of_feasible_ids));
+  return OK;
+}
+
+int main(int argc, char ** argv) {
+  BenchConfig config = {0};
+  TRY(parse_bench_args(argc, argv, &config));
+
+  Context ctx = {.filename = config.input_filename};
+  for(size_t i = 0; i < NUM_BENCH_LIMITS; i++) {
+    ctx.limits[i].max_color_occurrences[RED]   = (int)(i / 400);
+    ctx.limits[i].max_color_occurrences[GREEN] = (int)((i / 20) % 20);
+    ctx.limits[i].max_color_occurrences[BLUE]  = (int)(i % 20);
+  }
+  TRY(create_arena(&ctx.arena, 0));
+
+  const BenchPhase phases[] = {
+      {.name = "parse", .run = parse, .teardown = unparse},
+      {.name = "solve", .setup = parse, .run = solve, .teardown = unparse},
+      {.name = "solve_single_pass", .setup = parse, .run = solve_single_pass, .teardown = unparse},
+      {.name = "build_limit_index", .setup = parse_columns, .run = build_index, .teardown = unbuild_index},
+      {.name     = "query_limits_by_filter",
+       .setup    = parse_columns,
+       .run      = query_limits_by_filter,
+       .teardown = unparse_columns},
+      {.name     = "query_limits_by_index",
+       .setup    = parse_and_build_index,
+       .run      = query_limits_by_index,
+       .teardown = unbuild_index},
+  };
+
+  TRY(run_bench(&config, "day_2", phases, sizeof(phases) / sizeof(phases[0]), &ctx));
+
+  TRY(destroy_arena(&ctx.arena));
+
+  return OK;
+}
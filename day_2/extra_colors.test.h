@@ -0,0 +1,8 @@
+#ifndef extra_colors_test_h
+#define extra_colors_test_h
+
+// two more colors for lib_test_extra_colors, passed with -include so lib.c and lib.test.c both see them. orange is
+// here because its first letter plus length equals red's, so it checks that the two are still told apart
+#define EXTRA_COLORS(X) X(YELLOW, 'y', "yellow") X(ORANGE, 'o', "orange")
+
+#endif
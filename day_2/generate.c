@@ -0,0 +1,64 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cfac/log.h>
+#include <cfac/stat.h>
+
+#include "common.h"
+#include "generator.h"
+#include "lib.h"
+
+// writes num_games games, each with up to max_num_draws draws of up to 20 cubes per color
+
+static const char * color_names[NUM_COLORS] = {
+#define X(color, first_letter, name) [color] = name,
+    COLORS(X)
+#undef X
+};
+
+static void write_draw(FILE * file, Rng * rng) {
+  // every color shows up at most once per draw, in random order, and at least one color shows up
+  Color colors[NUM_COLORS] = {0};
+  for(Color c = COLOR_FIRST; c != COLOR_END; c++) colors[c] = c;
+  for(size_t i = NUM_COLORS - 1; i > 0; i--) {
+    const size_t j   = get_random_below(rng, i + 1);
+    const Color  tmp = colors[i];
+    colors[i]        = colors[j];
+    colors[j]        = tmp;
+  }
+
+  const size_t num_colors = get_random_in_range(rng, 1, NUM_COLORS);
+  for(size_t i = 0; i < num_colors; i++) {
+    fprintf(file, "%s%zu %s", (i == 0) ? "" : ", ", get_random_in_range(rng, 1, 20), color_names[colors[i]]);
+  }
+}
+
+int main(int argc, char ** argv) {
+  GeneratorConfig config = {.seed = 1, .sizes = {100, 6}};
+  TRY(parse_generator_args(argc, argv, "[num_games [max_num_draws]]", 2, &config));
+
+  const size_t num_games     = config.sizes[0];
+  const size_t max_num_draws = config.sizes[1];
+
+  Rng rng = {0};
+  seed_rng(&rng, config.seed);
+
+  FILE * file = NULL;
+  TRY(open_generator_output(&config, &file));
+
+  for(size_t game_id = 1; game_id <= num_games; game_id++) {
+    fprintf(file, "Game %zu: ", game_id);
+
+    const size_t num_draws = get_random_in_range(&rng, 1, max_num_draws);
+    for(size_t i = 0; i < num_draws; i++) {
+      if(i > 0) fputs("; ", file);
+      write_draw(file, &rng);
+    }
+
+    fputc('\n', file);
+  }
+
+  TRY(close_generator_output(file));
+
+  return OK;
+}
@@ -4,19 +4,45 @@
 #include "lib.h"
 
 #include "common.h"
+#include "scan.h"
 
-#include <cfac/darray.h>
-
-#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 #define OK STAT_OK
 
-static const char * g_color_strings[] = {
-    [RED]   = "red",
-    [GREEN] = "green",
-    [BLUE]  = "blue",
+#define MAX_COLOR_LEN              15
+#define COLOR_LETTER(first_letter) ((size_t)(unsigned char)(first_letter) & 0x1f) // 'a' to 'z' are 1 to 26
+
+// color + 1 by first letter and length, 0 for an empty slot. colors that share both overwrite an initializer, which
+// -Woverride-init rejects, and a color longer than MAX_COLOR_LEN is out of the table's bounds
+static const uint8_t g_color_slots[32][MAX_COLOR_LEN + 1] = {
+#define X(color, first_letter, name) [COLOR_LETTER(first_letter)][sizeof(name) - 1] = (color) + 1,
+    COLORS(X)
+#undef X
+};
+
+static const char * const g_color_names[NUM_COLORS] = {
+#define X(color, first_letter, name) [color] = name,
+    COLORS(X)
+#undef X
 };
 
+STAT_Val find_color(SPN_Span word, Color * color) {
+  CHECK(word.element_size == sizeof(char));
+  CHECK(color != NULL);
+
+  if(word.len == 0 || word.len > MAX_COLOR_LEN) return STAT_OK_NOT_FOUND;
+
+  const char *  str  = word.begin;
+  const uint8_t slot = g_color_slots[COLOR_LETTER(str[0])][word.len];
+  if(slot == 0 || memcmp(str, g_color_names[slot - 1], word.len) != 0) return STAT_OK_NOT_FOUND;
+
+  *color = (Color)(slot - 1);
+
+  return OK;
+}
+
 static STAT_Val get_game_id(SPN_Span line, int * out) {
   CHECK(line.len > 0);
   CHECK(out != NULL);
@@ -25,15 +51,19 @@ static STAT_Val get_game_id(SPN_Span line, int * out) {
   TRY(SPN_find_subspan(line, SPN_from_cstr("Game "), &pos_of_game));
   CHECK(pos_of_game == 0);
 
-  CHECK(sscanf(line.begin, "Game %d:", out) == 1);
+  const SPN_Span after_game   = SPN_subspan(line, 5, line.len - 5);
+  size_t         num_consumed = 0;
+  CHECK(scan_int(after_game, out, &num_consumed) == STAT_OK);
 
   return OK;
 }
 
-static STAT_Val split_by_delim(SPN_Span span, SPN_Span delim, DAR_DArray * spans) {
+// pieces may be NULL to only count them, an empty piece at the end is left out
+static STAT_Val find_pieces(SPN_Span span, SPN_Span delim, SPN_Span * pieces, size_t * num_pieces) {
   CHECK(delim.len > 0);
-  CHECK(spans != NULL);
-  CHECK(DAR_is_initialized(spans));
+  CHECK(num_pieces != NULL);
+
+  *num_pieces = 0;
 
   while(span.len != 0) {
     size_t   delim_idx = 0;
@@ -43,13 +73,13 @@ static STAT_Val split_by_delim(SPN_Span span, SPN_Span delim, DAR_DArray * spans
 
     if(find_res == STAT_OK) {
       SPN_Span subsp = SPN_subspan(span, 0, delim_idx); // take subspan from 0 to start of delim
-      TRY(DAR_push_back(spans, &subsp));
+      if(pieces != NULL) pieces[*num_pieces] = subsp;
+      (*num_pieces)++;
       span = SPN_subspan(span, subsp.len + delim.len, span.len);
-    } else if(find_res == STAT_OK_NOT_FOUND) {
-      // delim not found, add current span fully (if it is not empty)
-      if(span.len > 0) { TRY(DAR_push_back(spans, &span)); }
-      break;
     } else {
+      // delim not found, add current span fully
+      if(pieces != NULL) pieces[*num_pieces] = span;
+      (*num_pieces)++;
       break;
     }
   }
@@ -57,6 +87,20 @@ static STAT_Val split_by_delim(SPN_Span span, SPN_Span delim, DAR_DArray * spans
   return OK;
 }
 
+static STAT_Val split_by_delim(SPN_Span span, SPN_Span delim, Arena * arena, SPN_MutSpan * spans) {
+  CHECK(arena != NULL);
+  CHECK(spans != NULL);
+
+  // count first, so the pieces fit exactly in one allocation from the arena
+  size_t num_pieces = 0;
+  TRY(find_pieces(span, delim, NULL, &num_pieces));
+
+  TRY(allocate_span_from_arena(arena, sizeof(SPN_Span), num_pieces, spans));
+  TRY(find_pieces(span, delim, spans->begin, &num_pieces));
+
+  return OK;
+}
+
 static STAT_Val trim_whitespace(SPN_Span * span) {
   CHECK(span != NULL);
 
@@ -73,54 +117,46 @@ static STAT_Val get_color_entry(SPN_Span color_entry_span, int * num, Color * co
 
   TRY(trim_whitespace(&color_entry_span));
 
-  DAR_DArray count_and_color = {0};
-  TRY(DAR_create(&count_and_color, sizeof(SPN_Span)));
+  size_t num_consumed = 0;
+  CHECK(scan_int(color_entry_span, num, &num_consumed) == STAT_OK);
+  color_entry_span = SPN_subspan(color_entry_span, num_consumed, color_entry_span.len - num_consumed);
 
-  TRY(split_by_delim(color_entry_span, SPN_from_cstr(" "), &count_and_color));
+  const size_t num_blanks = scan_skip_blanks(color_entry_span);
+  color_entry_span        = SPN_subspan(color_entry_span, num_blanks, color_entry_span.len - num_blanks);
 
-  CHECK(sscanf(((SPN_Span *)DAR_first(&count_and_color))->begin, "%d", num) == 1);
-
-  bool found = false;
-  for(Color c = COLOR_FIRST; c != COLOR_END; c++) {
-    size_t idx = SIZE_MAX;
-    TRY(SPN_find_subspan(*(SPN_Span *)DAR_last(&count_and_color), SPN_from_cstr(g_color_strings[c]), &idx));
-    if(idx == 0) {
-      found  = true;
-      *color = c;
-    }
-  }
-  if(!found) return LOG_STAT(STAT_ERR_NOT_FOUND, "failed to find color");
+  // the color is followed by the newline in the last entry of a line
+  const char * str      = color_entry_span.begin;
+  size_t       word_len = 0;
+  while(word_len < color_entry_span.len && str[word_len] >= 'a' && str[word_len] <= 'z') word_len++;
 
-  TRY(DAR_destroy(&count_and_color));
+  const STAT_Val find_st = find_color(SPN_subspan(color_entry_span, 0, word_len), color);
+  TRY(find_st);
+  if(find_st == STAT_OK_NOT_FOUND) return LOG_STAT(STAT_ERR_NOT_FOUND, "failed to find color");
 
   return OK;
 }
 
-STAT_Val get_game_result_from_line(SPN_Span line, GameResult * out) {
+STAT_Val get_game_result_from_line_in_arena(SPN_Span line, Arena * arena, GameResult * out) {
   CHECK(line.len > 0);
+  CHECK(arena != NULL);
   CHECK(out != NULL);
   *out = (GameResult){0};
 
-  DAR_DArray game_and_sets = {0};
-
-  TRY(DAR_create(&game_and_sets, sizeof(SPN_Span)));
+  SPN_MutSpan game_and_sets = {0};
+  TRY(split_by_delim(line, SPN_from_cstr(":"), arena, &game_and_sets));
+  CHECK(game_and_sets.len > 0);
 
-  TRY(split_by_delim(line, SPN_from_cstr(":"), &game_and_sets));
-  TRY(get_game_id(*(SPN_Span *)DAR_first(&game_and_sets), &(out->game_id)));
+  TRY(get_game_id(*(SPN_Span *)SPN_first(game_and_sets), &(out->game_id)));
 
-  if(game_and_sets.size > 1) {
-    DAR_DArray sets = {0};
-    TRY(DAR_create(&sets, sizeof(SPN_Span)));
+  if(game_and_sets.len > 1) {
+    SPN_MutSpan sets = {0};
+    TRY(split_by_delim(*(SPN_Span *)SPN_last(game_and_sets), SPN_from_cstr(";"), arena, &sets));
 
-    TRY(split_by_delim(*(SPN_Span *)DAR_last(&game_and_sets), SPN_from_cstr(";"), &sets));
+    for(SPN_Span * sp = SPN_first(sets); sp != SPN_end(sets); sp++) {
+      SPN_MutSpan color_entry_spans = {0};
+      TRY(split_by_delim(*sp, SPN_from_cstr(","), arena, &color_entry_spans));
 
-    for(SPN_Span * sp = DAR_first(&sets); sp != DAR_end(&sets); sp++) {
-      DAR_DArray color_entry_spans = {0};
-      TRY(DAR_create(&color_entry_spans, sizeof(SPN_Span)));
-
-      TRY(split_by_delim(*sp, SPN_from_cstr(","), &color_entry_spans));
-
-      for(SPN_Span * entry_span = DAR_first(&color_entry_spans); entry_span != DAR_end(&color_entry_spans);
+      for(SPN_Span * entry_span = SPN_first(color_entry_spans); entry_span != SPN_end(color_entry_spans);
           entry_span++) {
         Color color = RED;
         int   count = 0;
@@ -129,14 +165,268 @@ STAT_Val get_game_result_from_line(SPN_Span line, GameResult * out) {
         out->min_color_occurrences[color] =
             (out->min_color_occurrences[color] < count) ? count : out->min_color_occurrences[color];
       }
+    }
+  }
 
-      TRY(DAR_destroy(&color_entry_spans));
+  return OK;
+}
+
+STAT_Val get_game_result_from_line(SPN_Span line, GameResult * out) {
+  Arena arena = {0};
+  TRY(create_arena(&arena, 0));
+
+  TRY(get_game_result_from_line_in_arena(line, &arena, out));
+
+  TRY(destroy_arena(&arena));
+
+  return OK;
+}
+
+STAT_Val scan_game_result_from_line(SPN_Span line, GameResult * out) {
+  CHECK(line.element_size == sizeof(char));
+  CHECK(out != NULL);
+  *out = (GameResult){0};
+
+  const char *   str         = line.begin;
+  const SPN_Span game_prefix = SPN_from_cstr("Game ");
+  CHECK(line.len > game_prefix.len && memcmp(str, game_prefix.begin, game_prefix.len) == 0);
+
+  size_t pos          = game_prefix.len;
+  size_t num_consumed = 0;
+  CHECK(scan_int(SPN_subspan(line, pos, line.len - pos), &out->game_id, &num_consumed) == OK);
+  pos += num_consumed;
+
+  CHECK(pos < line.len && str[pos] == ':');
+  pos++;
+
+  // entries look like "<count> <color>", separated by ',' within a set and by ';' between sets, which is the same
+  // thing as far as the minimum occurrences are concerned
+  while(true) {
+    int            count    = 0;
+    const STAT_Val count_st = scan_int(SPN_subspan(line, pos, line.len - pos), &count, &num_consumed);
+    TRY(count_st);
+    pos += num_consumed;
+    if(count_st == STAT_OK_NOT_FOUND) break;
+
+    pos += scan_skip_blanks(SPN_subspan(line, pos, line.len - pos));
+    const size_t color_begin = pos;
+    while(pos < line.len && str[pos] >= 'a' && str[pos] <= 'z') pos++;
+
+    Color          color   = RED;
+    const STAT_Val find_st = find_color(SPN_subspan(line, color_begin, pos - color_begin), &color);
+    TRY(find_st);
+    if(find_st == STAT_OK_NOT_FOUND) {
+      return LOG_STAT(
+          STAT_ERR_NOT_FOUND, "failed to find color '%.*s'", (int)(pos - color_begin), &str[color_begin]);
     }
+    if(out->min_color_occurrences[color] < count) out->min_color_occurrences[color] = count;
+
+    pos += scan_skip_blanks(SPN_subspan(line, pos, line.len - pos));
+    if(pos == line.len || (str[pos] != ',' && str[pos] != ';')) break;
+    pos++;
+  }
 
-    TRY(DAR_destroy(&sets));
+  if(pos < line.len && str[pos] != '\n') {
+    return LOG_STAT(STAT_ERR_READ, "unexpected '%c' in game line '%.*s'", str[pos], (int)line.len, str);
   }
 
-  TRY(DAR_destroy(&game_and_sets));
+  return OK;
+}
+
+STAT_Val create_game_columns(GameColumns * columns) {
+  CHECK(columns != NULL);
+
+  *columns = (GameColumns){0};
+
+  TRY(DAR_create(&columns->game_ids, sizeof(int)));
+  for(Color c = COLOR_FIRST; c != COLOR_END; c++) TRY(DAR_create(&columns->color_occurrences[c], sizeof(int)));
+
+  return OK;
+}
+
+STAT_Val destroy_game_columns(GameColumns * columns) {
+  CHECK(columns != NULL);
+
+  TRY(DAR_destroy(&columns->game_ids));
+  for(Color c = COLOR_FIRST; c != COLOR_END; c++) TRY(DAR_destroy(&columns->color_occurrences[c]));
+
+  *columns = (GameColumns){0};
+
+  return OK;
+}
+
+STAT_Val push_game_result(GameColumns * columns, const GameResult * result) {
+  CHECK(columns != NULL);
+  CHECK(result != NULL);
+
+  TRY(DAR_push_back(&columns->game_ids, &result->game_id));
+  for(Color c = COLOR_FIRST; c != COLOR_END; c++) {
+    TRY(DAR_push_back(&columns->color_occurrences[c], &result->min_color_occurrences[c]));
+  }
+
+  return OK;
+}
+
+STAT_Val get_sum_of_feasible_ids_by_filter(const GameColumns * columns, BagLimit limit, int64_t * sum) {
+  CHECK(columns != NULL);
+  CHECK(sum != NULL);
+
+  const int * ids = columns->game_ids.data;
+  const int * occurrences[NUM_COLORS];
+  for(Color c = COLOR_FIRST; c != COLOR_END; c++) occurrences[c] = columns->color_occurrences[c].data;
+
+  // no branches in the loop body, so the compiler is free to vectorize it
+  int64_t total = 0;
+  for(size_t i = 0; i < columns->game_ids.size; i++) {
+    int fits = 1;
+    for(Color c = COLOR_FIRST; c != COLOR_END; c++) fits &= (occurrences[c][i] <= limit.max_color_occurrences[c]);
+    total += (int64_t)(ids[i] & -fits);
+  }
+
+  *sum = total;
+
+  return OK;
+}
+
+static int compare_ints(const void * a, const void * b) {
+  const int lhs = *(const int *)a;
+  const int rhs = *(const int *)b;
+  return (lhs > rhs) - (lhs < rhs);
+}
+
+static STAT_Val get_distinct_sorted(const DAR_DArray * values, DAR_DArray * distinct) {
+  TRY(DAR_clear(distinct));
+  TRY(DAR_push_back_darray(distinct, values));
+  if(distinct->size == 0) return OK;
+
+  qsort(distinct->data, distinct->size, sizeof(int), compare_ints);
+
+  int *  data     = distinct->data;
+  size_t num_kept = 1;
+  for(size_t i = 1; i < distinct->size; i++) {
+    if(data[i] != data[num_kept - 1]) data[num_kept++] = data[i];
+  }
+
+  TRY(DAR_resize_zeroed(distinct, num_kept));
+
+  return OK;
+}
+
+// number of values <= limit
+static size_t count_at_most(const DAR_DArray * sorted, int limit) {
+  const int * data  = sorted->data;
+  size_t      first = 0;
+  size_t      last  = sorted->size;
+  while(first < last) {
+    const size_t mid = first + ((last - first) / 2);
+    if(data[mid] <= limit) {
+      first = mid + 1;
+    } else {
+      last = mid;
+    }
+  }
+  return first;
+}
+
+STAT_Val create_bag_limit_index(const GameColumns * columns, BagLimitIndex * index) {
+  CHECK(columns != NULL);
+  CHECK(index != NULL);
+
+  *index = (BagLimitIndex){.columns = columns};
+
+  TRY(DAR_create(&index->prefix_sums, sizeof(int64_t)));
+  for(Color c = COLOR_FIRST; c != COLOR_END; c++) TRY(DAR_create(&index->distinct_occurrences[c], sizeof(int)));
+
+  if(columns->game_ids.size == 0) return OK;
+
+  size_t num_cells = 1;
+  for(Color c = COLOR_FIRST; c != COLOR_END; c++) {
+    TRY(get_distinct_sorted(&columns->color_occurrences[c], &index->distinct_occurrences[c]));
+
+    const size_t num_distinct = index->distinct_occurrences[c].size;
+    if(num_distinct > BAG_LIMIT_INDEX_MAX_CELLS / num_cells) return OK; // too large, queries fall back to filtering
+    num_cells *= num_distinct;
+  }
+
+  // row-major, so the last color varies fastest
+  size_t stride = 1;
+  for(Color c = COLOR_END; c-- != COLOR_FIRST;) {
+    index->strides[c] = stride;
+    stride *= index->distinct_occurrences[c].size;
+  }
+
+  TRY(DAR_resize_zeroed(&index->prefix_sums, num_cells));
+  int64_t * sums = index->prefix_sums.data;
+
+  // every game lands on the cell of its own occurrences, each value is present so the searches always find it
+  const int * ids = columns->game_ids.data;
+  for(size_t i = 0; i < columns->game_ids.size; i++) {
+    size_t cell = 0;
+    for(Color c = COLOR_FIRST; c != COLOR_END; c++) {
+      const int * occurrences = columns->color_occurrences[c].data;
+      cell += (count_at_most(&index->distinct_occurrences[c], occurrences[i]) - 1) * index->strides[c];
+    }
+    sums[cell] += ids[i];
+  }
+
+  // then accumulate along each axis in turn, after which a cell holds the sum over everything it dominates
+  for(Color c = COLOR_FIRST; c != COLOR_END; c++) {
+    const size_t axis_stride = index->strides[c];
+    const size_t axis_len    = index->distinct_occurrences[c].size;
+    const size_t block_size  = axis_stride * axis_len;
+
+    for(size_t block = 0; block < num_cells; block += block_size) {
+      for(size_t k = 1; k < axis_len; k++) {
+        int64_t *       row  = &sums[block + (k * axis_stride)];
+        const int64_t * prev = row - axis_stride;
+        for(size_t j = 0; j < axis_stride; j++) row[j] += prev[j];
+      }
+    }
+  }
+
+  return OK;
+}
+
+STAT_Val destroy_bag_limit_index(BagLimitIndex * index) {
+  CHECK(index != NULL);
+
+  for(Color c = COLOR_FIRST; c != COLOR_END; c++) TRY(DAR_destroy(&index->distinct_occurrences[c]));
+  TRY(DAR_destroy(&index->prefix_sums));
+
+  *index = (BagLimitIndex){0};
+
+  return OK;
+}
+
+STAT_Val get_sums_of_feasible_ids(const BagLimitIndex * index,
+                                  const BagLimit *      limits,
+                                  size_t                num_limits,
+                                  int64_t *             sums) {
+  CHECK(index != NULL);
+  CHECK(index->columns != NULL);
+  CHECK(limits != NULL || num_limits == 0);
+  CHECK(sums != NULL || num_limits == 0);
+
+  if(index->prefix_sums.size == 0) {
+    for(size_t i = 0; i < num_limits; i++) {
+      TRY(get_sum_of_feasible_ids_by_filter(index->columns, limits[i], &sums[i]));
+    }
+    return OK;
+  }
+
+  const int64_t * prefix_sums = index->prefix_sums.data;
+
+  for(size_t i = 0; i < num_limits; i++) {
+    size_t cell = 0;
+    Color  c    = COLOR_FIRST;
+    for(; c != COLOR_END; c++) {
+      const size_t n = count_at_most(&index->distinct_occurrences[c], limits[i].max_color_occurrences[c]);
+      if(n == 0) break; // nothing fits if a limit is below every occurrence count of its color
+      cell += (n - 1) * index->strides[c];
+    }
+
+    sums[i] = (c == COLOR_END) ? prefix_sums[cell] : 0;
+  }
 
   return OK;
 }
@@ -3,15 +3,35 @@
 
 #include <cfac/stat.h>
 
+#include <cfac/darray.h>
 #include <cfac/span.h>
 
+#include "arena.h"
+
+#include <stdint.h>
+
+// every color as X(enum value, first letter, name), more colors can be configured at build time by defining
+// EXTRA_COLORS in the same form, e.g. #define EXTRA_COLORS(X) X(YELLOW, 'y', "yellow") in a header passed with
+// -include. colors are looked up by first letter and length together, so only two colors that share both (or one longer
+// than 15 letters) fail to compile
+#ifndef EXTRA_COLORS
+#define EXTRA_COLORS(X)
+#endif
+
+#define COLORS(X) X(RED, 'r', "red") X(GREEN, 'g', "green") X(BLUE, 'b', "blue") EXTRA_COLORS(X)
+
 typedef enum Color {
-  RED = 0, GREEN, BLUE, 
+#define X(color, first_letter, name) color,
+  COLORS(X)
+#undef X
   NUM_COLORS,
   COLOR_FIRST = 0,
   COLOR_END = NUM_COLORS,
 } Color;
 
+// constant time lookup of the color spelled by word, STAT_OK_NOT_FOUND if word is not a color
+STAT_Val find_color(SPN_Span word, Color * color);
+
 typedef struct GameResult {
   int game_id;
   int min_color_occurrences[NUM_COLORS];
@@ -19,4 +39,49 @@ typedef struct GameResult {
 
 STAT_Val get_game_result_from_line(const SPN_Span line, GameResult * out);
 
+// takes its scratch memory from arena, which the caller can reset once the line is done
+STAT_Val get_game_result_from_line_in_arena(SPN_Span line, Arena * arena, GameResult * out);
+
+// same result in a single left to right pass over line, without any allocation
+STAT_Val scan_game_result_from_line(SPN_Span line, GameResult * out);
+
+// GameResults stored column by column, i.e. one array of ids and one array of occurrences per color
+typedef struct GameColumns {
+  DAR_DArray game_ids;                      // int
+  DAR_DArray color_occurrences[NUM_COLORS]; // int
+} GameColumns;
+
+STAT_Val create_game_columns(GameColumns * columns);
+STAT_Val destroy_game_columns(GameColumns * columns);
+STAT_Val push_game_result(GameColumns * columns, const GameResult * result);
+
+typedef struct BagLimit {
+  int max_color_occurrences[NUM_COLORS];
+} BagLimit;
+
+// sum of the ids of the games that fit within limit, in one branch free pass over the columns
+STAT_Val get_sum_of_feasible_ids_by_filter(const GameColumns * columns, BagLimit limit, int64_t * sum);
+
+// answers BagLimit queries without looking at the games again: the distinct occurrence counts of each color are
+// sorted, and a prefix sum grid with one axis per color holds the sum of ids of all games dominated by each
+// combination of them, if that grid would have more than BAG_LIMIT_INDEX_MAX_CELLS cells, queries fall back to
+// filtering the columns
+#define BAG_LIMIT_INDEX_MAX_CELLS (1u << 24)
+
+typedef struct BagLimitIndex {
+  const GameColumns * columns;                          // not owned, must outlive the index
+  DAR_DArray          distinct_occurrences[NUM_COLORS]; // int, ascending
+  size_t              strides[NUM_COLORS];              // of each color's axis in prefix_sums, the last one is 1
+  DAR_DArray          prefix_sums;                      // int64_t, empty if the grid would be too large
+} BagLimitIndex;
+
+STAT_Val create_bag_limit_index(const GameColumns * columns, BagLimitIndex * index);
+STAT_Val destroy_bag_limit_index(BagLimitIndex * index);
+
+// sums[i] is the sum of ids of the games that fit within limits[i]
+STAT_Val get_sums_of_feasible_ids(const BagLimitIndex * index,
+                                  const BagLimit *      limits,
+                                  size_t                num_limits,
+                                  int64_t *             sums);
+
 #endif
@@ -143,6 +143,231 @@ static Result tst_examples(void) {
   return r;
 }
 
+static Result tst_examples_in_arena(void) {
+  Result r = PASS;
+
+  const char * lines[] = {
+      "Game 1: 3 blue, 4 red; 1 red, 2 green, 6 blue; 2 green",
+      "Game 2: 1 blue, 2 green; 3 green, 4 blue, 1 red; 1 green, 1 blue",
+      "Game 3: 8 green, 6 blue, 20 red; 5 blue, 4 red, 13 green; 5 green, 1 red",
+  };
+  const int expect_powers[] = {48, 12, 1560};
+
+  Arena arena = {0};
+  EXPECT_OK(&r, create_arena(&arena, 0));
+  if(HAS_FAILED(&r)) return r;
+
+  // the same arena serves every line, released in between
+  for(size_t i = 0; i < sizeof(lines) / sizeof(lines[0]); i++) {
+    GameResult result = {0};
+    EXPECT_OK(&r, get_game_result_from_line_in_arena(SPN_from_cstr(lines[i]), &arena, &result));
+    EXPECT_EQ(&r, (int)i + 1, result.game_id);
+    EXPECT_EQ(&r,
+              expect_powers[i],
+              result.min_color_occurrences[RED] * result.min_color_occurrences[GREEN] *
+                  result.min_color_occurrences[BLUE]);
+    EXPECT_OK(&r, reset_arena(&arena));
+  }
+
+  EXPECT_OK(&r, destroy_arena(&arena));
+
+  return r;
+}
+
+static Result tst_arena_grows_and_merges_on_reset(void) {
+  Result r = PASS;
+
+  Arena arena = {0};
+  EXPECT_OK(&r, create_arena(&arena, 0));
+  if(HAS_FAILED(&r)) return r;
+
+  // far more than the initial block holds, so more blocks get added
+  SPN_MutSpan spans[64] = {0};
+  for(size_t i = 0; i < 64; i++) {
+    EXPECT_OK(&r, allocate_span_from_arena(&arena, sizeof(size_t), 1000, &spans[i]));
+    if(HAS_FAILED(&r)) break;
+    EXPECT_EQ(&r, 1000, spans[i].len);
+    EXPECT_EQ(&r, 0, *(size_t *)SPN_last(spans[i])); // zeroed
+    *(size_t *)SPN_last(spans[i]) = i;
+  }
+  for(size_t i = 0; i < 64 && !HAS_FAILED(&r); i++) { EXPECT_EQ(&r, i, *(size_t *)SPN_last(spans[i])); }
+
+  EXPECT_OK(&r, reset_arena(&arena));
+
+  SPN_MutSpan span = {0};
+  EXPECT_OK(&r, allocate_span_from_arena(&arena, sizeof(size_t), 64 * 1000, &span));
+  EXPECT_EQ(&r, 0, *(size_t *)SPN_last(span));
+
+  EXPECT_OK(&r, destroy_arena(&arena));
+
+  return r;
+}
+
+static Result tst_scan_game_result_from_line(void) {
+  Result r = PASS;
+
+  const char * lines[] = {
+      "Game 1: 3 blue, 4 red; 1 red, 2 green, 6 blue; 2 green\n",
+      "Game 2: 1 blue, 2 green; 3 green, 4 blue, 1 red; 1 green, 1 blue\n",
+      "Game 3: 8 green, 6 blue, 20 red; 5 blue, 4 red, 13 green; 5 green, 1 red",
+      "Game 4: 1 green, 3 red, 6 blue; 3 green, 6 red; 3 green, 15 blue, 14 red\n",
+      "Game 53: 9 red, 2 green\n",
+  };
+
+  // must agree with the splitting parser on every line
+  for(size_t i = 0; i < sizeof(lines) / sizeof(lines[0]); i++) {
+    GameResult expected = {0};
+    GameResult result   = {0};
+    EXPECT_OK(&r, get_game_result_from_line(SPN_from_cstr(lines[i]), &expected));
+    EXPECT_OK(&r, scan_game_result_from_line(SPN_from_cstr(lines[i]), &result));
+    EXPECT_EQ(&r, expected.game_id, result.game_id);
+    EXPECT_ARREQ(&r, int, expected.min_color_occurrences, result.min_color_occurrences, NUM_COLORS);
+    if(HAS_FAILED(&r)) {
+      printf("%s", lines[i]);
+      return r;
+    }
+  }
+
+  GameResult result = {0};
+  EXPECT_EQ(&r, STAT_ERR_NOT_FOUND, scan_game_result_from_line(SPN_from_cstr("Game 1: 3 purple\n"), &result));
+  EXPECT_EQ(&r, STAT_ERR_READ, scan_game_result_from_line(SPN_from_cstr("Game 1: 3 red. 4 blue\n"), &result));
+  EXPECT_EQ(&r, STAT_ERR_ASSERTION, scan_game_result_from_line(SPN_from_cstr("Gme 1: 3 red\n"), &result));
+
+  return r;
+}
+
+static Result tst_bag_limit_index_on_examples(void) {
+  Result r = PASS;
+
+  const GameResult games[] = {
+      {.game_id = 1, .min_color_occurrences = {[RED] = 4, [GREEN] = 2, [BLUE] = 6}},
+      {.game_id = 2, .min_color_occurrences = {[RED] = 1, [GREEN] = 3, [BLUE] = 4}},
+      {.game_id = 3, .min_color_occurrences = {[RED] = 20, [GREEN] = 13, [BLUE] = 6}},
+      {.game_id = 4, .min_color_occurrences = {[RED] = 14, [GREEN] = 3, [BLUE] = 15}},
+      {.game_id = 5, .min_color_occurrences = {[RED] = 6, [GREEN] = 3, [BLUE] = 2}},
+  };
+
+  GameColumns columns = {0};
+  EXPECT_OK(&r, create_game_columns(&columns));
+  for(size_t i = 0; i < sizeof(games) / sizeof(games[0]); i++) EXPECT_OK(&r, push_game_result(&columns, &games[i]));
+
+  BagLimitIndex index = {0};
+  EXPECT_OK(&r, create_bag_limit_index(&columns, &index));
+  EXPECT_NE(&r, 0, index.prefix_sums.size);
+
+  const BagLimit limits[] = {
+      {.max_color_occurrences = {[RED] = 12, [GREEN] = 13, [BLUE] = 14}},
+      {.max_color_occurrences = {[RED] = 100, [GREEN] = 100, [BLUE] = 100}},
+      {.max_color_occurrences = {[RED] = 0, [GREEN] = 100, [BLUE] = 100}},
+      {.max_color_occurrences = {[RED] = 4, [GREEN] = 3, [BLUE] = 6}},
+      {.max_color_occurrences = {[RED] = 5, [GREEN] = 2, [BLUE] = 100}},
+      {.max_color_occurrences = {[RED] = 20, [GREEN] = 12, [BLUE] = 15}},
+  };
+  const int64_t expected[] = {8, 15, 0, 3, 1, 12};
+
+  int64_t sums[sizeof(limits) / sizeof(limits[0])] = {0};
+  EXPECT_OK(&r, get_sums_of_feasible_ids(&index, limits, sizeof(limits) / sizeof(limits[0]), sums));
+  EXPECT_ARREQ(&r, int64_t, expected, sums, sizeof(limits) / sizeof(limits[0]));
+
+  for(size_t i = 0; i < sizeof(limits) / sizeof(limits[0]); i++) {
+    int64_t sum = 0;
+    EXPECT_OK(&r, get_sum_of_feasible_ids_by_filter(&columns, limits[i], &sum));
+    EXPECT_EQ(&r, expected[i], sum);
+  }
+
+  EXPECT_OK(&r, destroy_bag_limit_index(&index));
+  EXPECT_OK(&r, destroy_game_columns(&columns));
+
+  return r;
+}
+
+static Result tst_bag_limit_index_matches_filter(void) {
+  Result r = PASS;
+
+  GameColumns columns = {0};
+  EXPECT_OK(&r, create_game_columns(&columns));
+
+  // an index over no games answers every query with 0
+  BagLimitIndex index = {0};
+  EXPECT_OK(&r, create_bag_limit_index(&columns, &index));
+  const BagLimit any_limit = {.max_color_occurrences = {[RED] = 10, [GREEN] = 10, [BLUE] = 10}};
+  int64_t        sum       = -1;
+  EXPECT_OK(&r, get_sums_of_feasible_ids(&index, &any_limit, 1, &sum));
+  EXPECT_EQ(&r, 0, sum);
+  EXPECT_OK(&r, destroy_bag_limit_index(&index));
+
+  unsigned state = 12345;
+  for(int id = 1; id <= 2000; id++) {
+    GameResult game = {.game_id = id};
+    for(Color c = COLOR_FIRST; c != COLOR_END; c++) {
+      state                         = (state * 1103515245u) + 12345u;
+      game.min_color_occurrences[c] = (int)((state >> 16) % 25);
+    }
+    EXPECT_OK(&r, push_game_result(&columns, &game));
+  }
+
+  EXPECT_OK(&r, create_bag_limit_index(&columns, &index));
+
+  BagLimit limits[500] = {0};
+  for(size_t i = 0; i < sizeof(limits) / sizeof(limits[0]); i++) {
+    for(Color c = COLOR_FIRST; c != COLOR_END; c++) {
+      state                              = (state * 1103515245u) + 12345u;
+      limits[i].max_color_occurrences[c] = (int)((state >> 16) % 30) - 2;
+    }
+  }
+
+  int64_t sums[sizeof(limits) / sizeof(limits[0])] = {0};
+  EXPECT_OK(&r, get_sums_of_feasible_ids(&index, limits, sizeof(limits) / sizeof(limits[0]), sums));
+
+  for(size_t i = 0; i < sizeof(limits) / sizeof(limits[0]); i++) {
+    EXPECT_OK(&r, get_sum_of_feasible_ids_by_filter(&columns, limits[i], &sum));
+    EXPECT_EQ(&r, sum, sums[i]);
+    if(HAS_FAILED(&r)) return r;
+  }
+
+  EXPECT_OK(&r, destroy_bag_limit_index(&index));
+  EXPECT_OK(&r, destroy_game_columns(&columns));
+
+  return r;
+}
+
+static Result tst_find_color(void) {
+  Result r = PASS;
+
+  Color color = NUM_COLORS;
+  EXPECT_EQ(&r, STAT_OK, find_color(SPN_from_cstr("red"), &color));
+  EXPECT_EQ(&r, RED, color);
+  EXPECT_EQ(&r, STAT_OK, find_color(SPN_from_cstr("green"), &color));
+  EXPECT_EQ(&r, GREEN, color);
+  EXPECT_EQ(&r, STAT_OK, find_color(SPN_from_cstr("blue"), &color));
+  EXPECT_EQ(&r, BLUE, color);
+
+  // every configured color is found by its own name, extra colors included
+  const struct {
+    Color        color;
+    const char * name;
+  } all_colors[] = {
+#define X(color, first_letter, name) {color, name},
+      COLORS(X)
+#undef X
+  };
+  for(size_t i = 0; i < sizeof(all_colors) / sizeof(all_colors[0]); i++) {
+    EXPECT_EQ(&r, STAT_OK, find_color(SPN_from_cstr(all_colors[i].name), &color));
+    EXPECT_EQ(&r, all_colors[i].color, color);
+  }
+
+  // same first letter and length as a color, but not that color
+  color = NUM_COLORS;
+  EXPECT_EQ(&r, STAT_OK_NOT_FOUND, find_color(SPN_from_cstr("rod"), &color));
+  EXPECT_EQ(&r, STAT_OK_NOT_FOUND, find_color(SPN_from_cstr("bluE"), &color));
+  EXPECT_EQ(&r, STAT_OK_NOT_FOUND, find_color(SPN_from_cstr("reds"), &color));
+  EXPECT_EQ(&r, STAT_OK_NOT_FOUND, find_color(SPN_from_cstr("gree"), &color));
+  EXPECT_EQ(&r, STAT_OK_NOT_FOUND, find_color(SPN_from_cstr(""), &color));
+  EXPECT_EQ(&r, NUM_COLORS, color);
+
+  return r;
+}
+
 static Result tst_fixture(void * env) {
   Result r = PASS;
 
@@ -158,6 +383,12 @@ int main(void) {
       tst_single_set_multi_colors,
       tst_multi_set_multi_colors,
       tst_examples,
+      tst_examples_in_arena,
+      tst_arena_grows_and_merges_on_reset,
+      tst_find_color,
+      tst_scan_game_result_from_line,
+      tst_bag_limit_index_on_examples,
+      tst_bag_limit_index_matches_filter,
   };
 
   TestWithFixture tests_with_fixture[] = {
@@ -1,67 +1,59 @@
 #include <stdio.h>
 #include <stdlib.h>
 
-#include <cfac/darray.h>
 #include <cfac/log.h>
 #include <cfac/stat.h>
 
 #include "common.h"
+#include "input.h"
 #include "lib.h"
+#include "metrics.h"
 
-static STAT_Val read_lines_from_file(const char * filename, DAR_DArray * lines) {
-  CHECK(lines != NULL);
-  CHECK(DAR_is_initialized(lines));
+int main(int argc, char ** argv) {
+  const char * filename = (argc > 1) ? argv[1] : "input.txt"; // "-" reads from stdin
 
-  FILE * file_ptr = fopen(filename, "r");
-  CHECK(file_ptr != NULL);
+  Metrics metrics = {0};
+  start_metrics(&metrics, "day_2");
 
-  char *  line_raw = NULL;
-  size_t  len      = 0;
-  ssize_t read     = 0;
-
-  while((read = getline(&line_raw, &len, file_ptr)) != -1) {
-    DAR_DArray line = {0};
-    TRY(DAR_create_from_cstr(&line, line_raw));
-    TRY(DAR_push_back(lines, &line));
-  }
-
-  fclose(file_ptr);
-  free(line_raw);
-
-  return OK;
-}
-
-static STAT_Val destroy_lines(DAR_DArray * lines) {
-  CHECK(lines != NULL);
-
-  for(DAR_DArray * p = DAR_first(lines); p != DAR_end(lines); p++) { TRY(DAR_destroy(p)); }
-
-  TRY(DAR_destroy(lines));
-
-  return OK;
-}
-
-int main(void) {
-
-  DAR_DArray lines = {0};
-  TRY(DAR_create(&lines, sizeof(DAR_DArray)));
-
-  TRY(read_lines_from_file("input.txt", &lines));
+  LineReader reader = {0};
+  begin_phase(&metrics, PHASE_READ);
+  TRY(open_line_reader(filename, &reader));
+  end_phase(&metrics);
 
   int sum_of_possible_ids = 0;
   int sum_of_powers       = 0;
-  for(DAR_DArray * line = DAR_first(&lines); line != DAR_end(&lines); line++) {
+
+  SPN_Span line    = {0};
+  STAT_Val read_st = OK;
+  begin_phase(&metrics, PHASE_READ);
+  while((read_st = read_next_line(&reader, &line)) == OK) {
+    end_phase(&metrics);
+
+    begin_phase(&metrics, PHASE_PARSE);
     GameResult res = {0};
-    TRY(get_game_result_from_line(DAR_to_span(line), &res));
+    TRY(scan_game_result_from_line(line, &res));
+    end_phase(&metrics);
+
+    begin_phase(&metrics, PHASE_PART1);
     if(res.min_color_occurrences[RED] <= 12 && res.min_color_occurrences[GREEN] <= 13 &&
        res.min_color_occurrences[BLUE] <= 14) {
       sum_of_possible_ids += res.game_id;
     }
+    end_phase(&metrics);
+
+    begin_phase(&metrics, PHASE_PART2);
     sum_of_powers +=
         (res.min_color_occurrences[RED] * res.min_color_occurrences[GREEN] * res.min_color_occurrences[BLUE]);
+    end_phase(&metrics);
+
+    begin_phase(&metrics, PHASE_READ);
   }
+  end_phase(&metrics);
+  TRY(read_st);
+
+  TRY(close_line_reader(&reader));
 
-  TRY(destroy_lines(&lines));
+  TRY(write_metrics(&metrics));
 
   return LOG_STAT(STAT_OK, "sum_of_possible_ids: %d, sum_of_powers: %d", sum_of_possible_ids, sum_of_powers);
-}
+}
\ No newline at end of file
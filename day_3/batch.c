@@ -0,0 +1,63 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cfac/darray.h>
+#include <cfac/log.h>
+#include <cfac/stat.h>
+
+#include "common.h"
+#include "driver.h"
+#include "input.h"
+#include "lib.h"
+
+static STAT_Val solve_input(const InputFile * input, char * result, size_t result_size) {
+  const SPN_Span schematic = DAR_to_span(&input->lines);
+
+  DAR_DArray numbers = {0};
+  DAR_DArray ratios  = {0};
+  TRY(DAR_create(&numbers, sizeof(int)));
+  TRY(DAR_create(&ratios, sizeof(int)));
+
+  TRY(get_numbers_from_schematic_with_bitmaps(schematic, &numbers));
+  TRY(get_gear_ratios_from_schematic(schematic, &ratios));
+
+  int sum_of_numbers = 0;
+  for(int * p = DAR_first(&numbers); p != DAR_end(&numbers); p++) { sum_of_numbers += *p; }
+
+  int sum_of_ratios = 0;
+  for(int * p = DAR_first(&ratios); p != DAR_end(&ratios); p++) { sum_of_ratios += *p; }
+
+  TRY(DAR_destroy(&ratios));
+  TRY(DAR_destroy(&numbers));
+
+  snprintf(result, result_size, "sum_of_numbers: %d, sum_of_ratios: %d", sum_of_numbers, sum_of_ratios);
+
+  return OK;
+}
+
+static STAT_Val solve_file(const char * filename, char * result, size_t result_size) {
+  InputFile input = {0};
+  TRY(map_input_file(filename, &input));
+
+  // the mapping is released whether or not the input could be solved
+  const STAT_Val solve_st = solve_input(&input, result, result_size);
+  TRY(destroy_input_file(&input));
+  TRY(solve_st);
+
+  return OK;
+}
+
+int main(int argc, char ** argv) {
+  BatchConfig config = {0};
+  TRY(parse_batch_args(argc, argv, &config));
+
+  size_t num_failed = 0;
+  TRY(run_batch(&config, solve_file, &num_failed));
+
+  const size_t num_files = config.input_filenames.size;
+  TRY(destroy_batch_config(&config));
+
+  if(num_failed > 0) return LOG_STAT(STAT_ERR_INTERNAL, "failed to solve %zu of %zu files", num_failed, num_files);
+
+  return OK;
+}
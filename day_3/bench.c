@@ -0,0 +1,150 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <cfac/darray.h>
+#include <cfac/log.h>
+#include <cfac/stat.h>
+
+#include "benchmark.h"
+#include "common.h"
+#include "input.h"
+#include "lib.h"
+
+typedef struct Context {
+  const char *   filename;
+  InputFile      input;
+  DAR_DArray     numbers; // contains int
+  DAR_DArray     ratios;  // contains int
+  int64_t        sum_of_numbers;
+  int64_t        sum_of_ratios;
+  size_t         num_threads; // one per cpu
+  SchematicIndex index;
+  size_t         num_adjacent_numbers; // over all cells
+} Context;
+
+static STAT_Val parse(void * p) {
+  Context * ctx = p;
+  TRY(map_input_file(ctx->filename, &ctx->input));
+  return OK;
+}
+
+static STAT_Val unparse(void * p) {
+  Context * ctx = p;
+  TRY(destroy_input_file(&ctx->input));
+  TRY(DAR_clear(&ctx->numbers));
+  TRY(DAR_clear(&ctx->ratios));
+  return OK;
+}
+
+static STAT_Val solve(void * p) {
+  Context * ctx = p;
+
+  const SPN_Span schematic = DAR_to_span(&ctx->input.lines);
+
+  TRY(get_numbers_from_schematic(schematic, &ctx->numbers));
+  TRY(get_gear_ratios_from_schematic(schematic, &ctx->ratios));
+
+  return OK;
+}
+
+static STAT_Val solve_part1(void * p) {
+  Context * ctx = p;
+  TRY(get_numbers_from_schematic(DAR_to_span(&ctx->input.lines), &ctx->numbers));
+  return OK;
+}
+
+static STAT_Val solve_part1_with_bitmaps(void * p) {
+  Context * ctx = p;
+  TRY(get_numbers_from_schematic_with_bitmaps(DAR_to_span(&ctx->input.lines), &ctx->numbers));
+  return OK;
+}
+
+static STAT_Val solve_streaming(void * p) {
+  Context * ctx = p;
+
+  SchematicStream stream = {0};
+  TRY(create_schematic_stream(&stream));
+  for(const SPN_Span * line = DAR_first(&ctx->input.lines); line != DAR_end(&ctx->input.lines); line++) {
+    TRY(push_schematic_row(&stream, *line));
+  }
+  TRY(finish_schematic_stream(&stream));
+
+  ctx->sum_of_numbers = stream.sum_of_numbers;
+  ctx->sum_of_ratios  = stream.sum_of_ratios;
+  TRY(destroy_schematic_stream(&stream));
+
+  return OK;
+}
+
+static STAT_Val solve_in_stripes(void * p) {
+  Context * ctx = p;
+  TRY(solve_schematic_in_stripes(
+      DAR_to_span(&ctx->input.lines), ctx->num_threads, &ctx->sum_of_numbers, &ctx->sum_of_ratios));
+  return OK;
+}
+
+static STAT_Val parse_and_build_index(void * p) {
+  Context * ctx = p;
+  TRY(parse(ctx));
+  TRY(build_schematic_index(DAR_to_span(&ctx->input.lines), &ctx->index));
+  return OK;
+}
+
+static STAT_Val build_index(void * p) {
+  Context * ctx = p;
+  TRY(build_schematic_index(DAR_to_span(&ctx->input.lines), &ctx->index));
+  return OK;
+}
+
+static STAT_Val unbuild_index(void * p) {
+  Context * ctx = p;
+  TRY(destroy_schematic_index(&ctx->index));
+  TRY(unparse(ctx));
+  return OK;
+}
+
+// which numbers touch each cell of the schematic
+static STAT_Val query_index(void * p) {
+  Context * ctx = p;
+
+  ctx->num_adjacent_numbers = 0;
+  for(size_t y = 0; y < ctx->index.height; y++) {
+    for(size_t x = 0; x < ctx->index.width; x++) {
+      uint32_t ids[MAX_ADJACENT_NUMBERS] = {0};
+      size_t   num_ids                   = 0;
+      TRY(get_adjacent_number_ids(&ctx->index, x, y, ids, &num_ids));
+      ctx->num_adjacent_numbers += num_ids;
+    }
+  }
+
+  return OK;
+}
+
+int main(int argc, char ** argv) {
+  BenchConfig config = {0};
+  TRY(parse_bench_args(argc, argv, &config));
+
+  const long num_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+  Context    ctx      = {.filename = config.input_filename, .num_threads = (num_cpus > 0) ? (size_t)num_cpus : 1};
+  TRY(DAR_create(&ctx.numbers, sizeof(int)));
+  TRY(DAR_create(&ctx.ratios, sizeof(int)));
+
+  const BenchPhase phases[] = {
+      {.name = "parse", .run = parse, .teardown = unparse},
+      {.name = "solve", .setup = parse, .run = solve, .teardown = unparse},
+      {.name = "solve_part1", .setup = parse, .run = solve_part1, .teardown = unparse},
+      {.name = "solve_part1_with_bitmaps", .setup = parse, .run = solve_part1_with_bitmaps, .teardown = unparse},
+      {.name = "solve_streaming", .setup = parse, .run = solve_streaming, .teardown = unparse},
+      {.name = "solve_in_stripes", .setup = parse, .run = solve_in_stripes, .teardown = unparse},
+      {.name = "build_index", .setup = parse, .run = build_index, .teardown = unbuild_index},
+      {.name = "query_index", .setup = parse_and_build_index, .run = query_index, .teardown = unbuild_index},
+  };
+
+  TRY(run_bench(&config, "day_3", phases, sizeof(phases) / sizeof(phases[0]), &ctx));
+
+  TRY(DAR_destroy(&ctx.numbers));
+  TRY(DAR_destroy(&ctx.ratios));
+
+  return OK;
+}
@@ -0,0 +1,56 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cfac/log.h>
+#include <cfac/stat.h>
+
+#include "common.h"
+#include "generator.h"
+
+// writes a width x height schematic, roughly one in seven cells starts a number and one in thirty cells is a symbol
+
+static const char symbols[] = "*#+$/@=%&-";
+
+int main(int argc, char ** argv) {
+  GeneratorConfig config = {.seed = 1, .sizes = {140, 140}};
+  TRY(parse_generator_args(argc, argv, "[width [height]]", 2, &config));
+
+  const size_t width  = config.sizes[0];
+  const size_t height = config.sizes[1];
+
+  Rng rng = {0};
+  seed_rng(&rng, config.seed);
+
+  FILE * file = NULL;
+  TRY(open_generator_output(&config, &file));
+
+  for(size_t y = 0; y < height; y++) {
+    size_t x = 0;
+    while(x < width) {
+      const size_t roll = get_random_below(&rng, 210);
+
+      if(roll < 30 && (x + 1) < width) {
+        // numbers are followed by a non-digit (or the end of the line), so neighbouring numbers don't merge
+        const size_t num_digits = get_random_in_range(&rng, 1, 3);
+        for(size_t i = 0; i < num_digits && x < width; i++, x++) {
+          fputc((i == 0 ? '1' : '0') + (int)get_random_below(&rng, (i == 0) ? 9 : 10), file);
+        }
+        if(x < width) {
+          fputc('.', file);
+          x++;
+        }
+      } else if(roll < 37) {
+        fputc(symbols[get_random_below(&rng, sizeof(symbols) - 1)], file);
+        x++;
+      } else {
+        fputc('.', file);
+        x++;
+      }
+    }
+    fputc('\n', file);
+  }
+
+  TRY(close_generator_output(file));
+
+  return OK;
+}
@@ -0,0 +1,38 @@
+#ifndef generator_h
+#define generator_h
+
+#include <cfac/stat.h>
+
+#include <stdint.h>
+#include <stdio.h>
+
+typedef struct Rng {
+  uint64_t state;
+} Rng;
+
+void seed_rng(Rng * rng, uint64_t seed);
+
+uint64_t get_random(Rng * rng);
+
+size_t get_random_below(Rng * rng, size_t bound); // bound must be non-zero
+
+static inline size_t get_random_in_range(Rng * rng, size_t min, size_t max) { // inclusive on both ends
+  return min + get_random_below(rng, (max - min) + 1);
+}
+
+#define GENERATOR_MAX_NUM_SIZES 3
+
+typedef struct GeneratorConfig {
+  uint64_t     seed;
+  const char * output_filename; // NULL writes to stdout
+  size_t       sizes[GENERATOR_MAX_NUM_SIZES];
+} GeneratorConfig;
+
+// usage: generate [-s seed] [-o output] [size...], sizes that are not given keep the value they already had in config
+STAT_Val parse_generator_args(int argc, char ** argv, const char * size_names, size_t num_sizes, GeneratorConfig * config);
+
+STAT_Val open_generator_output(const GeneratorConfig * config, FILE ** file);
+
+STAT_Val close_generator_output(FILE * file);
+
+#endif
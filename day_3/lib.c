@@ -3,8 +3,16 @@
 #include "lib.h"
 
 #include "common.h"
+#include "scan.h"
 
-#include <stdio.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HAS_X86_SIMD
+#endif
 
 typedef struct Index {
   int x, y;
@@ -57,7 +65,8 @@ static STAT_Val get_full_number(SPN_Span line, int pos_x, int * number, int * st
 
   while(*end_x < (int)line.len && is_num(*(const char *)SPN_get(line, *end_x))) { (*end_x)++; }
 
-  CHECK(sscanf(SPN_get(line, *start_x), "%d", number) == 1);
+  size_t num_consumed = 0;
+  CHECK(scan_int(SPN_subspan(line, *start_x, *end_x - *start_x), number, &num_consumed) == STAT_OK);
 
   return OK;
 }
@@ -80,7 +89,7 @@ static STAT_Val get_adjacent_numbers(SPN_Span schematic, Index symbol_index, DAR
   for(int y = start_y; y <= end_y; y++) {
     SPN_Span line = *(const SPN_Span *)SPN_get(schematic, y);
 
-    for(int x = start_x; x <= end_x; x++) {
+    for(int x = start_x; x <= end_x && x < (int)line.len; x++) { // the last row may lack its newline
       char c = *(const char *)SPN_get(line, x);
       if(is_num(c)) {
         int number         = 0;
@@ -99,6 +108,25 @@ static STAT_Val get_adjacent_numbers(SPN_Span schematic, Index symbol_index, DAR
   return OK;
 }
 
+// whether any cell around row y, columns start_x to end_x (exclusive), holds a symbol, rows may differ in length
+static bool has_adjacent_symbol(SPN_Span schematic, int y, int start_x, int end_x) {
+  const int start_y = (y > 0) ? (y - 1) : y;
+  const int end_y   = (y + 1 < (int)schematic.len) ? (y + 1) : y;
+
+  for(int adj_y = start_y; adj_y <= end_y; adj_y++) {
+    const SPN_Span line  = *(const SPN_Span *)SPN_get(schematic, adj_y);
+    const char *   cells = line.begin;
+
+    const int first_x = (start_x > 0) ? (start_x - 1) : 0;
+    const int last_x  = (end_x < (int)line.len) ? end_x : ((int)line.len - 1);
+    for(int x = first_x; x <= last_x; x++) {
+      if(is_symbol(cells[x])) return true;
+    }
+  }
+
+  return false;
+}
+
 STAT_Val get_numbers_from_schematic(SPN_Span schematic, DAR_DArray * numbers) {
   CHECK((int)schematic.len > 0);
   CHECK(schematic.element_size == sizeof(SPN_Span));
@@ -108,36 +136,32 @@ STAT_Val get_numbers_from_schematic(SPN_Span schematic, DAR_DArray * numbers) {
 
   LOG_STAT(STAT_OK, "schematic size: %zu,%zu", schematic.len, (*(const SPN_Span *)SPN_first(schematic)).len);
 
-  DAR_DArray symbol_indices = {0};
-  TRY(DAR_create(&symbol_indices, sizeof(Index)));
-
-  DAR_DArray indexed_numbers = {0};
-  TRY(DAR_create(&indexed_numbers, sizeof(IndexedNumber)));
-
-  TRY(get_symbols(schematic, &symbol_indices));
-
-  LOG_STAT(STAT_OK, "found %zu symbols", symbol_indices.size);
+  // every number is met once, at its first digit, and only looks at the cells around itself, so each cell is
+  // looked at a bounded number of times and no number can be found twice
+  for(int y = 0; y < (int)schematic.len; y++) {
+    const SPN_Span line  = *(const SPN_Span *)SPN_get(schematic, y);
+    const char *   cells = line.begin;
+
+    int x = 0;
+    while(x < (int)line.len) {
+      if(!is_num(cells[x])) {
+        x++;
+        continue;
+      }
 
-  for(Index * idx_p = DAR_first(&symbol_indices); idx_p != DAR_end(&symbol_indices); idx_p++) {
-    TRY(get_adjacent_numbers(schematic, *idx_p, &indexed_numbers));
-  }
+      const int start_x = x;
+      while(x < (int)line.len && is_num(cells[x])) x++;
 
-  // find one number for each index
-  for(int y = 0; y < (int)schematic.len; y++) {
-    for(int x = 0; x < (int)(*(const SPN_Span *)SPN_first(schematic)).len; x++) {
-      for(const IndexedNumber * n = DAR_first(&indexed_numbers); n != DAR_end(&indexed_numbers); n++) {
-        if(n->x == x && n->y == y) {
-          TRY(DAR_push_back(numbers, &(n->number)));
-          break;
-        }
+      if(has_adjacent_symbol(schematic, y, start_x, x)) {
+        int    number       = 0;
+        size_t num_consumed = 0;
+        CHECK(scan_int(SPN_subspan(line, start_x, x - start_x), &number, &num_consumed) == STAT_OK);
+        TRY(DAR_push_back(numbers, &number));
       }
     }
   }
 
-  LOG_STAT(STAT_OK, "indexed_numbers.size: %zu, numbers.size: %zu", indexed_numbers.size, numbers->size);
-
-  TRY(DAR_destroy(&symbol_indices));
-  TRY(DAR_destroy(&indexed_numbers));
+  LOG_STAT(STAT_OK, "numbers.size: %zu", numbers->size);
 
   return OK;
 }
@@ -185,4 +209,488 @@ STAT_Val get_gear_ratios_from_schematic(SPN_Span schematic, DAR_DArray * ratios)
   TRY(DAR_destroy(&asterisk_indices));
 
   return OK;
-}
\ No newline at end of file
+}
+
+#define WORD_BITS 64
+
+// bitmasks of the digits and the symbols in 64 cells, bit i is cell i
+#ifdef HAS_X86_SIMD
+static void get_block_masks(const char * block, uint64_t * digits, uint64_t * symbols) {
+  const __m128i zero    = _mm_set1_epi8('0');
+  const __m128i nine    = _mm_set1_epi8(9);
+  const __m128i dot     = _mm_set1_epi8('.');
+  const __m128i newline = _mm_set1_epi8('\n');
+
+  uint64_t others = 0; // digits, dots and newlines, i.e. everything but symbols
+  *digits         = 0;
+  for(size_t i = 0; i < WORD_BITS; i += 16) {
+    const __m128i bytes  = _mm_loadu_si128((const __m128i *)&block[i]);
+    const __m128i offset = _mm_sub_epi8(bytes, zero); // a digit iff 0 <= offset <= 9, unsigned
+    const __m128i digit  = _mm_cmpeq_epi8(_mm_min_epu8(offset, nine), offset);
+    const __m128i blank  = _mm_or_si128(_mm_cmpeq_epi8(bytes, dot), _mm_cmpeq_epi8(bytes, newline));
+
+    *digits |= (uint64_t)(uint16_t)_mm_movemask_epi8(digit) << i;
+    others |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_or_si128(digit, blank)) << i;
+  }
+
+  *symbols = ~others;
+}
+#else
+static void get_block_masks(const char * block, uint64_t * digits, uint64_t * symbols) {
+  *digits  = 0;
+  *symbols = 0;
+  for(size_t i = 0; i < WORD_BITS; i++) {
+    if(is_num(block[i])) *digits |= (uint64_t)1 << i;
+    if(is_symbol(block[i])) *symbols |= (uint64_t)1 << i;
+  }
+}
+#endif
+
+static void get_row_masks(SPN_Span line, size_t num_words, uint64_t * digits, uint64_t * symbols) {
+  const char * cells = line.begin;
+
+  char tail[WORD_BITS] = {0}; // the last partial block is copied here, padded with cells that are neither
+
+  for(size_t w = 0; w < num_words; w++) {
+    const size_t begin = w * WORD_BITS;
+    const char * block = &cells[begin];
+    if(begin + WORD_BITS > line.len) {
+      memset(tail, '.', sizeof(tail));
+      if(begin < line.len) memcpy(tail, block, line.len - begin);
+      block = tail;
+    }
+
+    get_block_masks(block, &digits[w], &symbols[w]);
+  }
+}
+
+// bits set in word w of a row mask, or next to a set bit, which may be in the neighbouring word
+static inline uint64_t spread_horizontally(const uint64_t * mask, size_t w, size_t num_words) {
+  const uint64_t from_left  = (mask[w] << 1) | ((w > 0) ? (mask[w - 1] >> (WORD_BITS - 1)) : 0);
+  const uint64_t from_right = (mask[w] >> 1) | ((w + 1 < num_words) ? (mask[w + 1] << (WORD_BITS - 1)) : 0);
+  return mask[w] | from_left | from_right;
+}
+
+STAT_Val get_numbers_from_schematic_with_bitmaps(SPN_Span schematic, DAR_DArray * numbers) {
+  CHECK((int)schematic.len > 0);
+  CHECK(schematic.element_size == sizeof(SPN_Span));
+  CHECK(numbers != NULL);
+  CHECK(DAR_is_initialized(numbers));
+  CHECK(numbers->element_size == sizeof(int));
+
+  const size_t height = schematic.len;
+
+  size_t width = 0;
+  for(const SPN_Span * line = SPN_first(schematic); line != SPN_end(schematic); line++) {
+    if(line->len > width) width = line->len;
+  }
+  const size_t num_words = (width + WORD_BITS - 1) / WORD_BITS;
+  if(num_words == 0) return OK;
+
+  DAR_DArray digits  = {0}; // uint64_t, num_words per row
+  DAR_DArray symbols = {0}; // uint64_t, num_words per row, spread horizontally once built
+  DAR_DArray parts   = {0}; // uint64_t, num_words of the current row
+  TRY(DAR_create(&digits, sizeof(uint64_t)));
+  TRY(DAR_create(&symbols, sizeof(uint64_t)));
+  TRY(DAR_create(&parts, sizeof(uint64_t)));
+  TRY(DAR_resize_zeroed(&digits, height * num_words));
+  TRY(DAR_resize_zeroed(&symbols, height * num_words));
+  TRY(DAR_resize_zeroed(&parts, num_words));
+
+  uint64_t * row_digits  = digits.data;
+  uint64_t * row_symbols = symbols.data;
+  uint64_t * row_parts   = parts.data;
+
+  for(size_t y = 0; y < height; y++) {
+    uint64_t * symbol_row = &row_symbols[y * num_words];
+    get_row_masks(*(const SPN_Span *)SPN_get(schematic, y), num_words, &row_digits[y * num_words], symbol_row);
+
+    // the spread words are kept in parts until the whole row is done, as each one needs its original neighbours
+    for(size_t w = 0; w < num_words; w++) row_parts[w] = spread_horizontally(symbol_row, w, num_words);
+    memcpy(symbol_row, row_parts, num_words * sizeof(uint64_t));
+  }
+
+  for(size_t y = 0; y < height; y++) {
+    const uint64_t * digit_row = &row_digits[y * num_words];
+    const uint64_t * above     = (y > 0) ? &row_symbols[(y - 1) * num_words] : NULL;
+    const uint64_t * below     = (y + 1 < height) ? &row_symbols[(y + 1) * num_words] : NULL;
+
+    // digits in reach of a symbol
+    for(size_t w = 0; w < num_words; w++) {
+      uint64_t reach = row_symbols[(y * num_words) + w];
+      if(above != NULL) reach |= above[w];
+      if(below != NULL) reach |= below[w];
+      row_parts[w] = reach & digit_row[w];
+    }
+
+    // grown along the digits until they cover their whole numbers, which takes at most as many rounds as the
+    // longest number has digits
+    bool has_grown = true;
+    while(has_grown) {
+      has_grown = false;
+      for(size_t w = 0; w < num_words; w++) {
+        const uint64_t grown = spread_horizontally(row_parts, w, num_words) & digit_row[w];
+        has_grown |= (grown != row_parts[w]);
+        row_parts[w] = grown;
+      }
+    }
+
+    // and read off at the first digit of each run
+    const SPN_Span line = *(const SPN_Span *)SPN_get(schematic, y);
+    for(size_t w = 0; w < num_words; w++) {
+      const uint64_t before = (row_parts[w] << 1) | ((w > 0) ? (row_parts[w - 1] >> (WORD_BITS - 1)) : 0);
+      uint64_t       starts = row_parts[w] & ~before;
+
+      while(starts != 0) {
+        const size_t x = (w * WORD_BITS) + (size_t)__builtin_ctzll(starts);
+        starts &= starts - 1;
+
+        int    number       = 0;
+        size_t num_consumed = 0;
+        CHECK(scan_int(SPN_subspan(line, x, line.len - x), &number, &num_consumed) == STAT_OK);
+        TRY(DAR_push_back(numbers, &number));
+      }
+    }
+  }
+
+  TRY(DAR_destroy(&digits));
+  TRY(DAR_destroy(&symbols));
+  TRY(DAR_destroy(&parts));
+
+  return OK;
+}
+
+STAT_Val create_schematic_stream(SchematicStream * stream) {
+  CHECK(stream != NULL);
+
+  *stream = (SchematicStream){0};
+
+  for(size_t i = 0; i < 3; i++) TRY(DAR_create(&stream->rows[i], sizeof(char)));
+  TRY(DAR_create(&stream->gear_numbers, sizeof(IndexedNumber)));
+
+  return OK;
+}
+
+STAT_Val destroy_schematic_stream(SchematicStream * stream) {
+  CHECK(stream != NULL);
+
+  for(size_t i = 0; i < 3; i++) TRY(DAR_destroy(&stream->rows[i]));
+  TRY(DAR_destroy(&stream->gear_numbers));
+
+  *stream = (SchematicStream){0};
+
+  return OK;
+}
+
+// adds the part numbers and gear ratios of row y, which may look at the rows around it but counts nothing in them
+static STAT_Val sum_schematic_row(SPN_Span     schematic,
+                                  int          y,
+                                  DAR_DArray * gear_numbers,
+                                  int64_t *    sum_of_numbers,
+                                  int64_t *    sum_of_ratios) {
+  const SPN_Span line  = *(const SPN_Span *)SPN_get(schematic, y);
+  const char *   cells = line.begin;
+
+  int x = 0;
+  while(x < (int)line.len) {
+    if(cells[x] == '*') {
+      TRY(DAR_clear(gear_numbers));
+      TRY(get_adjacent_numbers(schematic, (Index){x, y}, gear_numbers));
+      if(gear_numbers->size == 2) {
+        const int a = ((IndexedNumber *)DAR_first(gear_numbers))->number;
+        const int b = ((IndexedNumber *)DAR_last(gear_numbers))->number;
+        *sum_of_ratios += (int64_t)a * b;
+      }
+    }
+
+    if(!is_num(cells[x])) {
+      x++;
+      continue;
+    }
+
+    const int start_x = x;
+    while(x < (int)line.len && is_num(cells[x])) x++;
+
+    if(has_adjacent_symbol(schematic, y, start_x, x)) {
+      int    number       = 0;
+      size_t num_consumed = 0;
+      CHECK(scan_int(SPN_subspan(line, start_x, x - start_x), &number, &num_consumed) == STAT_OK);
+      *sum_of_numbers += number;
+    }
+  }
+
+  return OK;
+}
+
+// adds the numbers and gear ratios of the row before the last one fed, or of the last one if has_next is false
+static STAT_Val finish_schematic_row(SchematicStream * stream, bool has_next) {
+  const size_t row_idx = stream->num_rows - (has_next ? 2 : 1);
+
+  // the row with its neighbours, as a schematic of its own
+  SPN_Span window[3] = {0};
+  size_t   num_rows  = 0;
+  if(row_idx > 0) window[num_rows++] = DAR_to_span(&stream->rows[(row_idx - 1) % 3]);
+  const int y        = (int)num_rows;
+  window[num_rows++] = DAR_to_span(&stream->rows[row_idx % 3]);
+  if(has_next) window[num_rows++] = DAR_to_span(&stream->rows[(row_idx + 1) % 3]);
+
+  const SPN_Span schematic = {.begin = window, .element_size = sizeof(SPN_Span), .len = num_rows};
+  TRY(sum_schematic_row(schematic, y, &stream->gear_numbers, &stream->sum_of_numbers, &stream->sum_of_ratios));
+
+  return OK;
+}
+
+STAT_Val push_schematic_row(SchematicStream * stream, SPN_Span row) {
+  CHECK(stream != NULL);
+  CHECK(row.element_size == sizeof(char));
+
+  DAR_DArray * slot = &stream->rows[stream->num_rows % 3];
+  TRY(DAR_clear(slot));
+  TRY(DAR_push_back_array(slot, row.begin, row.len));
+  stream->num_rows++;
+
+  if(stream->num_rows >= 2) TRY(finish_schematic_row(stream, true));
+
+  return OK;
+}
+
+STAT_Val finish_schematic_stream(SchematicStream * stream) {
+  CHECK(stream != NULL);
+
+  if(stream->num_rows >= 1) TRY(finish_schematic_row(stream, false));
+
+  return OK;
+}
+
+typedef struct Stripe {
+  SPN_Span   schematic;    // the rows of the stripe, with the halo rows around it
+  int        first_y;      // of the rows that belong to the stripe, within schematic
+  int        end_y;
+  DAR_DArray gear_numbers; // IndexedNumber
+  int64_t    sum_of_numbers;
+  int64_t    sum_of_ratios;
+  STAT_Val   status;
+} Stripe;
+
+static void * solve_stripe(void * p) {
+  Stripe * stripe = p;
+
+  stripe->status = OK;
+  for(int y = stripe->first_y; y < stripe->end_y && STAT_is_OK(stripe->status); y++) {
+    stripe->status =
+        sum_schematic_row(stripe->schematic, y, &stripe->gear_numbers, &stripe->sum_of_numbers, &stripe->sum_of_ratios);
+  }
+
+  return NULL;
+}
+
+STAT_Val solve_schematic_in_stripes(SPN_Span  schematic,
+                                    size_t    num_threads,
+                                    int64_t * sum_of_numbers,
+                                    int64_t * sum_of_ratios) {
+  CHECK(schematic.element_size == sizeof(SPN_Span));
+  CHECK(num_threads > 0);
+  CHECK(sum_of_numbers != NULL);
+  CHECK(sum_of_ratios != NULL);
+
+  *sum_of_numbers = 0;
+  *sum_of_ratios  = 0;
+
+  const size_t height      = schematic.len;
+  const size_t num_stripes = (num_threads < height) ? num_threads : height;
+  if(num_stripes == 0) return OK;
+
+  DAR_DArray stripes = {0};
+  DAR_DArray threads = {0};
+  TRY(DAR_create(&stripes, sizeof(Stripe)));
+  TRY(DAR_create(&threads, sizeof(pthread_t)));
+  TRY(DAR_resize_zeroed(&stripes, num_stripes));
+  TRY(DAR_resize_zeroed(&threads, num_stripes));
+
+  // rows are split as evenly as possible, each stripe sees one more row on either side, but only counts the numbers
+  // and gears that start in its own rows, so one that touches another stripe is still counted exactly once
+  for(size_t i = 0; i < num_stripes; i++) {
+    Stripe *     stripe     = DAR_get(&stripes, i);
+    const size_t begin      = (height * i) / num_stripes;
+    const size_t end        = (height * (i + 1)) / num_stripes;
+    const size_t halo_begin = (begin > 0) ? (begin - 1) : begin;
+    const size_t halo_end   = (end < height) ? (end + 1) : end;
+
+    stripe->schematic = SPN_subspan(schematic, halo_begin, halo_end - halo_begin);
+    stripe->first_y   = (int)(begin - halo_begin);
+    stripe->end_y     = (int)(end - halo_begin);
+    TRY(DAR_create(&stripe->gear_numbers, sizeof(IndexedNumber)));
+  }
+
+  // the calling thread takes the first stripe itself, if a thread cannot be created the ones already running are
+  // still joined below, since they write into stripes
+  STAT_Val solve_st    = OK;
+  size_t   num_started = 1;
+  for(; num_started < num_stripes; num_started++) {
+    const int create_res =
+        pthread_create(DAR_get(&threads, num_started), NULL, solve_stripe, DAR_get(&stripes, num_started));
+    if(create_res != 0) {
+      solve_st = LOG_STAT(STAT_ERR_INTERNAL, "failed to create thread: %s", strerror(create_res));
+      break;
+    }
+  }
+  if(STAT_is_OK(solve_st)) solve_stripe(DAR_first(&stripes));
+  for(size_t i = 1; i < num_started; i++) {
+    if(pthread_join(*(pthread_t *)DAR_get(&threads, i), NULL) != 0 && STAT_is_OK(solve_st)) {
+      solve_st = LOG_STAT(STAT_ERR_INTERNAL, "failed to join thread");
+    }
+  }
+
+  // every stripe is cleaned up, the first error is kept and returned after
+  for(Stripe * stripe = DAR_first(&stripes); stripe != DAR_end(&stripes); stripe++) {
+    if(STAT_is_OK(solve_st)) solve_st = stripe->status;
+    *sum_of_numbers += stripe->sum_of_numbers;
+    *sum_of_ratios += stripe->sum_of_ratios;
+    TRY(DAR_destroy(&stripe->gear_numbers));
+  }
+
+  TRY(DAR_destroy(&stripes));
+  TRY(DAR_destroy(&threads));
+
+  TRY(solve_st);
+
+  return OK;
+}
+
+static void collect_adjacent_number_ids(const uint32_t * number_ids,
+                                        size_t           width,
+                                        size_t           height,
+                                        size_t           x,
+                                        size_t           y,
+                                        uint32_t         ids[MAX_ADJACENT_NUMBERS],
+                                        size_t *         num_ids) {
+  *num_ids = 0;
+
+  const size_t first_y = (y > 0) ? (y - 1) : y;
+  const size_t last_y  = (y + 1 < height) ? (y + 1) : y;
+  const size_t first_x = (x > 0) ? (x - 1) : x;
+  const size_t last_x  = (x + 1 < width) ? (x + 1) : x;
+
+  for(size_t adj_y = first_y; adj_y <= last_y; adj_y++) {
+    uint32_t previous = 0; // a number spans consecutive cells of a row, and is only taken once
+    for(size_t adj_x = first_x; adj_x <= last_x; adj_x++) {
+      const uint32_t id = number_ids[(adj_y * width) + adj_x];
+      if(id != 0 && id != previous) ids[(*num_ids)++] = id;
+      previous = id;
+    }
+  }
+}
+
+STAT_Val build_schematic_index(SPN_Span schematic, SchematicIndex * index) {
+  CHECK(schematic.element_size == sizeof(SPN_Span));
+  CHECK(index != NULL);
+
+  *index = (SchematicIndex){.height = schematic.len};
+
+  for(const SPN_Span * line = SPN_first(schematic); line != SPN_end(schematic); line++) {
+    if(line->len > index->width) index->width = line->len;
+  }
+
+  TRY(DAR_create(&index->number_ids, sizeof(uint32_t)));
+  TRY(DAR_create(&index->numbers, sizeof(int)));
+  TRY(DAR_resize_zeroed(&index->number_ids, index->width * index->height));
+
+  uint32_t * number_ids = index->number_ids.data;
+
+  // label every run of digits
+  for(size_t y = 0; y < index->height; y++) {
+    const SPN_Span line  = *(const SPN_Span *)SPN_get(schematic, y);
+    const char *   cells = line.begin;
+
+    size_t x = 0;
+    while(x < line.len) {
+      if(!is_num(cells[x])) {
+        x++;
+        continue;
+      }
+
+      int    number       = 0;
+      size_t num_consumed = 0;
+      CHECK(scan_int(SPN_subspan(line, x, line.len - x), &number, &num_consumed) == STAT_OK);
+      TRY(DAR_push_back(&index->numbers, &number));
+      CHECK(index->numbers.size <= UINT32_MAX);
+
+      const uint32_t id = (uint32_t)index->numbers.size;
+      for(; num_consumed > 0; num_consumed--, x++) number_ids[(y * index->width) + x] = id;
+    }
+  }
+
+  // then let every symbol mark the numbers around it, and every '*' add up its own gear ratio
+  DAR_DArray is_part = {0}; // bool for each number
+  TRY(DAR_create(&is_part, sizeof(bool)));
+  TRY(DAR_resize_zeroed(&is_part, index->numbers.size));
+
+  const int * numbers = index->numbers.data;
+  bool *      parts   = is_part.data;
+
+  for(size_t y = 0; y < index->height; y++) {
+    const SPN_Span line  = *(const SPN_Span *)SPN_get(schematic, y);
+    const char *   cells = line.begin;
+
+    for(size_t x = 0; x < line.len; x++) {
+      if(!is_symbol(cells[x])) continue;
+
+      uint32_t ids[MAX_ADJACENT_NUMBERS] = {0};
+      size_t   num_ids                   = 0;
+      collect_adjacent_number_ids(number_ids, index->width, index->height, x, y, ids, &num_ids);
+
+      for(size_t i = 0; i < num_ids; i++) parts[ids[i] - 1] = true;
+
+      if(cells[x] != '*') continue;
+      index->num_gears[num_ids]++;
+      if(num_ids == 0) continue; // no numbers, so no ratio either
+
+      int64_t * sum   = &index->sum_of_gear_ratios[num_ids];
+      int64_t   ratio = 1;
+      bool      fits  = true;
+      for(size_t i = 0; i < num_ids; i++) fits &= !__builtin_mul_overflow(ratio, numbers[ids[i] - 1], &ratio);
+      fits = fits && !__builtin_add_overflow(*sum, ratio, sum);
+
+      if(!fits) {
+        TRY(DAR_destroy(&is_part));
+        TRY(destroy_schematic_index(index));
+        return LOG_STAT(STAT_ERR_READ, "gear ratios at %zu,%zu do not fit in 64 bits", x, y);
+      }
+    }
+  }
+
+  for(size_t i = 0; i < index->numbers.size; i++) {
+    if(parts[i]) index->sum_of_part_numbers += numbers[i];
+  }
+
+  TRY(DAR_destroy(&is_part));
+
+  return OK;
+}
+
+STAT_Val destroy_schematic_index(SchematicIndex * index) {
+  CHECK(index != NULL);
+
+  TRY(DAR_destroy(&index->number_ids));
+  TRY(DAR_destroy(&index->numbers));
+
+  *index = (SchematicIndex){0};
+
+  return OK;
+}
+
+STAT_Val get_adjacent_number_ids(const SchematicIndex * index,
+                                 size_t                 x,
+                                 size_t                 y,
+                                 uint32_t               ids[MAX_ADJACENT_NUMBERS],
+                                 size_t *               num_ids) {
+  CHECK(index != NULL);
+  CHECK(x < index->width);
+  CHECK(y < index->height);
+  CHECK(ids != NULL);
+  CHECK(num_ids != NULL);
+
+  collect_adjacent_number_ids(index->number_ids.data, index->width, index->height, x, y, ids, num_ids);
+
+  return OK;
+}
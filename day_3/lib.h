@@ -5,7 +5,65 @@
 #include <cfac/span.h>
 #include <cfac/stat.h>
 
+#include <stdint.h>
+
 STAT_Val get_numbers_from_schematic(SPN_Span schematic, DAR_DArray * numbers);
+
+// same numbers, found 64 cells at a time: each row gets a bitmap of its digits and of its symbols, the symbol bitmaps
+// are dilated by one cell in all directions with shifts and ORs, and digits under the dilated symbols are grown
+// along their digit runs, after which every run that is left is a part number
+STAT_Val get_numbers_from_schematic_with_bitmaps(SPN_Span schematic, DAR_DArray * numbers);
 STAT_Val get_gear_ratios_from_schematic(SPN_Span schematic, DAR_DArray * ratios);
 
+// part numbers and gear ratios of a schematic that is fed one row at a time, as a row only touches the rows directly
+// above and below it, only the last three rows are kept and memory does not grow with the number of rows
+typedef struct SchematicStream {
+  DAR_DArray rows[3];        // char, row i is kept in rows[i % 3]
+  size_t     num_rows;       // fed so far, all but the last one are done
+  DAR_DArray gear_numbers;   // scratch for the numbers around one gear
+  int64_t    sum_of_numbers; // of the rows that are done
+  int64_t    sum_of_ratios;
+} SchematicStream;
+
+STAT_Val create_schematic_stream(SchematicStream * stream);
+STAT_Val destroy_schematic_stream(SchematicStream * stream);
+
+// row is copied, so it only has to stay valid during the call, which finishes the row before it
+STAT_Val push_schematic_row(SchematicStream * stream, SPN_Span row);
+
+// finishes the last row, after which the sums cover the whole schematic
+STAT_Val finish_schematic_stream(SchematicStream * stream);
+
+// both sums of the whole schematic, solved on num_threads threads that each take a stripe of consecutive rows
+STAT_Val solve_schematic_in_stripes(SPN_Span  schematic,
+                                    size_t    num_threads,
+                                    int64_t * sum_of_numbers,
+                                    int64_t * sum_of_ratios);
+
+// a cell touches at most two numbers above and below it and one on either side
+#define MAX_ADJACENT_NUMBERS 6
+
+// every digit cell labelled with the number it belongs to, so a query never has to read digits again
+typedef struct SchematicIndex {
+  size_t     width;      // of the longest row, shorter rows are padded with cells without a number
+  size_t     height;
+  DAR_DArray number_ids; // uint32_t for each cell, row by row, 0 for no number, otherwise 1 + index into numbers
+  DAR_DArray numbers;    // int, in the order they start in
+
+  int64_t sum_of_part_numbers;                          // numbers touching any symbol
+  int64_t sum_of_gear_ratios[MAX_ADJACENT_NUMBERS + 1]; // [k]: products of the numbers of each '*' touching k of them,
+                                                        // [0] stays 0 since a '*' without numbers has no ratio
+  size_t  num_gears[MAX_ADJACENT_NUMBERS + 1];          // [k]: '*' touching exactly k numbers
+} SchematicIndex;
+
+STAT_Val build_schematic_index(SPN_Span schematic, SchematicIndex * index);
+STAT_Val destroy_schematic_index(SchematicIndex * index);
+
+// ids of the distinct numbers touching cell (x, y), the numbers themselves are numbers[id - 1]
+STAT_Val get_adjacent_number_ids(const SchematicIndex * index,
+                                 size_t                 x,
+                                 size_t                 y,
+                                 uint32_t               ids[MAX_ADJACENT_NUMBERS],
+                                 size_t *               num_ids);
+
 #endif
\ No newline at end of file
@@ -84,6 +84,84 @@ static Result tst_get_numbers_from_schematic(void) {
   return r;
 }
 
+static Result tst_get_numbers_from_schematic_counts_each_number_once(void) {
+  Result r = PASS;
+
+  DAR_DArray schematic_arr = {0};
+  EXPECT_OK(&r, DAR_create(&schematic_arr, sizeof(SPN_Span)));
+
+  {
+    // 77 touches three symbols, 5 and 6 are at the edges, the last row is shorter and has no newline
+    SPN_Span lines[] = {
+        SPN_from_cstr("5#.*.....\n"),
+        SPN_from_cstr("..77%...6\n"),
+        SPN_from_cstr("..$.....&\n"),
+        SPN_from_cstr("9.31"),
+    };
+
+    for(size_t i = 0; i < sizeof(lines) / sizeof(lines[0]); i++) {
+      SPN_Span * line = &lines[i];
+      EXPECT_OK(&r, DAR_push_back(&schematic_arr, line));
+    }
+  }
+
+  DAR_DArray numbers = {0};
+  EXPECT_OK(&r, DAR_create(&numbers, sizeof(int)));
+
+  EXPECT_OK(&r, get_numbers_from_schematic(DAR_to_span(&schematic_arr), &numbers));
+  const int expected[] = {5, 77, 6, 31};
+  EXPECT_EQ(&r, sizeof(expected) / sizeof(expected[0]), numbers.size);
+  if(!HAS_FAILED(&r)) EXPECT_ARREQ(&r, int, expected, DAR_first(&numbers), numbers.size);
+
+  EXPECT_OK(&r, DAR_destroy(&numbers));
+  EXPECT_OK(&r, DAR_destroy(&schematic_arr));
+
+  return r;
+}
+
+static Result tst_get_numbers_from_schematic_with_bitmaps(void) {
+  Result r = PASS;
+
+  // wide enough for numbers and symbols on both sides of word boundaries, and rows of differing lengths
+  enum { HEIGHT = 40, WIDTH = 150 };
+  static char cells[HEIGHT][WIDTH + 1];
+
+  const char alphabet[] = "....................0123456789*#$+/";
+  unsigned   state      = 7;
+  for(size_t y = 0; y < HEIGHT; y++) {
+    for(size_t x = 0; x < WIDTH; x++) {
+      state       = (state * 1103515245u) + 12345u;
+      cells[y][x] = alphabet[(state >> 16) % (sizeof(alphabet) - 1)];
+    }
+    cells[y][WIDTH] = '\n';
+  }
+
+  DAR_DArray schematic_arr = {0};
+  EXPECT_OK(&r, DAR_create(&schematic_arr, sizeof(SPN_Span)));
+  for(size_t y = 0; y < HEIGHT; y++) {
+    const size_t   len  = (y == HEIGHT - 1) ? 100 : (WIDTH + 1);
+    const SPN_Span line = {.begin = cells[y], .element_size = sizeof(char), .len = len};
+    EXPECT_OK(&r, DAR_push_back(&schematic_arr, &line));
+  }
+
+  DAR_DArray expected = {0};
+  DAR_DArray numbers  = {0};
+  EXPECT_OK(&r, DAR_create(&expected, sizeof(int)));
+  EXPECT_OK(&r, DAR_create(&numbers, sizeof(int)));
+
+  EXPECT_OK(&r, get_numbers_from_schematic(DAR_to_span(&schematic_arr), &expected));
+  EXPECT_OK(&r, get_numbers_from_schematic_with_bitmaps(DAR_to_span(&schematic_arr), &numbers));
+  EXPECT_NE(&r, 0, expected.size);
+  EXPECT_EQ(&r, expected.size, numbers.size);
+  if(!HAS_FAILED(&r)) EXPECT_ARREQ(&r, int, DAR_first(&expected), DAR_first(&numbers), numbers.size);
+
+  EXPECT_OK(&r, DAR_destroy(&expected));
+  EXPECT_OK(&r, DAR_destroy(&numbers));
+  EXPECT_OK(&r, DAR_destroy(&schematic_arr));
+
+  return r;
+}
+
 static Result tst_get_gear_ratios_from_schematic(void) {
   Result r = PASS;
 
@@ -154,6 +232,195 @@ static Result tst_get_gear_ratios_from_schematic(void) {
   return r;
 }
 
+static Result tst_schematic_stream(void) {
+  Result r = PASS;
+
+  const char * lines[] = {
+      "467..114..\n",
+      "...*......\n",
+      "..35..633.\n",
+      "......#...\n",
+      "617*......\n",
+      ".....+.58.\n",
+      "..592.....\n",
+      "......755.\n",
+      "...$.*....\n",
+      ".664.598..",
+  };
+
+  SchematicStream stream = {0};
+  EXPECT_OK(&r, create_schematic_stream(&stream));
+
+  // nothing is finished before the row after it is known
+  EXPECT_OK(&r, push_schematic_row(&stream, SPN_from_cstr(lines[0])));
+  EXPECT_EQ(&r, 0, stream.sum_of_numbers);
+  EXPECT_OK(&r, push_schematic_row(&stream, SPN_from_cstr(lines[1])));
+  EXPECT_EQ(&r, 467, stream.sum_of_numbers);
+
+  for(size_t i = 2; i < sizeof(lines) / sizeof(lines[0]); i++) {
+    EXPECT_OK(&r, push_schematic_row(&stream, SPN_from_cstr(lines[i])));
+  }
+  EXPECT_OK(&r, finish_schematic_stream(&stream));
+
+  EXPECT_EQ(&r, 4361, stream.sum_of_numbers);
+  EXPECT_EQ(&r, 467835, stream.sum_of_ratios);
+
+  EXPECT_OK(&r, destroy_schematic_stream(&stream));
+
+  // a single row only has itself to look at
+  EXPECT_OK(&r, create_schematic_stream(&stream));
+  EXPECT_OK(&r, push_schematic_row(&stream, SPN_from_cstr("12*3..4#.5*")));
+  EXPECT_OK(&r, finish_schematic_stream(&stream));
+  EXPECT_EQ(&r, 12 + 3 + 4 + 5, stream.sum_of_numbers);
+  EXPECT_EQ(&r, 12 * 3, stream.sum_of_ratios);
+  EXPECT_OK(&r, destroy_schematic_stream(&stream));
+
+  return r;
+}
+
+static Result tst_solve_schematic_in_stripes(void) {
+  Result r = PASS;
+
+  // numbers and gears that reach across every possible stripe boundary
+  SPN_Span lines[] = {
+      SPN_from_cstr("467..114..\n"),
+      SPN_from_cstr("...*......\n"),
+      SPN_from_cstr("..35..633.\n"),
+      SPN_from_cstr("......#...\n"),
+      SPN_from_cstr("617*......\n"),
+      SPN_from_cstr(".....+.58.\n"),
+      SPN_from_cstr("..592.....\n"),
+      SPN_from_cstr("......755.\n"),
+      SPN_from_cstr("...$.*....\n"),
+      SPN_from_cstr(".664.598.."),
+  };
+  const SPN_Span schematic = {
+      .begin        = lines,
+      .element_size = sizeof(SPN_Span),
+      .len          = sizeof(lines) / sizeof(lines[0]),
+  };
+
+  for(size_t num_threads = 1; num_threads <= 12; num_threads++) {
+    int64_t sum_of_numbers = 0;
+    int64_t sum_of_ratios  = 0;
+    EXPECT_OK(&r, solve_schematic_in_stripes(schematic, num_threads, &sum_of_numbers, &sum_of_ratios));
+    EXPECT_EQ(&r, 4361, sum_of_numbers);
+    EXPECT_EQ(&r, 467835, sum_of_ratios);
+    if(HAS_FAILED(&r)) {
+      printf("num_threads: %zu\n", num_threads);
+      return r;
+    }
+  }
+
+  // a part number that does not fit fails only the last stripe, the others are still joined and cleaned up
+  lines[9] = SPN_from_cstr("999999999999*.");
+  for(size_t num_threads = 1; num_threads <= 4; num_threads++) {
+    int64_t sum_of_numbers = 0;
+    int64_t sum_of_ratios  = 0;
+    EXPECT_NE(&r, STAT_OK, solve_schematic_in_stripes(schematic, num_threads, &sum_of_numbers, &sum_of_ratios));
+  }
+
+  return r;
+}
+
+static Result tst_schematic_index(void) {
+  Result r = PASS;
+
+  SPN_Span lines[] = {
+      SPN_from_cstr("467..114..\n"),
+      SPN_from_cstr("...*......\n"),
+      SPN_from_cstr("..35..633.\n"),
+      SPN_from_cstr("......#...\n"),
+      SPN_from_cstr("617*......\n"),
+      SPN_from_cstr(".....+.58.\n"),
+      SPN_from_cstr("..592.....\n"),
+      SPN_from_cstr("......755.\n"),
+      SPN_from_cstr("...$.*....\n"),
+      SPN_from_cstr(".664.598.."),
+  };
+  const SPN_Span schematic = {
+      .begin        = lines,
+      .element_size = sizeof(SPN_Span),
+      .len          = sizeof(lines) / sizeof(lines[0]),
+  };
+
+  SchematicIndex index = {0};
+  EXPECT_OK(&r, build_schematic_index(schematic, &index));
+  EXPECT_EQ(&r, 11, index.width);
+  EXPECT_EQ(&r, 10, index.height);
+  EXPECT_EQ(&r, 10, index.numbers.size);
+
+  EXPECT_EQ(&r, 4361, index.sum_of_part_numbers);
+  EXPECT_EQ(&r, 2, index.num_gears[2]);
+  EXPECT_EQ(&r, 467835, index.sum_of_gear_ratios[2]);
+  EXPECT_EQ(&r, 1, index.num_gears[1]);
+  EXPECT_EQ(&r, 617, index.sum_of_gear_ratios[1]);
+  EXPECT_EQ(&r, 0, index.num_gears[0]);
+
+  uint32_t ids[MAX_ADJACENT_NUMBERS] = {0};
+  size_t   num_ids                   = 0;
+  const int * numbers                = index.numbers.data;
+
+  EXPECT_OK(&r, get_adjacent_number_ids(&index, 3, 1, ids, &num_ids));
+  EXPECT_EQ(&r, 2, num_ids);
+  if(num_ids == 2) {
+    EXPECT_EQ(&r, 467, numbers[ids[0] - 1]);
+    EXPECT_EQ(&r, 35, numbers[ids[1] - 1]);
+  }
+
+  // a cell in a number is touched by that number too, but only once
+  EXPECT_OK(&r, get_adjacent_number_ids(&index, 1, 0, ids, &num_ids));
+  EXPECT_EQ(&r, 1, num_ids);
+  EXPECT_EQ(&r, 467, numbers[ids[0] - 1]);
+
+  EXPECT_OK(&r, get_adjacent_number_ids(&index, 9, 0, ids, &num_ids));
+  EXPECT_EQ(&r, 0, num_ids);
+
+  EXPECT_NE(&r, STAT_OK, get_adjacent_number_ids(&index, 11, 0, ids, &num_ids));
+
+  EXPECT_OK(&r, destroy_schematic_index(&index));
+
+  // six numbers around one gear
+  SPN_Span crowded_lines[] = {
+      SPN_from_cstr("2.3\n"),
+      SPN_from_cstr("5*7\n"),
+      SPN_from_cstr("1.4"),
+  };
+  const SPN_Span crowded = {.begin = crowded_lines, .element_size = sizeof(SPN_Span), .len = 3};
+
+  EXPECT_OK(&r, build_schematic_index(crowded, &index));
+  EXPECT_EQ(&r, 1, index.num_gears[6]);
+  EXPECT_EQ(&r, 2 * 3 * 5 * 7 * 1 * 4, index.sum_of_gear_ratios[6]);
+  EXPECT_OK(&r, destroy_schematic_index(&index));
+
+  // a '*' without numbers is counted, but has no ratio to add
+  SPN_Span lonely_lines[] = {
+      SPN_from_cstr("...\n"),
+      SPN_from_cstr(".*.\n"),
+      SPN_from_cstr("..."),
+  };
+  const SPN_Span lonely = {.begin = lonely_lines, .element_size = sizeof(SPN_Span), .len = 3};
+
+  EXPECT_OK(&r, build_schematic_index(lonely, &index));
+  EXPECT_EQ(&r, 1, index.num_gears[0]);
+  EXPECT_EQ(&r, 0, index.sum_of_gear_ratios[0]);
+  EXPECT_OK(&r, destroy_schematic_index(&index));
+
+  // each ratio fits, but their sum does not
+  SPN_Span huge_lines[] = {
+      SPN_from_cstr("2147483647*2147483647\n"),
+      SPN_from_cstr(".....................\n"),
+      SPN_from_cstr("2147483647*2147483647\n"),
+      SPN_from_cstr(".....................\n"),
+      SPN_from_cstr("2147483647*2147483647"),
+  };
+  const SPN_Span huge = {.begin = huge_lines, .element_size = sizeof(SPN_Span), .len = 5};
+
+  EXPECT_EQ(&r, STAT_ERR_READ, build_schematic_index(huge, &index));
+
+  return r;
+}
+
 static Result tst_fixture(void * env) {
   Result r = PASS;
 
@@ -165,7 +432,12 @@ static Result tst_fixture(void * env) {
 int main(void) {
   Test tests[] = {
       tst_get_numbers_from_schematic,
+      tst_get_numbers_from_schematic_counts_each_number_once,
+      tst_get_numbers_from_schematic_with_bitmaps,
       tst_get_gear_ratios_from_schematic,
+      tst_schematic_stream,
+      tst_solve_schematic_in_stripes,
+      tst_schematic_index,
   };
 
   TestWithFixture tests_with_fixture[] = {
@@ -6,76 +6,54 @@
 #include <cfac/stat.h>
 
 #include "common.h"
+#include "input.h"
 #include "lib.h"
+#include "metrics.h"
 
-static STAT_Val read_lines_from_file(const char * filename, DAR_DArray * lines) {
-  CHECK(lines != NULL);
-  CHECK(DAR_is_initialized(lines));
+int main(int argc, char ** argv) {
+  const char * filename = (argc > 1) ? argv[1] : "input.txt"; // "-" reads from stdin
 
-  FILE * file_ptr = fopen(filename, "r");
-  CHECK(file_ptr != NULL);
+  Metrics metrics = {0};
+  start_metrics(&metrics, "day_3");
 
-  char *  line_raw = NULL;
-  size_t  len      = 0;
-  ssize_t read     = 0;
+  LineReader reader = {0};
+  begin_phase(&metrics, PHASE_READ);
+  TRY(open_line_reader(filename, &reader));
+  end_phase(&metrics);
 
-  while((read = getline(&line_raw, &len, file_ptr)) != -1) {
-    DAR_DArray line = {0};
-    TRY(DAR_create_from_cstr(&line, line_raw));
-    TRY(DAR_push_back(lines, &line));
-  }
-
-  fclose(file_ptr);
-  free(line_raw);
-
-  return OK;
-}
-
-static STAT_Val destroy_lines(DAR_DArray * lines) {
-  CHECK(lines != NULL);
-
-  for(DAR_DArray * p = DAR_first(lines); p != DAR_end(lines); p++) { TRY(DAR_destroy(p)); }
-
-  TRY(DAR_destroy(lines));
+  // both parts are solved as the rows come in, with only three rows kept at a time
+  SchematicStream stream = {0};
+  TRY(create_schematic_stream(&stream));
 
-  return OK;
-}
-
-int main(void) {
-
-  DAR_DArray lines = {0};
-  TRY(DAR_create(&lines, sizeof(DAR_DArray)));
-
-  TRY(read_lines_from_file("input.txt", &lines));
+  SPN_Span line    = {0};
+  STAT_Val read_st = OK;
+  begin_phase(&metrics, PHASE_READ);
+  while((read_st = read_next_line(&reader, &line)) == OK) {
+    end_phase(&metrics);
 
-  DAR_DArray schematic_arr = {0};
-  TRY(DAR_create(&schematic_arr, sizeof(SPN_Span)));
+    begin_phase(&metrics, PHASE_PART1);
+    TRY(push_schematic_row(&stream, line));
+    end_phase(&metrics);
 
-  for(size_t i = 0; i < lines.size; i++) {
-    SPN_Span line = DAR_to_span(DAR_get(&lines, i));
-    TRY(DAR_push_back(&schematic_arr, &line));
+    begin_phase(&metrics, PHASE_READ);
   }
+  end_phase(&metrics);
+  TRY(read_st);
 
-  DAR_DArray numbers = {0};
-  TRY(DAR_create(&numbers, sizeof(int)));
-
-  TRY(get_numbers_from_schematic(DAR_to_span(&schematic_arr), &numbers));
-
-  int sum_of_numbers = 0;
-  for(int * p = DAR_first(&numbers); p != DAR_end(&numbers); p++) { sum_of_numbers += *p; }
-
-  DAR_DArray ratios = {0};
-  TRY(DAR_create(&ratios, sizeof(int)));
+  begin_phase(&metrics, PHASE_PART1);
+  TRY(finish_schematic_stream(&stream));
+  end_phase(&metrics);
 
-  TRY(get_gear_ratios_from_schematic(DAR_to_span(&schematic_arr), &ratios));
+  TRY(close_line_reader(&reader));
 
-  int sum_of_ratios = 0;
-  for(int * p = DAR_first(&ratios); p != DAR_end(&ratios); p++) { sum_of_ratios += *p; }
+  const int64_t sum_of_numbers = stream.sum_of_numbers;
+  const int64_t sum_of_ratios  = stream.sum_of_ratios;
+  TRY(destroy_schematic_stream(&stream));
 
-  TRY(destroy_lines(&lines));
-  TRY(DAR_destroy(&ratios));
-  TRY(DAR_destroy(&numbers));
-  TRY(DAR_destroy(&schematic_arr));
+  TRY(write_metrics(&metrics));
 
-  return LOG_STAT(STAT_OK, "sum_of_numbers: %d, sum_of_ratios: %d", sum_of_numbers, sum_of_ratios);
+  return LOG_STAT(STAT_OK,
+                  "sum_of_numbers: %lld, sum_of_ratios: %lld",
+                  (long long)sum_of_numbers,
+                  (long long)sum_of_ratios);
 }
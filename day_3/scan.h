@@ -0,0 +1,109 @@
+#ifndef scan_h
+#define scan_h
+
+#include <cfac/log.h>
+#include <cfac/span.h>
+#include <cfac/stat.h>
+
+#include <limits.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+// decimal integer scanners for SPN_Span of char, they never read past the end of the span
+// header-only, so they inline into the parse loops that call them once per number
+//
+// each skips leading blanks (' ' and '\t'), then scans as many digits as there are, num_consumed covers both
+// returns STAT_OK_NOT_FOUND if no digits follow the blanks, STAT_ERR_READ if the number does not fit
+
+static inline size_t scan_skip_blanks(SPN_Span span) {
+  const char * str = span.begin;
+
+  size_t i = 0;
+  while(i < span.len && (str[i] == ' ' || str[i] == '\t')) i++;
+
+  return i;
+}
+
+static inline bool scan_is_digit(char c) { return (c >= '0') && (c <= '9'); }
+
+static inline STAT_Val scan_u64(SPN_Span span, uint64_t max, uint64_t * value, size_t * num_consumed) {
+  const char * str = span.begin;
+
+  const size_t first_digit = scan_skip_blanks(span);
+
+  uint64_t v = 0;
+  size_t   i = first_digit;
+  for(; i < span.len && scan_is_digit(str[i]); i++) {
+    const uint64_t digit = (uint64_t)(str[i] - '0');
+    if(v > ((max - digit) / 10)) {
+      while(i < span.len && scan_is_digit(str[i])) i++;
+      return LOG_STAT(STAT_ERR_READ,
+                      "number '%.*s' is larger than %llu",
+                      (int)(i - first_digit),
+                      &str[first_digit],
+                      (unsigned long long)max);
+    }
+    v = (v * 10) + digit;
+  }
+
+  *num_consumed = i;
+
+  if(i == first_digit) return STAT_OK_NOT_FOUND;
+
+  *value = v;
+
+  return STAT_OK;
+}
+
+// takes an optional '+' or '-' before the digits, expects min <= 0 <= max
+static inline STAT_Val scan_i64(SPN_Span span, int64_t min, int64_t max, int64_t * value, size_t * num_consumed) {
+  const char * str = span.begin;
+
+  size_t i = scan_skip_blanks(span);
+
+  bool is_negative = false;
+  if(i < span.len && (str[i] == '-' || str[i] == '+')) {
+    is_negative = (str[i] == '-');
+    i++;
+  }
+
+  // magnitude of min, written so that it does not overflow for INT64_MIN
+  const uint64_t limit = is_negative ? ((uint64_t)(-(min + 1)) + 1) : (uint64_t)max;
+
+  uint64_t       magnitude       = 0;
+  size_t         num_digits_used = 0;
+  const STAT_Val scan_st         = scan_u64(SPN_subspan(span, i, span.len - i), limit, &magnitude, &num_digits_used);
+  if(scan_st != STAT_OK) {
+    *num_consumed = scan_skip_blanks(span); // a lone sign is not part of a number
+    return scan_st;
+  }
+
+  *num_consumed = i + num_digits_used;
+  *value        = (is_negative && magnitude > 0) ? (-(int64_t)(magnitude - 1) - 1) : (int64_t)magnitude;
+
+  return STAT_OK;
+}
+
+static inline STAT_Val scan_size(SPN_Span span, size_t * value, size_t * num_consumed) {
+  uint64_t       v       = 0;
+  const STAT_Val scan_st = scan_u64(span, SIZE_MAX, &v, num_consumed);
+  if(scan_st == STAT_OK) *value = (size_t)v;
+  return scan_st;
+}
+
+static inline STAT_Val scan_ssize(SPN_Span span, ssize_t * value, size_t * num_consumed) {
+  int64_t        v       = 0;
+  const STAT_Val scan_st = scan_i64(span, -SSIZE_MAX - 1, SSIZE_MAX, &v, num_consumed);
+  if(scan_st == STAT_OK) *value = (ssize_t)v;
+  return scan_st;
+}
+
+static inline STAT_Val scan_int(SPN_Span span, int * value, size_t * num_consumed) {
+  int64_t        v       = 0;
+  const STAT_Val scan_st = scan_i64(span, INT_MIN, INT_MAX, &v, num_consumed);
+  if(scan_st == STAT_OK) *value = (int)v;
+  return scan_st;
+}
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef arena_h
+#define arena_h
+
+#include <cfac/span.h>
+#include <cfac/stat.h>
+
+#include <stddef.h>
+
+// bump allocator for transient memory, everything allocated from it is released at once by reset_arena
+typedef struct ArenaBlock ArenaBlock;
+
+typedef struct Arena {
+  ArenaBlock * blocks;        // most recently added block first, only that one is allocated from
+  size_t       next_capacity; // capacity of the next block to add when the current one runs out
+} Arena;
+
+STAT_Val create_arena(Arena * arena, size_t initial_capacity);
+
+// memory is aligned for any type, and stays valid until the next reset_arena or destroy_arena
+STAT_Val allocate_from_arena(Arena * arena, size_t size, void ** memory);
+
+// zero-initialized span of len elements
+STAT_Val allocate_span_from_arena(Arena * arena, size_t element_size, size_t len, SPN_MutSpan * span);
+
+// releases all allocations, keeping (and merging) the memory for reuse
+STAT_Val reset_arena(Arena * arena);
+
+STAT_Val destroy_arena(Arena * arena);
+
+#endif
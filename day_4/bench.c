@@ -0,0 +1,104 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cfac/log.h>
+#include <cfac/stat.h>
+
+#include "benchmark.h"
+#include "common.h"
+#include "input.h"
+#include "lib.h"
+
+typedef struct Context {
+  const char * filename;
+  InputFile    input;
+  Arena        arena; // scratch memory for one card at a time
+  int          total_score;
+  size_t       num_of_cards;
+  DAR_DArray   win_counts; // contains size_t
+} Context;
+
+static STAT_Val parse(void * p) {
+  Context * ctx = p;
+  TRY(map_input_file(ctx->filename, &ctx->input));
+  return OK;
+}
+
+static STAT_Val unparse(void * p) {
+  Context * ctx = p;
+  TRY(destroy_input_file(&ctx->input));
+  return OK;
+}
+
+static STAT_Val solve(void * p) {
+  Context * ctx = p;
+
+  ctx->total_score = 0;
+  for(const SPN_Span * line = DAR_first(&ctx->input.lines); line != DAR_end(&ctx->input.lines); line++) {
+    int score = 0;
+    TRY(get_card_score_in_arena(*line, &ctx->arena, &score));
+    TRY(reset_arena(&ctx->arena));
+    ctx->total_score += score;
+  }
+
+  TRY(get_total_number_of_cards(&ctx->input.lines, &ctx->num_of_cards));
+
+  return OK;
+}
+
+static STAT_Val solve_with_bits(void * p) {
+  Context * ctx = p;
+
+  TRY(DAR_clear(&ctx->win_counts));
+
+  ctx->total_score = 0;
+  for(const SPN_Span * line = DAR_first(&ctx->input.lines); line != DAR_end(&ctx->input.lines); line++) {
+    CardBits card      = {0};
+    size_t   win_count = 0;
+    TRY(parse_card_bits(*line, &card));
+    TRY(get_card_bits_win_count(&card, &win_count));
+    TRY(DAR_push_back(&ctx->win_counts, &win_count));
+    ctx->total_score += (win_count > 0) ? (1 << (win_count - 1)) : 0;
+  }
+
+  TRY(get_total_number_of_cards_from_win_counts(DAR_to_span(&ctx->win_counts), &ctx->num_of_cards));
+
+  return OK;
+}
+
+static STAT_Val solve_streaming(void * p) {
+  Context * ctx = p;
+
+  CardStream stream = {0};
+  for(const SPN_Span * line = DAR_first(&ctx->input.lines); line != DAR_end(&ctx->input.lines); line++) {
+    TRY(push_card_line(&stream, *line));
+  }
+
+  ctx->total_score  = (int)stream.total_score;
+  ctx->num_of_cards = stream.num_of_cards;
+
+  return OK;
+}
+
+int main(int argc, char ** argv) {
+  BenchConfig config = {0};
+  TRY(parse_bench_args(argc, argv, &config));
+
+  Context ctx = {.filename = config.input_filename};
+  TRY(create_arena(&ctx.arena, 0));
+  TRY(DAR_create(&ctx.win_counts, sizeof(size_t)));
+
+  const BenchPhase phases[] = {
+      {.name = "parse", .run = parse, .teardown = unparse},
+      {.name = "solve", .setup = parse, .run = solve, .teardown = unparse},
+      {.name = "solve_with_bits", .setup = parse, .run = solve_with_bits, .teardown = unparse},
+      {.name = "solve_streaming", .setup = parse, .run = solve_streaming, .teardown = unparse},
+  };
+
+  TRY(run_bench(&config, "day_4", phases, sizeof(phases) / sizeof(phases[0]), &ctx));
+
+  TRY(destroy_arena(&ctx.arena));
+  TRY(DAR_destroy(&ctx.win_counts));
+
+  return OK;
+}
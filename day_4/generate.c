@@ -0,0 +1,82 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cfac/log.h>
+#include <cfac/stat.h>
+
+#include "common.h"
+#include "generator.h"
+
+#include <stdbool.h>
+
+// writes num_cards cards, each with num_winning distinct winning numbers and num_own distinct numbers you have, all
+// between 1 and 99 like the puzzle input. About one in eight cards has any matches; on average that is less than one
+// copy won per card, so the total number of cards for part 2 grows linearly with num_cards instead of exponentially.
+
+#define MAX_NUMBER 99
+
+static size_t pick_unused_number(Rng * rng, bool * is_used) {
+  size_t n = 0;
+  do {
+    n = get_random_in_range(rng, 1, MAX_NUMBER);
+  } while(is_used[n]);
+  is_used[n] = true;
+
+  return n;
+}
+
+static void write_card(FILE * file, Rng * rng, size_t num_winning, size_t num_own) {
+  bool   is_used[MAX_NUMBER + 1] = {0};
+  size_t winning[MAX_NUMBER]     = {0};
+  size_t own[MAX_NUMBER]         = {0};
+
+  for(size_t i = 0; i < num_winning; i++) { winning[i] = pick_unused_number(rng, is_used); }
+
+  const size_t max_num_matches = (num_winning < num_own) ? num_winning : num_own;
+  const size_t num_matches =
+      (get_random_below(rng, 8) == 0 && max_num_matches > 0) ? get_random_in_range(rng, 1, max_num_matches) : 0;
+
+  // the winning numbers are in random order already, so the first few are as good a pick as any
+  for(size_t i = 0; i < num_matches; i++) { own[i] = winning[i]; }
+  for(size_t i = num_matches; i < num_own; i++) { own[i] = pick_unused_number(rng, is_used); }
+
+  for(size_t i = num_own; i > 1; i--) {
+    const size_t j   = get_random_below(rng, i);
+    const size_t tmp = own[i - 1];
+    own[i - 1]       = own[j];
+    own[j]           = tmp;
+  }
+
+  for(size_t i = 0; i < num_winning; i++) { fprintf(file, " %2zu", winning[i]); }
+  fputs(" |", file);
+  for(size_t i = 0; i < num_own; i++) { fprintf(file, " %2zu", own[i]); }
+}
+
+int main(int argc, char ** argv) {
+  GeneratorConfig config = {.seed = 1, .sizes = {200, 10, 25}};
+  TRY(parse_generator_args(argc, argv, "[num_cards [num_winning [num_own]]]", 3, &config));
+
+  const size_t num_cards   = config.sizes[0];
+  const size_t num_winning = config.sizes[1];
+  const size_t num_own     = config.sizes[2];
+
+  if(num_winning + num_own > MAX_NUMBER) {
+    return LOG_STAT(STAT_ERR_ARGS, "num_winning + num_own can be at most %d", MAX_NUMBER);
+  }
+
+  Rng rng = {0};
+  seed_rng(&rng, config.seed);
+
+  FILE * file = NULL;
+  TRY(open_generator_output(&config, &file));
+
+  for(size_t card_id = 1; card_id <= num_cards; card_id++) {
+    fprintf(file, "Card %3zu:", card_id);
+    write_card(file, &rng, num_winning, num_own);
+    fputc('\n', file);
+  }
+
+  TRY(close_generator_output(file));
+
+  return OK;
+}
@@ -2,22 +2,22 @@
 
 #include "common.h"
 #include "lib.h"
+#include "scan.h"
 
 #include <cfac/darray.h>
-#include <cfac/list.h>
-
-#include <stdio.h>
 
 typedef struct Card {
-  int        id;
-  DAR_DArray winning_numbers;
-  DAR_DArray numbers;
+  int         id;
+  SPN_MutSpan winning_numbers; // contains int, allocated from an arena
+  SPN_MutSpan numbers;         // contains int, allocated from an arena
 } Card;
 
 static STAT_Val get_card_id(SPN_Span card_line, int * id) {
   CHECK(id != NULL);
+  CHECK(card_line.len > 5);
 
-  CHECK(sscanf(card_line.begin, "Card %d:", id) == 1);
+  size_t num_consumed = 0;
+  CHECK(scan_int(SPN_subspan(card_line, 5, card_line.len - 5), id, &num_consumed) == STAT_OK); // after "Card "
 
   return OK;
 }
@@ -48,38 +48,48 @@ static STAT_Val get_number_spans(SPN_Span card_line, SPN_Span * winning_number_s
   return OK;
 }
 
-static STAT_Val get_numbers(SPN_Span span, DAR_DArray * numbers) {
+static size_t count_numbers(SPN_Span span) {
+  size_t num_numbers = 0;
+
+  bool in_number = false;
+  for(const char * c = SPN_first(span); c != (const char *)SPN_end(span); c++) {
+    const bool is_digit = (*c >= '0' && *c <= '9');
+    if(is_digit && !in_number) num_numbers++;
+    in_number = is_digit;
+  }
+
+  return num_numbers;
+}
+
+static STAT_Val get_numbers(SPN_Span span, Arena * arena, SPN_MutSpan * numbers) {
+  CHECK(arena != NULL);
   CHECK(numbers != NULL);
-  CHECK(DAR_is_initialized(numbers));
-  CHECK(numbers->element_size == sizeof(int));
-
-  SPN_Span   remaining = span;
-  const char delim     = ' ';
-  while(remaining.len > 0) {
-    // skip over spaces
-    while(remaining.len > 0 && (*(const char *)SPN_first(remaining)) == ' ') {
-      remaining = SPN_subspan(remaining, 1, remaining.len - 1);
-    }
 
-    int n = 0;
-    CHECK(sscanf(remaining.begin, "%d", &n) == 1);
-    TRY(DAR_push_back(numbers, &n));
-
-    size_t   next_delim_idx = 0;
-    STAT_Val find_res       = SPN_find(remaining, &delim, &next_delim_idx);
-    if(find_res == STAT_OK) {
-      remaining = SPN_subspan(remaining, next_delim_idx + 1, remaining.len - next_delim_idx);
-    } else if(find_res == STAT_OK_NOT_FOUND) {
-      break;
-    } else {
-      return LOG_STAT(find_res, "oh no!");
-    }
+  // count first, so the numbers fit exactly in one allocation from the arena
+  TRY(allocate_span_from_arena(arena, sizeof(int), count_numbers(span), numbers));
+
+  size_t   num_found = 0;
+  SPN_Span remaining = span;
+  while(true) {
+    int            number       = 0;
+    size_t         num_consumed = 0;
+    const STAT_Val scan_st      = scan_int(remaining, &number, &num_consumed);
+    TRY(scan_st);
+    if(scan_st == STAT_OK_NOT_FOUND) break;
+
+    CHECK(num_found < numbers->len);
+    *(int *)SPN_get(*numbers, num_found) = number;
+    num_found++;
+
+    remaining = SPN_subspan(remaining, num_consumed, remaining.len - num_consumed);
   }
 
+  CHECK(num_found == numbers->len);
+
   return OK;
 }
 
-static STAT_Val parse_card(SPN_Span card_line, Card * card) {
+static STAT_Val parse_card(SPN_Span card_line, Arena * arena, Card * card) {
   CHECK(card != NULL);
 
   TRY(get_card_id(card_line, &(card->id)));
@@ -89,11 +99,8 @@ static STAT_Val parse_card(SPN_Span card_line, Card * card) {
 
   TRY(get_number_spans(card_line, &winning_number_span, &number_span));
 
-  TRY(DAR_create(&card->winning_numbers, sizeof(int)));
-  TRY(DAR_create(&card->numbers, sizeof(int)));
-
-  TRY(get_numbers(winning_number_span, &card->winning_numbers));
-  TRY(get_numbers(number_span, &card->numbers));
+  TRY(get_numbers(winning_number_span, arena, &card->winning_numbers));
+  TRY(get_numbers(number_span, arena, &card->numbers));
 
   return OK;
 }
@@ -104,8 +111,8 @@ static STAT_Val calculate_win_count(const Card * card, size_t * win_count) {
 
   *win_count = 0;
 
-  for(const int * num_p = DAR_first(&card->numbers); num_p != DAR_end(&card->numbers); num_p++) {
-    for(const int * win_num_p = DAR_first(&card->winning_numbers); win_num_p != DAR_end(&card->winning_numbers);
+  for(const int * num_p = SPN_first(card->numbers); num_p != SPN_end(card->numbers); num_p++) {
+    for(const int * win_num_p = SPN_first(card->winning_numbers); win_num_p != SPN_end(card->winning_numbers);
         win_num_p++) {
       if(*num_p == *win_num_p) (*win_count)++;
     }
@@ -114,86 +121,221 @@ static STAT_Val calculate_win_count(const Card * card, size_t * win_count) {
   return OK;
 }
 
-static STAT_Val destroy_card(Card * card) {
-  if(card != NULL) {
-    TRY(DAR_destroy(&card->numbers));
-    TRY(DAR_destroy(&card->winning_numbers));
-  }
+STAT_Val get_card_score(SPN_Span card_line, int * score) {
+  Arena arena = {0};
+  TRY(create_arena(&arena, 0));
+
+  TRY(get_card_score_in_arena(card_line, &arena, score));
+
+  TRY(destroy_arena(&arena));
+
   return OK;
 }
 
-STAT_Val get_card_score(SPN_Span card_line, int * score) {
+STAT_Val get_card_win_count(SPN_Span card_line, size_t * win_count) {
+  Arena arena = {0};
+  TRY(create_arena(&arena, 0));
+
+  TRY(get_card_win_count_in_arena(card_line, &arena, win_count));
+
+  TRY(destroy_arena(&arena));
+
+  return OK;
+}
+
+STAT_Val get_card_score_in_arena(SPN_Span card_line, Arena * arena, int * score) {
   CHECK(card_line.len > 1);
   CHECK(score != NULL);
 
   size_t win_count = 0;
 
-  TRY(get_card_win_count(card_line, &win_count));
+  TRY(get_card_win_count_in_arena(card_line, arena, &win_count));
 
   *score = (win_count > 0) ? (1 << (win_count - 1)) : 0;
 
   return OK;
 }
 
-STAT_Val get_card_win_count(SPN_Span card_line, size_t * win_count) {
+STAT_Val get_card_win_count_in_arena(SPN_Span card_line, Arena * arena, size_t * win_count) {
   CHECK(card_line.len > 1);
+  CHECK(arena != NULL);
   CHECK(win_count != NULL);
 
   Card card = {0};
 
-  TRY(parse_card(card_line, &card));
+  TRY(parse_card(card_line, arena, &card));
 
   TRY(calculate_win_count(&card, win_count));
 
-  TRY(destroy_card(&card));
-
   return OK;
 }
 
-STAT_Val get_total_number_of_cards(const DAR_DArray * lines, size_t * num_of_cards) {
+STAT_Val get_total_number_of_cards(const DAR_DArray * lines /* contains SPN_Span */, size_t * num_of_cards) {
   CHECK(lines != NULL);
-  CHECK(lines->element_size == sizeof(DAR_DArray));
+  CHECK(lines->element_size == sizeof(SPN_Span));
   CHECK(num_of_cards != NULL);
 
-  DAR_DArray win_counts          = {0};
-  LST_List   to_be_counted_cards = {0};
+  DAR_DArray win_counts = {0};
   TRY(DAR_create(&win_counts, sizeof(size_t)));
   TRY(DAR_reserve(&win_counts, lines->size));
-  TRY(LST_create(&to_be_counted_cards, sizeof(size_t)));
+
+  Arena arena = {0};
+  TRY(create_arena(&arena, 0));
+
+  for(const SPN_Span * line = DAR_first(lines); line != DAR_end(lines); line++) {
+    size_t win_count = 0;
+    TRY(get_card_win_count_in_arena(*line, &arena, &win_count));
+    TRY(DAR_push_back(&win_counts, &win_count));
+    TRY(reset_arena(&arena));
+  }
+
+  TRY(destroy_arena(&arena));
+
+  TRY(get_total_number_of_cards_from_win_counts(DAR_to_span(&win_counts), num_of_cards));
+
+  TRY(DAR_destroy(&win_counts));
+
+  return OK;
+}
+
+STAT_Val get_total_number_of_cards_from_win_counts(SPN_Span win_counts /* contains size_t */, size_t * num_of_cards) {
+  CHECK(win_counts.element_size == sizeof(size_t));
+  CHECK(num_of_cards != NULL);
 
   *num_of_cards = 0;
 
-  // first get all the win counts, as well as counting each card once
+  const size_t   num_cards = win_counts.len;
+  const size_t * wins      = win_counts.begin;
 
-  for(size_t idx = 0; idx < lines->size; idx++) {
-    const DAR_DArray * line = DAR_get(lines, idx);
+  // the copies a card hands out are added to the running count of extra copies right away, and taken off again
+  // once the range of cards they go to has passed, so every card is visited once however many copies there are
+  DAR_DArray expiring = {0}; // size_t, [i] is the copies that no longer apply from card i on
+  TRY(DAR_create(&expiring, sizeof(size_t)));
+  TRY(DAR_resize_zeroed(&expiring, num_cards + 1));
 
-    size_t win_count = 0;
-    TRY(get_card_win_count(DAR_to_span(line), &win_count));
+  size_t * expiring_at  = expiring.data;
+  size_t   extra_copies = 0;
+  bool     overflowed   = false;
 
-    TRY(DAR_push_back(&win_counts, &win_count));
-    TRY(LST_insert(&to_be_counted_cards, LST_end(&to_be_counted_cards), &idx, NULL));
-    (*num_of_cards)++;
+  for(size_t idx = 0; idx < num_cards && !overflowed; idx++) {
+    size_t copies = 0;
+    overflowed |= __builtin_add_overflow(extra_copies, 1, &copies);
+    overflowed |= __builtin_add_overflow(*num_of_cards, copies, num_of_cards);
+
+    // expired copies were all counted in extra_copies, so this never wraps
+    extra_copies -= expiring_at[idx + 1];
+
+    const size_t last_idx = (wins[idx] < num_cards - idx) ? (idx + wins[idx]) : (num_cards - 1);
+    if(last_idx > idx) {
+      overflowed |= __builtin_add_overflow(extra_copies, copies, &extra_copies);
+      expiring_at[last_idx + 1] += copies;
+    }
   }
 
-  // keep going through list of to-be-counted cards, adding copies to the end, until it is empty
-  while(!LST_is_empty(&to_be_counted_cards)) {
-    const size_t card_idx = *(size_t *)LST_data(LST_first(&to_be_counted_cards));
-    TRY(LST_remove(LST_first(&to_be_counted_cards)));
+  TRY(DAR_destroy(&expiring));
 
-    const size_t win_count = *(const int *)DAR_get(&win_counts, card_idx);
-    for(size_t i = 0; i < win_count; i++) {
-      const size_t copy_idx = card_idx + i + 1;
+  if(overflowed) return LOG_STAT(STAT_ERR_READ, "number of cards does not fit in %zu bits", sizeof(size_t) * 8);
 
-      if(copy_idx < win_counts.size) {
-        TRY(LST_insert(&to_be_counted_cards, LST_end(&to_be_counted_cards), &copy_idx, NULL));
-        (*num_of_cards)++;
-      }
+  return OK;
+}
+
+static STAT_Val scan_number_bits(SPN_Span span, uint64_t bits[CARD_BITSET_WORDS]) {
+  for(size_t w = 0; w < CARD_BITSET_WORDS; w++) bits[w] = 0;
+
+  while(true) {
+    size_t         number       = 0;
+    size_t         num_consumed = 0;
+    const STAT_Val scan_st      = scan_size(span, &number, &num_consumed);
+    TRY(scan_st);
+    if(scan_st == STAT_OK_NOT_FOUND) break;
+
+    if(number >= CARD_NUMBER_LIMIT) {
+      return LOG_STAT(STAT_ERR_READ, "card number %zu is not below CARD_NUMBER_LIMIT (%d)", number, CARD_NUMBER_LIMIT);
     }
+    bits[number / 64] |= (uint64_t)1 << (number % 64);
+
+    span = SPN_subspan(span, num_consumed, span.len - num_consumed);
   }
 
-  TRY(LST_destroy(&to_be_counted_cards));
-  TRY(DAR_destroy(&win_counts));
+  return OK;
+}
+
+STAT_Val parse_card_bits(SPN_Span card_line, CardBits * card) {
+  CHECK(card_line.element_size == sizeof(char));
+  CHECK(card != NULL);
+
+  TRY(get_card_id(card_line, &card->id));
+
+  SPN_Span winning_number_span = {0};
+  SPN_Span number_span         = {0};
+  TRY(get_number_spans(card_line, &winning_number_span, &number_span));
+
+  TRY(scan_number_bits(winning_number_span, card->winning_numbers));
+  TRY(scan_number_bits(number_span, card->numbers));
+
+  return OK;
+}
+
+STAT_Val get_card_bits_win_count(const CardBits * card, size_t * win_count) {
+  CHECK(card != NULL);
+  CHECK(win_count != NULL);
+
+  *win_count = 0;
+  for(size_t w = 0; w < CARD_BITSET_WORDS; w++) {
+    *win_count += (size_t)__builtin_popcountll(card->winning_numbers[w] & card->numbers[w]);
+  }
 
   return OK;
-}
\ No newline at end of file
+}
+
+STAT_Val push_card_win_count(CardStream * stream, size_t win_count) {
+  CHECK(stream != NULL);
+  CHECK(win_count < CARD_STREAM_RING_SIZE);
+
+  // everything is worked out and checked first, so a rejected card leaves the stream as it was
+  size_t copies       = 0;
+  size_t num_of_cards = 0;
+  if(__builtin_add_overflow(stream->extra_copies, 1, &copies) ||
+     __builtin_add_overflow(stream->num_of_cards, copies, &num_of_cards)) {
+    return LOG_STAT(STAT_ERR_READ, "number of cards does not fit in %zu bits", sizeof(size_t) * 8);
+  }
+
+  uint64_t total_score = stream->total_score;
+  if(win_count > 0) {
+    const uint64_t score = (win_count <= 64) ? ((uint64_t)1 << (win_count - 1)) : 0;
+    if(score == 0 || __builtin_add_overflow(total_score, score, &total_score)) {
+      return LOG_STAT(STAT_ERR_READ, "total score does not fit in 64 bits");
+    }
+  }
+
+  const size_t idx           = stream->num_cards_read;
+  size_t *     expiring_next = &stream->expiring_copies[(idx + 1) % CARD_STREAM_RING_SIZE];
+
+  // expired copies were all counted in extra_copies, so this never wraps
+  size_t extra_copies = stream->extra_copies - *expiring_next;
+  if(win_count > 0 && __builtin_add_overflow(extra_copies, copies, &extra_copies)) {
+    return LOG_STAT(STAT_ERR_READ, "number of cards does not fit in %zu bits", sizeof(size_t) * 8);
+  }
+
+  stream->num_of_cards   = num_of_cards;
+  stream->total_score    = total_score;
+  stream->num_cards_read = idx + 1;
+  stream->extra_copies   = extra_copies;
+  *expiring_next         = 0;
+  if(win_count > 0) stream->expiring_copies[(idx + win_count + 1) % CARD_STREAM_RING_SIZE] += copies;
+
+  return OK;
+}
+
+STAT_Val push_card_line(CardStream * stream, SPN_Span card_line) {
+  CHECK(stream != NULL);
+
+  CardBits card      = {0};
+  size_t   win_count = 0;
+  TRY(parse_card_bits(card_line, &card));
+  TRY(get_card_bits_win_count(&card, &win_count));
+
+  TRY(push_card_win_count(stream, win_count));
+
+  return OK;
+}
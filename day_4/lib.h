@@ -5,10 +5,58 @@
 #include <cfac/span.h>
 #include <cfac/stat.h>
 
+#include "arena.h"
+
+#include <stdint.h>
+
 STAT_Val get_card_score(SPN_Span card_line, int * score);
 
 STAT_Val get_card_win_count(SPN_Span card_line, size_t * win_count);
 
-STAT_Val get_total_number_of_cards(const DAR_DArray * lines, size_t * num_of_cards);
+// take their scratch memory from arena, which the caller can reset once the card is done
+STAT_Val get_card_score_in_arena(SPN_Span card_line, Arena * arena, int * score);
+STAT_Val get_card_win_count_in_arena(SPN_Span card_line, Arena * arena, size_t * win_count);
+
+STAT_Val get_total_number_of_cards(const DAR_DArray * lines /* contains SPN_Span */, size_t * num_of_cards);
+
+STAT_Val get_total_number_of_cards_from_win_counts(SPN_Span win_counts /* contains size_t */, size_t * num_of_cards);
+
+// card numbers are kept as bitsets with bit n set for number n, the numbers on a card must be below
+// CARD_NUMBER_LIMIT, which can be raised at build time for decks with larger numbers
+#ifndef CARD_NUMBER_LIMIT
+#define CARD_NUMBER_LIMIT 128
+#endif
+
+#define CARD_BITSET_WORDS ((CARD_NUMBER_LIMIT + 63) / 64)
+
+typedef struct CardBits {
+  int      id;
+  uint64_t winning_numbers[CARD_BITSET_WORDS];
+  uint64_t numbers[CARD_BITSET_WORDS];
+} CardBits;
+
+// parses straight into the bitsets, without allocating
+STAT_Val parse_card_bits(SPN_Span card_line, CardBits * card);
+
+// the numbers that are also winning numbers, a number that is on the card twice only counts once
+STAT_Val get_card_bits_win_count(const CardBits * card, size_t * win_count);
+
+// both parts over cards that are read once, in order: a card only hands out copies of the next win count cards,
+// and a win count is at most CARD_NUMBER_LIMIT, so only that many cards of pending copies are kept, in a ring
+#define CARD_STREAM_RING_SIZE (CARD_NUMBER_LIMIT + 1)
+
+typedef struct CardStream {
+  uint64_t total_score;
+  size_t   num_of_cards;   // of the cards pushed so far, copies included
+  size_t   num_cards_read; // originals only
+  size_t   extra_copies;   // of the next card, won from the cards before it
+
+  // [i % CARD_STREAM_RING_SIZE]: copies that no longer apply from card i on
+  size_t expiring_copies[CARD_STREAM_RING_SIZE];
+} CardStream;
+
+// zero initialize a CardStream to start, it holds no resources
+STAT_Val push_card_line(CardStream * stream, SPN_Span card_line);
+STAT_Val push_card_win_count(CardStream * stream, size_t win_count);
 
 #endif
\ No newline at end of file
@@ -44,6 +44,33 @@ static Result tst_get_card_score_example(void) {
   return r;
 }
 
+static Result tst_get_card_win_count_in_arena(void) {
+  Result r = PASS;
+
+  SPN_Span cards[] = {
+      SPN_from_cstr("Card 1: 41 48 83 86 17 | 83 86  6 31 17  9 48 53"),
+      SPN_from_cstr("Card 2: 13 32 20 16 61 | 61 30 68 82 17 32 24 19"),
+      SPN_from_cstr("Card 3:  1 21 53 59 44 | 69 82 63 72 16 21 14  1"),
+  };
+  const size_t expect_win_counts[] = {4, 2, 2};
+
+  Arena arena = {0};
+  EXPECT_OK(&r, create_arena(&arena, 0));
+  if(HAS_FAILED(&r)) return r;
+
+  // the same arena serves every card, released in between
+  for(size_t i = 0; i < sizeof(cards) / sizeof(cards[0]); i++) {
+    size_t win_count = 0;
+    EXPECT_OK(&r, get_card_win_count_in_arena(cards[i], &arena, &win_count));
+    EXPECT_EQ(&r, expect_win_counts[i], win_count);
+    EXPECT_OK(&r, reset_arena(&arena));
+  }
+
+  EXPECT_OK(&r, destroy_arena(&arena));
+
+  return r;
+}
+
 static Result tst_get_total_number_of_cards_basic(void) {
   Result r = PASS;
 
@@ -56,20 +83,14 @@ static Result tst_get_total_number_of_cards_basic(void) {
   };
 
   DAR_DArray lines = {0};
-  EXPECT_OK(&r, DAR_create(&lines, sizeof(DAR_DArray)));
-
-  for(size_t i = 0; i < sizeof(cards) / sizeof(cards[0]); i++) {
-    DAR_DArray line = {0};
-    EXPECT_OK(&r, DAR_create_from_span(&line, cards[i]));
-    EXPECT_OK(&r, DAR_push_back(&lines, &line));
-  }
+  EXPECT_OK(&r, DAR_create(&lines, sizeof(SPN_Span)));
+  EXPECT_OK(&r, DAR_push_back_array(&lines, cards, sizeof(cards) / sizeof(cards[0])));
 
   size_t num_of_cards = 0;
 
   EXPECT_OK(&r, get_total_number_of_cards(&lines, &num_of_cards));
   EXPECT_EQ(&r, 3 + 2 + 1 + 1, num_of_cards);
 
-  for(DAR_DArray * line = DAR_first(&lines); line != DAR_end(&lines); line++) { EXPECT_OK(&r, DAR_destroy(line)); }
   EXPECT_OK(&r, DAR_destroy(&lines));
 
   return r;
@@ -90,25 +111,133 @@ static Result tst_get_total_number_of_cards_example(void) {
   };
 
   DAR_DArray lines = {0};
-  EXPECT_OK(&r, DAR_create(&lines, sizeof(DAR_DArray)));
-
-  for(size_t i = 0; i < sizeof(cards) / sizeof(cards[0]); i++) {
-    DAR_DArray line = {0};
-    EXPECT_OK(&r, DAR_create_from_span(&line, cards[i]));
-    EXPECT_OK(&r, DAR_push_back(&lines, &line));
-  }
+  EXPECT_OK(&r, DAR_create(&lines, sizeof(SPN_Span)));
+  EXPECT_OK(&r, DAR_push_back_array(&lines, cards, sizeof(cards) / sizeof(cards[0])));
 
   size_t num_of_cards = 0;
 
   EXPECT_OK(&r, get_total_number_of_cards(&lines, &num_of_cards));
   EXPECT_EQ(&r, 30, num_of_cards);
 
-  for(DAR_DArray * line = DAR_first(&lines); line != DAR_end(&lines); line++) { EXPECT_OK(&r, DAR_destroy(line)); }
   EXPECT_OK(&r, DAR_destroy(&lines));
 
   return r;
 }
 
+static Result tst_get_total_number_of_cards_from_win_counts(void) {
+  Result r = PASS;
+
+  size_t num_of_cards = 0;
+
+  const size_t   example[]    = {4, 2, 2, 1, 0, 0};
+  const SPN_Span example_span = {.begin = example, .element_size = sizeof(size_t), .len = 6};
+  EXPECT_OK(&r, get_total_number_of_cards_from_win_counts(example_span, &num_of_cards));
+  EXPECT_EQ(&r, 30, num_of_cards);
+
+  // wins that reach past the last card only count up to it
+  const size_t   past_the_end[]    = {0, 5, 9};
+  const SPN_Span past_the_end_span = {.begin = past_the_end, .element_size = sizeof(size_t), .len = 3};
+  EXPECT_OK(&r, get_total_number_of_cards_from_win_counts(past_the_end_span, &num_of_cards));
+  EXPECT_EQ(&r, 1 + 1 + 2, num_of_cards);
+
+  const SPN_Span no_cards = {.begin = example, .element_size = sizeof(size_t), .len = 0};
+  EXPECT_OK(&r, get_total_number_of_cards_from_win_counts(no_cards, &num_of_cards));
+  EXPECT_EQ(&r, 0, num_of_cards);
+
+  // when every card wins a copy of all cards after it, card i ends up with 2^i copies
+  size_t wins_all[65] = {0};
+  for(size_t i = 0; i < 65; i++) wins_all[i] = 65 - i - 1;
+
+  const SPN_Span all_but_one = {.begin = &wins_all[1], .element_size = sizeof(size_t), .len = 64};
+  EXPECT_OK(&r, get_total_number_of_cards_from_win_counts(all_but_one, &num_of_cards));
+  EXPECT_EQ(&r, SIZE_MAX, num_of_cards);
+
+  const SPN_Span all = {.begin = wins_all, .element_size = sizeof(size_t), .len = 65};
+  EXPECT_EQ(&r, STAT_ERR_READ, get_total_number_of_cards_from_win_counts(all, &num_of_cards));
+
+  return r;
+}
+
+static Result tst_card_bits(void) {
+  Result r = PASS;
+
+  SPN_Span cards[] = {
+      SPN_from_cstr("Card 1: 41 48 83 86 17 | 83 86  6 31 17  9 48 53\n"),
+      SPN_from_cstr("Card 2: 13 32 20 16 61 | 61 30 68 82 17 32 24 19\n"),
+      SPN_from_cstr("Card 3:  1 21 53 59 44 | 69 82 63 72 16 21 14  1\n"),
+      SPN_from_cstr("Card 4: 41 92 73 84 69 | 59 84 76 51 58  5 54 83\n"),
+      SPN_from_cstr("Card 5: 87 83 26 28 32 | 88 30 70 12 93 22 82 36\n"),
+      SPN_from_cstr("Card  6: 31 18 13 56 72 | 74 77 10 23 35 67 36 11"),
+      SPN_from_cstr("Card 7: 0 63 64 127 | 127 64 63 0 1"),
+  };
+  const size_t expect_win_counts[] = {4, 2, 2, 1, 0, 0, 4};
+
+  for(size_t i = 0; i < sizeof(cards) / sizeof(cards[0]); i++) {
+    CardBits card      = {0};
+    size_t   win_count = 0;
+    EXPECT_OK(&r, parse_card_bits(cards[i], &card));
+    EXPECT_EQ(&r, (int)(i + 1), card.id);
+    EXPECT_OK(&r, get_card_bits_win_count(&card, &win_count));
+    EXPECT_EQ(&r, expect_win_counts[i], win_count);
+  }
+
+  CardBits card = {0};
+  EXPECT_EQ(&r, STAT_ERR_READ, parse_card_bits(SPN_from_cstr("Card 1: 1 2 | 128 3"), &card));
+
+  return r;
+}
+
+static Result tst_card_stream(void) {
+  Result r = PASS;
+
+  SPN_Span cards[] = {
+      SPN_from_cstr("Card 1: 41 48 83 86 17 | 83 86  6 31 17  9 48 53\n"),
+      SPN_from_cstr("Card 2: 13 32 20 16 61 | 61 30 68 82 17 32 24 19\n"),
+      SPN_from_cstr("Card 3:  1 21 53 59 44 | 69 82 63 72 16 21 14  1\n"),
+      SPN_from_cstr("Card 4: 41 92 73 84 69 | 59 84 76 51 58  5 54 83\n"),
+      SPN_from_cstr("Card 5: 87 83 26 28 32 | 88 30 70 12 93 22 82 36\n"),
+      SPN_from_cstr("Card 6: 31 18 13 56 72 | 74 77 10 23 35 67 36 11\n"),
+  };
+
+  CardStream stream = {0};
+  for(size_t i = 0; i < sizeof(cards) / sizeof(cards[0]); i++) EXPECT_OK(&r, push_card_line(&stream, cards[i]));
+
+  EXPECT_EQ(&r, 13, stream.total_score);
+  EXPECT_EQ(&r, 30, stream.num_of_cards);
+  EXPECT_EQ(&r, 6, stream.num_cards_read);
+
+  // must agree with counting over all win counts at once, also once copies wrap around the ring
+  size_t   win_counts[300] = {0};
+  unsigned state           = 99;
+  for(size_t i = 0; i < 300; i++) {
+    state         = (state * 1103515245u) + 12345u;
+    win_counts[i] = ((state >> 16) % 16 == 0) ? ((state >> 8) % 65) : ((state >> 16) % 2);
+  }
+
+  stream = (CardStream){0};
+  for(size_t num_cards = 1; num_cards <= 300; num_cards++) {
+    EXPECT_OK(&r, push_card_win_count(&stream, win_counts[num_cards - 1]));
+
+    const SPN_Span win_count_span = {.begin = win_counts, .element_size = sizeof(size_t), .len = num_cards};
+    size_t         num_of_cards   = 0;
+    EXPECT_OK(&r, get_total_number_of_cards_from_win_counts(win_count_span, &num_of_cards));
+    EXPECT_EQ(&r, num_of_cards, stream.num_of_cards);
+    if(HAS_FAILED(&r)) {
+      printf("num_cards: %zu\n", num_cards);
+      return r;
+    }
+  }
+
+  // a rejected card leaves the stream as it was
+  stream = (CardStream){0};
+  EXPECT_OK(&r, push_card_win_count(&stream, 2));
+  const CardStream before = stream;
+  EXPECT_EQ(&r, STAT_ERR_READ, push_card_win_count(&stream, 65));
+  EXPECT_TRUE(&r, memcmp(&before, &stream, sizeof(stream)) == 0);
+
+  return r;
+}
+
 static Result tst_fixture(void * env) {
   Result r = PASS;
 
@@ -121,8 +250,12 @@ int main(void) {
   Test tests[] = {
       tst_get_card_score_basic,
       tst_get_card_score_example,
+      tst_get_card_win_count_in_arena,
       tst_get_total_number_of_cards_basic,
       tst_get_total_number_of_cards_example,
+      tst_get_total_number_of_cards_from_win_counts,
+      tst_card_bits,
+      tst_card_stream,
   };
 
   TestWithFixture tests_with_fixture[] = {
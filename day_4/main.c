@@ -6,59 +6,45 @@
 #include <cfac/stat.h>
 
 #include "common.h"
+#include "input.h"
 #include "lib.h"
+#include "metrics.h"
 
-static STAT_Val read_lines_from_file(const char * filename, DAR_DArray * lines) {
-  CHECK(lines != NULL);
-  CHECK(DAR_is_initialized(lines));
+int main(int argc, char ** argv) {
+  const char * filename = (argc > 1) ? argv[1] : "input.txt"; // "-" reads from stdin
 
-  FILE * file_ptr = fopen(filename, "r");
-  CHECK(file_ptr != NULL);
+  Metrics metrics = {0};
+  start_metrics(&metrics, "day_4");
 
-  char *  line_raw = NULL;
-  size_t  len      = 0;
-  ssize_t read     = 0;
+  LineReader reader = {0};
+  begin_phase(&metrics, PHASE_READ);
+  TRY(open_line_reader(filename, &reader));
+  end_phase(&metrics);
 
-  while((read = getline(&line_raw, &len, file_ptr)) != -1) {
-    DAR_DArray line = {0};
-    TRY(DAR_create_from_cstr(&line, line_raw));
-    TRY(DAR_push_back(lines, &line));
-  }
-
-  fclose(file_ptr);
-  free(line_raw);
-
-  return OK;
-}
-
-static STAT_Val destroy_lines(DAR_DArray * lines) {
-  CHECK(lines != NULL);
-
-  for(DAR_DArray * p = DAR_first(lines); p != DAR_end(lines); p++) { TRY(DAR_destroy(p)); }
-
-  TRY(DAR_destroy(lines));
-
-  return OK;
-}
-
-int main(void) {
+  // both parts are solved as the cards come in, nothing is kept of a card once it is read
+  CardStream stream = {0};
 
-  DAR_DArray lines = {0};
-  TRY(DAR_create(&lines, sizeof(DAR_DArray)));
+  SPN_Span line    = {0};
+  STAT_Val read_st = OK;
+  begin_phase(&metrics, PHASE_READ);
+  while((read_st = read_next_line(&reader, &line)) == OK) {
+    end_phase(&metrics);
 
-  TRY(read_lines_from_file("input.txt", &lines));
+    begin_phase(&metrics, PHASE_PART1);
+    TRY(push_card_line(&stream, line));
+    end_phase(&metrics);
 
-  int total_score = 0;
-  for(const DAR_DArray * line = DAR_first(&lines); line != DAR_end(&lines); line++) {
-    int score = 0;
-    TRY(get_card_score(DAR_to_span(line), &score));
-    total_score += score;
+    begin_phase(&metrics, PHASE_READ);
   }
+  end_phase(&metrics);
+  TRY(read_st);
 
-  size_t num_of_cards = 0;
-  TRY(get_total_number_of_cards(&lines, &num_of_cards));
+  TRY(close_line_reader(&reader));
 
-  TRY(destroy_lines(&lines));
+  TRY(write_metrics(&metrics));
 
-  return LOG_STAT(STAT_OK, "total score: %d, total number of cards: %zu", total_score, num_of_cards);
+  return LOG_STAT(STAT_OK,
+                  "total score: %llu, total number of cards: %zu",
+                  (unsigned long long)stream.total_score,
+                  stream.num_of_cards);
 }
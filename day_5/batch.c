@@ -0,0 +1,57 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cfac/darray.h>
+#include <cfac/log.h>
+#include <cfac/stat.h>
+
+#include "common.h"
+#include "driver.h"
+#include "input.h"
+#include "lib.h"
+
+static STAT_Val solve_input(const InputFile * input, char * result, size_t result_size) {
+  Almanac almanac                   = {0};
+  size_t  lowest_location_for_part1 = 0;
+  size_t  lowest_location_for_part2 = 0;
+  TRY(parse_almanac_cached(input, &almanac));
+  TRY(find_lowest_location_number_for_part1(&almanac, &lowest_location_for_part1));
+  TRY(find_lowest_location_number_for_part2(&almanac, &lowest_location_for_part2));
+
+  TRY(destroy_almanac(&almanac));
+
+  snprintf(result,
+           result_size,
+           "lowest_location_for_part1: %zu, lowest_location_for_part_2: %zu",
+           lowest_location_for_part1,
+           lowest_location_for_part2);
+
+  return OK;
+}
+
+static STAT_Val solve_file(const char * filename, char * result, size_t result_size) {
+  InputFile input = {0};
+  TRY(map_input_file(filename, &input));
+
+  // the mapping is released whether or not the input could be solved
+  const STAT_Val solve_st = solve_input(&input, result, result_size);
+  TRY(destroy_input_file(&input));
+  TRY(solve_st);
+
+  return OK;
+}
+
+int main(int argc, char ** argv) {
+  BatchConfig config = {0};
+  TRY(parse_batch_args(argc, argv, &config));
+
+  size_t num_failed = 0;
+  TRY(run_batch(&config, solve_file, &num_failed));
+
+  const size_t num_files = config.input_filenames.size;
+  TRY(destroy_batch_config(&config));
+
+  if(num_failed > 0) return LOG_STAT(STAT_ERR_INTERNAL, "failed to solve %zu of %zu files", num_failed, num_files);
+
+  return OK;
+}
@@ -0,0 +1,55 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cfac/log.h>
+#include <cfac/stat.h>
+
+#include "benchmark.h"
+#include "common.h"
+#include "input.h"
+#include "lib.h"
+
+typedef struct Context {
+  InputFile input;
+  Almanac   almanac;
+  size_t    lowest_location_for_part1;
+  size_t    lowest_location_for_part2;
+} Context;
+
+static STAT_Val parse(void * p) {
+  Context * ctx = p;
+  TRY(parse_almanac(&ctx->input.lines, &ctx->almanac));
+  return OK;
+}
+
+static STAT_Val unparse(void * p) {
+  Context * ctx = p;
+  TRY(destroy_almanac(&ctx->almanac));
+  return OK;
+}
+
+static STAT_Val solve(void * p) {
+  Context * ctx = p;
+  TRY(find_lowest_location_number_for_part1(&ctx->almanac, &ctx->lowest_location_for_part1));
+  TRY(find_lowest_location_number_for_part2(&ctx->almanac, &ctx->lowest_location_for_part2));
+  return OK;
+}
+
+int main(int argc, char ** argv) {
+  BenchConfig config = {0};
+  TRY(parse_bench_args(argc, argv, &config));
+
+  Context ctx = {0};
+  TRY(map_input_file(config.input_filename, &ctx.input));
+
+  const BenchPhase phases[] = {
+      {.name = "parse", .run = parse, .teardown = unparse},
+      {.name = "solve", .setup = parse, .run = solve, .teardown = unparse},
+  };
+
+  TRY(run_bench(&config, "day_5", phases, sizeof(phases) / sizeof(phases[0]), &ctx));
+
+  TRY(destroy_input_file(&ctx.input));
+
+  return OK;
+}
@@ -19,4 +19,12 @@ do { \
   if(!STAT_is_OK(st)) return LOG_STAT(st, "failed: %s", #x);\
 } while(false)
 
+// for the static inline kernels in the hot loops, their public entry point CHECKs everything once up front,
+// so these only stay in for DEBUG builds (Debug configurations, or the KERNEL_CHECKS cmake option)
+#ifdef DEBUG
+#define KERNEL_CHECK(x) CHECK(x)
+#else
+#define KERNEL_CHECK(x) do { } while(false)
+#endif
+
 #endif
\ No newline at end of file
@@ -0,0 +1,110 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cfac/darray.h>
+#include <cfac/log.h>
+#include <cfac/stat.h>
+
+#include "common.h"
+#include "generator.h"
+#include "lib.h"
+
+// writes an almanac with num_seed_ranges seed ranges and num_map_ranges ranges per map. Like the puzzle input, every map
+// is a permutation of [0, 2^32): the source ranges cover all of it, and the destination ranges are the same ranges in
+// shuffled order.
+
+#define NUMBER_SPACE (((size_t)1) << 32)
+
+static void shuffle(Rng * rng, size_t * values, size_t count) {
+  for(size_t i = count; i > 1; i--) {
+    const size_t j   = get_random_below(rng, i);
+    const size_t tmp = values[i - 1];
+    values[i - 1]    = values[j];
+    values[j]        = tmp;
+  }
+}
+
+static int compare_sizes(const void * a, const void * b) {
+  const size_t lhs = *(const size_t *)a;
+  const size_t rhs = *(const size_t *)b;
+  return (lhs > rhs) - (lhs < rhs);
+}
+
+static STAT_Val write_map(FILE * file, Rng * rng, size_t num_ranges) {
+  // split [0, NUMBER_SPACE) into num_ranges ranges at random points
+  DAR_DArray starts = {0};
+  TRY(DAR_create(&starts, sizeof(size_t)));
+  for(size_t i = 0; i < num_ranges; i++) {
+    const size_t start = (i == 0) ? 0 : get_random_in_range(rng, 1, NUMBER_SPACE - 1);
+    TRY(DAR_push_back(&starts, &start));
+  }
+  qsort(starts.data, starts.size, starts.element_size, compare_sizes);
+
+  const size_t end = NUMBER_SPACE;
+  TRY(DAR_push_back(&starts, &end));
+
+  // lay the same ranges out again in random order to get the destinations
+  DAR_DArray order = {0};
+  TRY(DAR_create(&order, sizeof(size_t)));
+  for(size_t i = 0; i < num_ranges; i++) { TRY(DAR_push_back(&order, &i)); }
+  shuffle(rng, DAR_first(&order), num_ranges);
+
+  DAR_DArray lines = {0};
+  TRY(DAR_create(&lines, sizeof(MapRange)));
+
+  size_t dst_start = 0;
+  for(const size_t * idx = DAR_first(&order); idx != DAR_end(&order); idx++) {
+    const size_t   src_start = *(const size_t *)DAR_get(&starts, *idx);
+    const size_t   length    = *(const size_t *)DAR_get(&starts, *idx + 1) - src_start;
+    const MapRange range     = {.dst_start = dst_start, .src_start = src_start, .length = length};
+    if(length > 0) TRY(DAR_push_back(&lines, &range)); // two split points may coincide
+    dst_start += length;
+  }
+
+  // and write them in yet another random order
+  TRY(DAR_clear(&order));
+  for(size_t i = 0; i < lines.size; i++) { TRY(DAR_push_back(&order, &i)); }
+  shuffle(rng, DAR_first(&order), lines.size);
+
+  for(const size_t * idx = DAR_first(&order); idx != DAR_end(&order); idx++) {
+    const MapRange * range = DAR_get(&lines, *idx);
+    fprintf(file, "%zu %zu %zu\n", range->dst_start, range->src_start, range->length);
+  }
+
+  TRY(DAR_destroy(&lines));
+  TRY(DAR_destroy(&order));
+  TRY(DAR_destroy(&starts));
+
+  return OK;
+}
+
+int main(int argc, char ** argv) {
+  GeneratorConfig config = {.seed = 1, .sizes = {10, 40}};
+  TRY(parse_generator_args(argc, argv, "[num_seed_ranges [num_map_ranges]]", 2, &config));
+
+  const size_t num_seed_ranges = config.sizes[0];
+  const size_t num_map_ranges  = config.sizes[1];
+
+  Rng rng = {0};
+  seed_rng(&rng, config.seed);
+
+  FILE * file = NULL;
+  TRY(open_generator_output(&config, &file));
+
+  fputs("seeds:", file);
+  for(size_t i = 0; i < num_seed_ranges; i++) {
+    const size_t length = get_random_in_range(&rng, 1, NUMBER_SPACE / (8 * num_seed_ranges));
+    const size_t start  = get_random_below(&rng, NUMBER_SPACE - length);
+    fprintf(file, " %zu %zu", start, length);
+  }
+  fputc('\n', file);
+
+  for(MapType type = FIRST_MAP; type <= LAST_MAP; type++) {
+    fprintf(file, "\n%s map:\n", map_type_to_str(type));
+    TRY(write_map(file, &rng, num_map_ranges));
+  }
+
+  TRY(close_generator_output(file));
+
+  return OK;
+}
@@ -0,0 +1,18 @@
+#ifndef input_h
+#define input_h
+
+#include <cfac/darray.h>
+#include <cfac/span.h>
+#include <cfac/stat.h>
+
+typedef struct InputFile {
+  const char * data; // read-only mapping of the whole file
+  size_t       size;
+  DAR_DArray   lines; // contains SPN_Span of char, pointing into data, each including its trailing '\n' (if any)
+} InputFile;
+
+STAT_Val map_input_file(const char * filename, InputFile * input);
+
+STAT_Val destroy_input_file(InputFile * input);
+
+#endif
@@ -2,11 +2,12 @@
 #include <cfac/list.h>
 #include <cfac/log.h>
 
-#include <stdio.h>
 #include <stdlib.h>
 
+#include "cache.h"
 #include "common.h"
 #include "lib.h"
+#include "scan.h"
 
 static STAT_Val init_almanac(Almanac * almanac) {
   CHECK(almanac != NULL);
@@ -18,19 +19,17 @@ static STAT_Val init_almanac(Almanac * almanac) {
   return OK;
 }
 
-static STAT_Val parse_seeds(const DAR_DArray * line, DAR_DArray * seeds) {
-  CHECK(line != NULL);
-  CHECK(line->element_size == sizeof(char));
-  CHECK(DAR_is_initialized(line));
-  CHECK(!DAR_is_empty(line));
+static STAT_Val parse_seeds(SPN_Span line, DAR_DArray * seeds) {
+  CHECK(line.element_size == sizeof(char));
+  CHECK(!SPN_is_empty(line));
   CHECK(seeds != NULL);
   CHECK(DAR_is_initialized(seeds));
   CHECK(DAR_is_empty(seeds));
   CHECK(seeds->element_size == sizeof(size_t));
 
-  CHECK(SPN_contains_subspan(DAR_to_span(line), SPN_from_cstr("seeds: ")));
+  CHECK(SPN_contains_subspan(line, SPN_from_cstr("seeds: ")));
 
-  SPN_Span   remaining = DAR_to_span(line);
+  SPN_Span   remaining = line;
   const char delim     = ' ';
   while(remaining.len > 0) {
     size_t next_delim_idx = 0;
@@ -42,8 +41,11 @@ static STAT_Val parse_seeds(const DAR_DArray * line, DAR_DArray * seeds) {
 
     remaining = SPN_subspan(remaining, next_delim_idx + 1, remaining.len - (next_delim_idx + 1));
 
-    size_t seed = 0;
-    if(sscanf(remaining.begin, "%zu", &seed) != 1) break; // can't find another number, probably means we're finished
+    size_t         seed         = 0;
+    size_t         num_consumed = 0;
+    const STAT_Val scan_st      = scan_size(remaining, &seed, &num_consumed);
+    TRY(scan_st);
+    if(scan_st != STAT_OK) break; // can't find another number, probably means we're finished
 
     TRY(DAR_push_back(seeds, &seed));
   }
@@ -58,7 +60,7 @@ static STAT_Val find_line_containing_subspan(SPN_Span lines_span, SPN_Span subsp
   CHECK(subspan.begin != NULL);
 
   for(size_t i = 0; i < lines_span.len; i++) {
-    SPN_Span line_span = DAR_to_span(SPN_get(lines_span, i));
+    SPN_Span line_span = *(const SPN_Span *)SPN_get(lines_span, i);
     CHECK(line_span.begin != NULL);
     CHECK(line_span.len > 0);
 
@@ -76,7 +78,7 @@ static STAT_Val find_empty_line(SPN_Span lines_span, size_t * idx) {
   CHECK(lines_span.len > 0);
 
   for(size_t i = 0; i < lines_span.len; i++) {
-    SPN_Span line_span = DAR_to_span(SPN_get(lines_span, i));
+    SPN_Span line_span = *(const SPN_Span *)SPN_get(lines_span, i);
     if(line_span.len == 0 || (*(const char *)SPN_first(line_span)) == '\n') {
       *idx = i;
       return OK;
@@ -90,21 +92,15 @@ static STAT_Val parse_map_range(SPN_Span line_span, MapRange * range) {
   CHECK(line_span.len > 0);
   CHECK(range != NULL);
 
-  const char delim = ' ';
+  size_t num_consumed = 0;
 
-  CHECK(sscanf(line_span.begin, "%zu", &range->dst_start) == 1);
+  CHECK(scan_size(line_span, &range->dst_start, &num_consumed) == OK);
+  line_span = SPN_subspan(line_span, num_consumed, line_span.len - num_consumed);
 
-  size_t idx = 0;
+  CHECK(scan_size(line_span, &range->src_start, &num_consumed) == OK);
+  line_span = SPN_subspan(line_span, num_consumed, line_span.len - num_consumed);
 
-  CHECK(SPN_find(line_span, &delim, &idx) == OK);
-  line_span = SPN_subspan(line_span, idx + 1, line_span.len - (idx + 1));
-
-  CHECK(sscanf(line_span.begin, "%zu", &range->src_start) == 1);
-
-  CHECK(SPN_find(line_span, &delim, &idx) == OK);
-  line_span = SPN_subspan(line_span, idx + 1, line_span.len - (idx + 1));
-
-  CHECK(sscanf(line_span.begin, "%zu", &range->length) == 1);
+  CHECK(scan_size(line_span, &range->length, &num_consumed) == OK);
 
   return OK;
 }
@@ -150,10 +146,10 @@ static STAT_Val sort_map_ranges_by_src_start(DAR_DArray * ranges) {
   return OK;
 }
 
-static STAT_Val parse_maps(const DAR_DArray * lines, Almanac * almanac) {
+static STAT_Val parse_maps(const DAR_DArray * lines /* contains SPN_Span */, Almanac * almanac) {
   CHECK(lines != NULL);
   CHECK(almanac != NULL);
-  CHECK(lines->element_size == sizeof(DAR_DArray));
+  CHECK(lines->element_size == sizeof(SPN_Span));
 
   const SPN_Span lines_span = DAR_to_span(lines);
 
@@ -162,10 +158,10 @@ static STAT_Val parse_maps(const DAR_DArray * lines, Almanac * almanac) {
 
     TRY(get_maps_span(lines_span, map_type, &maps_span));
 
-    for(const DAR_DArray * line = SPN_first(maps_span); line != SPN_end(maps_span); line++) {
+    for(const SPN_Span * line = SPN_first(maps_span); line != SPN_end(maps_span); line++) {
       MapRange range = {0};
 
-      TRY(parse_map_range(DAR_to_span(line), &range));
+      TRY(parse_map_range(*line, &range));
       TRY(DAR_push_back(&almanac->maps[map_type], &range));
     }
     TRY(sort_map_ranges_by_src_start(&almanac->maps[map_type]));
@@ -174,20 +170,75 @@ static STAT_Val parse_maps(const DAR_DArray * lines, Almanac * almanac) {
   return OK;
 }
 
-STAT_Val parse_almanac(const DAR_DArray * lines, Almanac * out) {
+STAT_Val parse_almanac(const DAR_DArray * lines /* contains SPN_Span */, Almanac * out) {
   CHECK(lines != NULL);
-  CHECK(lines->element_size == sizeof(DAR_DArray));
+  CHECK(lines->element_size == sizeof(SPN_Span));
   CHECK(DAR_is_initialized(lines));
   CHECK(!DAR_is_empty(lines));
   CHECK(out != NULL);
 
   TRY(init_almanac(out));
-  TRY(parse_seeds(DAR_first(lines), &out->seeds));
+  TRY(parse_seeds(*(const SPN_Span *)DAR_first(lines), &out->seeds));
   TRY(parse_maps(lines, out));
 
   return OK;
 }
 
+static STAT_Val read_almanac_from_cache(CacheReader * reader, Almanac * out) {
+  TRY(init_almanac(out));
+  TRY(read_darray_from_cache(reader, &out->seeds));
+
+  for(MapType type = FIRST_MAP; type <= LAST_MAP; type++) { TRY(read_darray_from_cache(reader, &out->maps[type])); }
+
+  TRY(check_cache_fully_read(reader));
+
+  return OK;
+}
+
+static STAT_Val write_almanac_to_cache(CacheWriter * writer, const Almanac * almanac) {
+  TRY(write_darray_to_cache(writer, &almanac->seeds));
+
+  for(MapType type = FIRST_MAP; type <= LAST_MAP; type++) { TRY(write_darray_to_cache(writer, &almanac->maps[type])); }
+
+  return OK;
+}
+
+STAT_Val parse_almanac_cached(const InputFile * input, Almanac * out) {
+  CHECK(input != NULL);
+  CHECK(out != NULL);
+
+  CacheReader    reader    = {0};
+  const STAT_Val reader_st = open_cache_reader("day_5", input, &reader);
+  TRY(reader_st);
+  if(reader_st == OK) {
+    // a bad entry is still an error, but neither the mapping nor what was read of it so far are left behind
+    const STAT_Val read_st = read_almanac_from_cache(&reader, out);
+    TRY(close_cache_reader(&reader));
+    if(!STAT_is_OK(read_st)) TRY(destroy_almanac(out));
+    TRY(read_st);
+    return OK;
+  }
+
+  TRY(parse_almanac(&input->lines, out));
+
+  CacheWriter    writer    = {0};
+  const STAT_Val writer_st = open_cache_writer("day_5", input, &writer);
+  TRY(writer_st);
+  if(writer_st == OK) {
+    // likewise a failed write drops the partly written entry, and the parsed result with it
+    STAT_Val write_st = write_almanac_to_cache(&writer, out);
+    if(STAT_is_OK(write_st)) {
+      write_st = commit_cache_writer(&writer);
+    } else {
+      TRY(abort_cache_writer(&writer));
+    }
+    if(!STAT_is_OK(write_st)) TRY(destroy_almanac(out));
+    TRY(write_st);
+  }
+
+  return OK;
+}
+
 STAT_Val destroy_almanac(Almanac * almanac) {
   CHECK(almanac != NULL);
 
@@ -198,10 +249,11 @@ STAT_Val destroy_almanac(Almanac * almanac) {
   return OK;
 }
 
-static STAT_Val map_number(size_t num, const DAR_DArray * map_ranges, size_t * out) {
-  CHECK(map_ranges != NULL);
-  CHECK(map_ranges->element_size == sizeof(MapRange));
-  CHECK(out != NULL);
+// kernel, find_lowest_location_number_for_part1 has already checked the maps
+static inline STAT_Val map_number(size_t num, const DAR_DArray * map_ranges, size_t * out) {
+  KERNEL_CHECK(map_ranges != NULL);
+  KERNEL_CHECK(map_ranges->element_size == sizeof(MapRange));
+  KERNEL_CHECK(out != NULL);
 
   for(const MapRange * range = DAR_first(map_ranges); range != DAR_end(map_ranges); range++) {
     if(num >= range->src_start && num < (range->src_start + range->length)) {
@@ -221,6 +273,11 @@ STAT_Val find_lowest_location_number_for_part1(const Almanac * almanac, size_t *
   CHECK(out != NULL);
 
   const DAR_DArray * seeds = &almanac->seeds;
+  CHECK(seeds->element_size == sizeof(size_t));
+
+  for(MapType map_type = FIRST_MAP; map_type <= LAST_MAP; map_type++) {
+    CHECK(almanac->maps[map_type].element_size == sizeof(MapRange));
+  }
 
   size_t lowest = SIZE_MAX;
 
@@ -4,6 +4,8 @@
 #include <cfac/darray.h>
 #include <cfac/stat.h>
 
+#include "input.h"
+
 typedef struct MapRange {
   size_t dst_start;
   size_t src_start;
@@ -41,7 +43,9 @@ typedef struct Almanac {
   DAR_DArray maps[NUM_MAP_TYPES];
 } Almanac;
 
-STAT_Val parse_almanac(const DAR_DArray * lines, Almanac * out);
+STAT_Val parse_almanac(const DAR_DArray * lines /* contains SPN_Span */, Almanac * out);
+// same as parse_almanac, but reuses the parsed almanac from an earlier run when PARSE_CACHE_DIR is set
+STAT_Val parse_almanac_cached(const InputFile * input, Almanac * out);
 STAT_Val destroy_almanac(Almanac * almanac);
 STAT_Val find_lowest_location_number_for_part1(const Almanac * almanac, size_t * out);
 STAT_Val find_lowest_location_number_for_part2(const Almanac * almanac, size_t * out);
@@ -1,6 +1,9 @@
+#include "cache.h"
 #include "lib.h"
+#include "scan.h"
 
 #include <stdlib.h>
+#include <unistd.h>
 
 #include <cfac/test_utils.h>
 
@@ -18,10 +21,9 @@ static Result tst_parse_almanac_basic(void) {
   };
 
   DAR_DArray lines = {0};
-  EXPECT_OK(&r, DAR_create(&lines, sizeof(DAR_DArray)));
+  EXPECT_OK(&r, DAR_create(&lines, sizeof(SPN_Span)));
   for(size_t i = 0; i < sizeof(raw_lines) / sizeof(raw_lines[0]); i++) {
-    DAR_DArray line = {0};
-    EXPECT_OK(&r, DAR_create_from_cstr(&line, raw_lines[i]));
+    const SPN_Span line = SPN_from_cstr(raw_lines[i]);
     EXPECT_OK(&r, DAR_push_back(&lines, &line));
   }
 
@@ -70,7 +72,6 @@ static Result tst_parse_almanac_basic(void) {
 
   EXPECT_OK(&r, destroy_almanac(&almanac));
 
-  for(DAR_DArray * line = DAR_first(&lines); line != DAR_end(&lines); line++) { EXPECT_OK(&r, DAR_destroy(line)); }
   EXPECT_OK(&r, DAR_destroy(&lines));
 
   return r;
@@ -116,10 +117,9 @@ static Result tst_find_lowest_location_part1_example(void) {
   };
 
   DAR_DArray lines = {0};
-  EXPECT_OK(&r, DAR_create(&lines, sizeof(DAR_DArray)));
+  EXPECT_OK(&r, DAR_create(&lines, sizeof(SPN_Span)));
   for(size_t i = 0; i < sizeof(raw_lines) / sizeof(raw_lines[0]); i++) {
-    DAR_DArray line = {0};
-    EXPECT_OK(&r, DAR_create_from_cstr(&line, raw_lines[i]));
+    const SPN_Span line = SPN_from_cstr(raw_lines[i]);
     EXPECT_OK(&r, DAR_push_back(&lines, &line));
   }
 
@@ -134,7 +134,6 @@ static Result tst_find_lowest_location_part1_example(void) {
 
   EXPECT_OK(&r, destroy_almanac(&almanac));
 
-  for(DAR_DArray * line = DAR_first(&lines); line != DAR_end(&lines); line++) { EXPECT_OK(&r, DAR_destroy(line)); }
   EXPECT_OK(&r, DAR_destroy(&lines));
 
   return r;
@@ -180,10 +179,9 @@ static Result tst_find_lowest_location_part2_example(void) {
   };
 
   DAR_DArray lines = {0};
-  EXPECT_OK(&r, DAR_create(&lines, sizeof(DAR_DArray)));
+  EXPECT_OK(&r, DAR_create(&lines, sizeof(SPN_Span)));
   for(size_t i = 0; i < sizeof(raw_lines) / sizeof(raw_lines[0]); i++) {
-    DAR_DArray line = {0};
-    EXPECT_OK(&r, DAR_create_from_cstr(&line, raw_lines[i]));
+    const SPN_Span line = SPN_from_cstr(raw_lines[i]);
     EXPECT_OK(&r, DAR_push_back(&lines, &line));
   }
 
@@ -198,12 +196,133 @@ static Result tst_find_lowest_location_part2_example(void) {
 
   EXPECT_OK(&r, destroy_almanac(&almanac));
 
-  for(DAR_DArray * line = DAR_first(&lines); line != DAR_end(&lines); line++) { EXPECT_OK(&r, DAR_destroy(line)); }
   EXPECT_OK(&r, DAR_destroy(&lines));
 
   return r;
 }
 
+static Result tst_parse_almanac_cached(void) {
+  Result r = PASS;
+
+  const char raw_input[] = "seeds: 79 14 55 13\n"
+                           "\n"
+                           "seed-to-soil map:\n"
+                           "50 98 2\n"
+                           "52 50 48\n"
+                           "\n"
+                           "soil-to-fertilizer map:\n"
+                           "0 15 37\n"
+                           "\n"
+                           "fertilizer-to-water map:\n"
+                           "49 53 8\n"
+                           "\n"
+                           "water-to-light map:\n"
+                           "88 18 7\n"
+                           "\n"
+                           "light-to-temperature map:\n"
+                           "45 77 23\n"
+                           "\n"
+                           "temperature-to-humidity map:\n"
+                           "0 69 1\n"
+                           "\n"
+                           "humidity-to-location map:\n"
+                           "60 56 37\n";
+
+  char dir[]            = "/tmp/day_5_cache_XXXXXX";
+  char input_filename[] = "/tmp/day_5_cache_XXXXXX/input.txt";
+  EXPECT_NE(&r, NULL, mkdtemp(dir));
+  if(HAS_FAILED(&r)) return r;
+  memcpy(input_filename, dir, strlen(dir));
+
+  FILE * file = fopen(input_filename, "w");
+  EXPECT_NE(&r, NULL, file);
+  if(HAS_FAILED(&r)) return r;
+  fputs(raw_input, file);
+  fclose(file);
+
+  InputFile input = {0};
+  EXPECT_OK(&r, map_input_file(input_filename, &input));
+
+  EXPECT_EQ(&r, 0, setenv("PARSE_CACHE_DIR", dir, 1));
+
+  // first run parses and writes the entry, second run reads it back
+  Almanac parsed = {0};
+  Almanac cached = {0};
+  EXPECT_OK(&r, parse_almanac_cached(&input, &parsed));
+  EXPECT_OK(&r, parse_almanac_cached(&input, &cached));
+
+  EXPECT_EQ(&r, parsed.seeds.size, cached.seeds.size);
+  EXPECT_ARREQ(&r, size_t, parsed.seeds.data, cached.seeds.data, parsed.seeds.size);
+  for(MapType type = FIRST_MAP; type <= LAST_MAP; type++) {
+    EXPECT_EQ(&r, parsed.maps[type].size, cached.maps[type].size);
+    EXPECT_ARREQ(&r, MapRange, parsed.maps[type].data, cached.maps[type].data, parsed.maps[type].size);
+  }
+
+  size_t parsed_lowest_location = 0;
+  size_t cached_lowest_location = 0;
+  EXPECT_OK(&r, find_lowest_location_number_for_part1(&parsed, &parsed_lowest_location));
+  EXPECT_OK(&r, find_lowest_location_number_for_part1(&cached, &cached_lowest_location));
+  EXPECT_EQ(&r, parsed_lowest_location, cached_lowest_location);
+
+  char cache_filename[sizeof(dir) + 32] = {0};
+  snprintf(cache_filename,
+           sizeof(cache_filename),
+           "%s/day_5-%016llx.bin",
+           dir,
+           (unsigned long long)hash_input(input.data, input.size));
+
+  // an entry with trailing data is rejected, and nothing read from it is left behind
+  CacheWriter   writer   = {0};
+  const uint8_t trailing = 0;
+  EXPECT_OK(&r, open_cache_writer("day_5", &input, &writer));
+  EXPECT_OK(&r, write_darray_to_cache(&writer, &parsed.seeds));
+  for(MapType type = FIRST_MAP; type <= LAST_MAP; type++) {
+    EXPECT_OK(&r, write_darray_to_cache(&writer, &parsed.maps[type]));
+  }
+  EXPECT_OK(&r, write_to_cache(&writer, &trailing, sizeof(trailing)));
+  EXPECT_OK(&r, commit_cache_writer(&writer));
+
+  Almanac rejected = {0};
+  EXPECT_NE(&r, STAT_OK, parse_almanac_cached(&input, &rejected));
+  EXPECT_FALSE(&r, DAR_is_initialized(&rejected.seeds));
+
+  EXPECT_EQ(&r, 0, unsetenv("PARSE_CACHE_DIR"));
+
+  EXPECT_EQ(&r, 0, unlink(cache_filename));
+  EXPECT_EQ(&r, 0, unlink(input_filename));
+  EXPECT_EQ(&r, 0, rmdir(dir));
+
+  EXPECT_OK(&r, destroy_almanac(&parsed));
+  EXPECT_OK(&r, destroy_almanac(&cached));
+  EXPECT_OK(&r, destroy_input_file(&input));
+
+  return r;
+}
+
+static Result tst_scan_size(void) {
+  Result r = PASS;
+
+  size_t v            = 0;
+  size_t num_consumed = 0;
+
+  EXPECT_EQ(&r, STAT_OK_NOT_FOUND, scan_size(SPN_from_cstr("seeds: 79 14"), &v, &num_consumed));
+  EXPECT_EQ(&r, 0, num_consumed);
+  EXPECT_OK(&r, scan_size(SPN_from_cstr(" 79 14"), &v, &num_consumed));
+  EXPECT_EQ(&r, 79, v);
+  EXPECT_EQ(&r, 3, num_consumed);
+
+  EXPECT_OK(&r, scan_size(SPN_from_cstr("18446744073709551615\n"), &v, &num_consumed));
+  EXPECT_EQ(&r, SIZE_MAX, v);
+  EXPECT_EQ(&r, 20, num_consumed);
+
+  EXPECT_EQ(&r, STAT_ERR_READ, scan_size(SPN_from_cstr("18446744073709551616"), &v, &num_consumed));
+  EXPECT_EQ(&r, STAT_OK_NOT_FOUND, scan_size(SPN_from_cstr("-1"), &v, &num_consumed));
+  EXPECT_EQ(&r, STAT_OK_NOT_FOUND, scan_size(SPN_subspan(SPN_from_cstr("  5"), 0, 2), &v, &num_consumed));
+  EXPECT_EQ(&r, 2, num_consumed);
+
+  return r;
+}
+
 static Result tst_fixture(void * env) {
   Result r = PASS;
 
@@ -217,6 +336,8 @@ int main(void) {
       tst_parse_almanac_basic,
       tst_find_lowest_location_part1_example,
       tst_find_lowest_location_part2_example,
+      tst_parse_almanac_cached,
+      tst_scan_size,
   };
 
   TestWithFixture tests_with_fixture[] = {
@@ -6,56 +6,39 @@
 #include <cfac/stat.h>
 
 #include "common.h"
+#include "input.h"
 #include "lib.h"
-
-static STAT_Val read_lines_from_file(const char * filename, DAR_DArray * lines) {
-  CHECK(lines != NULL);
-  CHECK(DAR_is_initialized(lines));
-
-  FILE * file_ptr = fopen(filename, "r");
-  CHECK(file_ptr != NULL);
-
-  char *  line_raw = NULL;
-  size_t  len      = 0;
-  ssize_t read     = 0;
-
-  while((read = getline(&line_raw, &len, file_ptr)) != -1) {
-    DAR_DArray line = {0};
-    TRY(DAR_create_from_cstr(&line, line_raw));
-    TRY(DAR_push_back(lines, &line));
-  }
-
-  fclose(file_ptr);
-  free(line_raw);
-
-  return OK;
-}
-
-static STAT_Val destroy_lines(DAR_DArray * lines) {
-  CHECK(lines != NULL);
-
-  for(DAR_DArray * p = DAR_first(lines); p != DAR_end(lines); p++) { TRY(DAR_destroy(p)); }
-
-  TRY(DAR_destroy(lines));
-
-  return OK;
-}
+#include "metrics.h"
 
 int main(void) {
-  DAR_DArray lines = {0};
-  TRY(DAR_create(&lines, sizeof(DAR_DArray)));
+  Metrics metrics = {0};
+  start_metrics(&metrics, "day_5");
 
-  TRY(read_lines_from_file("input.txt", &lines));
+  begin_phase(&metrics, PHASE_READ);
+  InputFile input = {0};
+  TRY(map_input_file("input.txt", &input));
+  end_phase(&metrics);
 
   Almanac almanac                   = {0};
   size_t  lowest_location_for_part1 = 0;
   size_t  lowest_location_for_part2 = 0;
-  TRY(parse_almanac(&lines, &almanac));
+
+  begin_phase(&metrics, PHASE_PARSE);
+  TRY(parse_almanac_cached(&input, &almanac));
+  end_phase(&metrics);
+
+  begin_phase(&metrics, PHASE_PART1);
   TRY(find_lowest_location_number_for_part1(&almanac, &lowest_location_for_part1));
+  end_phase(&metrics);
+
+  begin_phase(&metrics, PHASE_PART2);
   TRY(find_lowest_location_number_for_part2(&almanac, &lowest_location_for_part2));
+  end_phase(&metrics);
 
   TRY(destroy_almanac(&almanac));
-  TRY(destroy_lines(&lines));
+  TRY(destroy_input_file(&input));
+
+  TRY(write_metrics(&metrics));
 
   return LOG_STAT(STAT_OK,
                   "lowest_location_for_part1: %zu, lowest_location_for_part_2: %zu",
@@ -0,0 +1,52 @@
+#ifndef metrics_h
+#define metrics_h
+
+#include <cfac/stat.h>
+
+#include <stdint.h>
+
+typedef enum MetricsPhase {
+  PHASE_READ = 0,
+  PHASE_PARSE,
+  PHASE_PART1,
+  PHASE_PART2,
+  NUM_PHASES,
+} MetricsPhase;
+
+typedef struct PhaseMetrics {
+  uint64_t wall_ns;
+  uint64_t num_allocs;
+  uint64_t alloc_bytes;
+} PhaseMetrics;
+
+typedef struct Metrics {
+  const char * name;
+  const char * filename; // from METRICS_FILE, NULL when metrics are disabled and the phase calls do nothing
+  PhaseMetrics phases[NUM_PHASES];
+  MetricsPhase current_phase; // NUM_PHASES when in between phases
+  uint64_t     phase_start_ns;
+  uint64_t     phase_start_num_allocs;
+  uint64_t     phase_start_alloc_bytes;
+  uint64_t     start_ns;
+} Metrics;
+
+// heap allocations made so far by the whole process, counted by the malloc/calloc/realloc wrappers in metrics.c
+typedef struct AllocStats {
+  uint64_t num_allocs;
+  uint64_t alloc_bytes;
+  uint64_t num_frees;
+} AllocStats;
+
+AllocStats get_alloc_stats(void);
+
+void start_metrics(Metrics * metrics, const char * name);
+
+// a phase can be entered several times (e.g. once per line), its time and allocations add up
+void begin_phase(Metrics * metrics, MetricsPhase phase);
+void end_phase(Metrics * metrics);
+
+// writes one JSON object to the file named by the METRICS_FILE environment variable ("-" for stdout), if it was set
+// when the metrics were started
+STAT_Val write_metrics(const Metrics * metrics);
+
+#endif
@@ -0,0 +1,58 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cfac/log.h>
+#include <cfac/stat.h>
+
+#include "benchmark.h"
+#include "common.h"
+#include "lib.h"
+
+// the races are part of the source rather than read from a file, see main.c
+static Race races_arr_part1[] = {
+    {.time = 59, .distance = 597},
+    {.time = 79, .distance = 1234},
+    {.time = 65, .distance = 1032},
+    {.time = 75, .distance = 1328},
+};
+
+static Race races_arr_part2[] = {
+    {.time = 59796575ll, .distance = 597123410321328ll},
+};
+
+typedef struct Context {
+  size_t product_part1;
+  size_t product_part2;
+} Context;
+
+static STAT_Val solve(void * p) {
+  Context * ctx = p;
+
+  const SPN_Span races_part1 = {.begin        = races_arr_part1,
+                                .element_size = sizeof(races_arr_part1[0]),
+                                .len          = sizeof(races_arr_part1) / sizeof(races_arr_part1[0])};
+
+  const SPN_Span races_part2 = {.begin        = races_arr_part2,
+                                .element_size = sizeof(races_arr_part2[0]),
+                                .len          = sizeof(races_arr_part2) / sizeof(races_arr_part2[0])};
+
+  TRY(get_record_beating_input_product(races_part1, &ctx->product_part1));
+  TRY(get_record_beating_input_product(races_part2, &ctx->product_part2));
+
+  return OK;
+}
+
+int main(int argc, char ** argv) {
+  BenchConfig config = {0};
+  TRY(parse_bench_args(argc, argv, &config));
+
+  Context ctx = {0};
+
+  const BenchPhase phases[] = {
+      {.name = "solve", .run = solve},
+  };
+
+  TRY(run_bench(&config, "day_6", phases, sizeof(phases) / sizeof(phases[0]), &ctx));
+
+  return OK;
+}
@@ -5,8 +5,12 @@
 
 #include "common.h"
 #include "lib.h"
+#include "metrics.h"
 
 int main(void) {
+  Metrics metrics = {0};
+  start_metrics(&metrics, "day_6");
+
   Race races_arr_part1[] = {
       {.time = 59, .distance = 597},
       {.time = 79, .distance = 1234},
@@ -26,11 +30,17 @@ int main(void) {
                           .element_size = sizeof(races_arr_part2[0]),
                           .len          = sizeof(races_arr_part2) / sizeof(races_arr_part2[0])};
 
+  begin_phase(&metrics, PHASE_PART1);
   size_t product_part1 = 0;
   TRY(get_record_beating_input_product(races_part1, &product_part1));
+  end_phase(&metrics);
 
+  begin_phase(&metrics, PHASE_PART2);
   size_t product_part2 = 0;
   TRY(get_record_beating_input_product(races_part2, &product_part2));
+  end_phase(&metrics);
+
+  TRY(write_metrics(&metrics));
 
   return LOG_STAT(OK, "product_part1 = %zu, product_part2 = %zu", product_part1, product_part2);
 }
\ No newline at end of file
@@ -0,0 +1,64 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cfac/darray.h>
+#include <cfac/log.h>
+#include <cfac/stat.h>
+
+#include "common.h"
+#include "driver.h"
+#include "input.h"
+#include "lib.h"
+
+static STAT_Val solve_input(const InputFile * input, char * result, size_t result_size) {
+  DAR_DArray hands_part1 = {0};
+  DAR_DArray hands_part2 = {0};
+  TRY(DAR_create(&hands_part1, sizeof(Hand)));
+  TRY(DAR_create(&hands_part2, sizeof(Hand)));
+
+  TRY(parse_hands_part1(&input->lines, &hands_part1));
+  TRY(parse_hands_part2(&input->lines, &hands_part2));
+
+  size_t total_winnings_part1 = 0;
+  size_t total_winnings_part2 = 0;
+  TRY(get_total_winnings(DAR_to_mut_span(&hands_part1), &total_winnings_part1));
+  TRY(get_total_winnings(DAR_to_mut_span(&hands_part2), &total_winnings_part2));
+
+  TRY(DAR_destroy(&hands_part1));
+  TRY(DAR_destroy(&hands_part2));
+
+  snprintf(result,
+           result_size,
+           "total_winnings_part1: %zu, total_winnings_part2: %zu",
+           total_winnings_part1,
+           total_winnings_part2);
+
+  return OK;
+}
+
+static STAT_Val solve_file(const char * filename, char * result, size_t result_size) {
+  InputFile input = {0};
+  TRY(map_input_file(filename, &input));
+
+  // the mapping is released whether or not the input could be solved
+  const STAT_Val solve_st = solve_input(&input, result, result_size);
+  TRY(destroy_input_file(&input));
+  TRY(solve_st);
+
+  return OK;
+}
+
+int main(int argc, char ** argv) {
+  BatchConfig config = {0};
+  TRY(parse_batch_args(argc, argv, &config));
+
+  size_t num_failed = 0;
+  TRY(run_batch(&config, solve_file, &num_failed));
+
+  const size_t num_files = config.input_filenames.size;
+  TRY(destroy_batch_config(&config));
+
+  if(num_failed > 0) return LOG_STAT(STAT_ERR_INTERNAL, "failed to solve %zu of %zu files", num_failed, num_files);
+
+  return OK;
+}
@@ -0,0 +1,64 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cfac/darray.h>
+#include <cfac/log.h>
+#include <cfac/stat.h>
+
+#include "benchmark.h"
+#include "common.h"
+#include "input.h"
+#include "lib.h"
+
+typedef struct Context {
+  InputFile  input;
+  DAR_DArray hands_part1; // contains Hand
+  DAR_DArray hands_part2; // contains Hand
+  size_t     total_winnings_part1;
+  size_t     total_winnings_part2;
+} Context;
+
+static STAT_Val parse(void * p) {
+  Context * ctx = p;
+  TRY(parse_hands_part1(&ctx->input.lines, &ctx->hands_part1));
+  TRY(parse_hands_part2(&ctx->input.lines, &ctx->hands_part2));
+  return OK;
+}
+
+static STAT_Val unparse(void * p) {
+  Context * ctx = p;
+  TRY(DAR_clear(&ctx->hands_part1));
+  TRY(DAR_clear(&ctx->hands_part2));
+  return OK;
+}
+
+static STAT_Val solve(void * p) {
+  Context * ctx = p;
+  TRY(get_total_winnings(DAR_to_mut_span(&ctx->hands_part1), &ctx->total_winnings_part1));
+  TRY(get_total_winnings(DAR_to_mut_span(&ctx->hands_part2), &ctx->total_winnings_part2));
+  return OK;
+}
+
+int main(int argc, char ** argv) {
+  BenchConfig config = {0};
+  TRY(parse_bench_args(argc, argv, &config));
+
+  Context ctx = {0};
+  TRY(map_input_file(config.input_filename, &ctx.input));
+  TRY(DAR_create(&ctx.hands_part1, sizeof(Hand)));
+  TRY(DAR_create(&ctx.hands_part2, sizeof(Hand)));
+
+  // solving sorts the hands in place, so each run gets freshly parsed (unsorted) hands
+  const BenchPhase phases[] = {
+      {.name = "parse", .run = parse, .teardown = unparse},
+      {.name = "solve", .setup = parse, .run = solve, .teardown = unparse},
+  };
+
+  TRY(run_bench(&config, "day_7", phases, sizeof(phases) / sizeof(phases[0]), &ctx));
+
+  TRY(DAR_destroy(&ctx.hands_part1));
+  TRY(DAR_destroy(&ctx.hands_part2));
+  TRY(destroy_input_file(&ctx.input));
+
+  return OK;
+}
@@ -0,0 +1,34 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cfac/log.h>
+#include <cfac/stat.h>
+
+#include "common.h"
+#include "generator.h"
+
+// writes num_hands hands of five random cards, each with a bid between 1 and 1000
+
+static const char cards[] = "23456789TJQKA";
+
+int main(int argc, char ** argv) {
+  GeneratorConfig config = {.seed = 1, .sizes = {1000}};
+  TRY(parse_generator_args(argc, argv, "[num_hands]", 1, &config));
+
+  const size_t num_hands = config.sizes[0];
+
+  Rng rng = {0};
+  seed_rng(&rng, config.seed);
+
+  FILE * file = NULL;
+  TRY(open_generator_output(&config, &file));
+
+  for(size_t i = 0; i < num_hands; i++) {
+    for(size_t c = 0; c < 5; c++) { fputc(cards[get_random_below(&rng, sizeof(cards) - 1)], file); }
+    fprintf(file, " %zu\n", get_random_in_range(&rng, 1, 1000));
+  }
+
+  TRY(close_generator_output(file));
+
+  return OK;
+}
@@ -3,8 +3,8 @@
 
 #include "common.h"
 #include "lib.h"
+#include "scan.h"
 
-#include <stdio.h>
 #include <stdlib.h>
 
 static Card char_to_card(char c) {
@@ -35,7 +35,8 @@ Hand parse_hand(SPN_Span line) {
 
   SPN_Span bid_span = SPN_subspan(line, 6, (line.len - 6));
 
-  if(sscanf(bid_span.begin, "%zu", &hand.bid) != 1) {
+  size_t num_consumed = 0;
+  if(scan_size(bid_span, &hand.bid, &num_consumed) != STAT_OK) {
     LOG_STAT(STAT_ERR_ARGS, "no bid found in input: '%.*s'", line.len, line.begin);
   }
 
@@ -130,32 +131,36 @@ STAT_Val sort_hands_by_rank(SPN_MutSpan hands) {
   return OK;
 }
 
-STAT_Val parse_hands_part1(const DAR_DArray * lines, DAR_DArray * hands) {
+STAT_Val parse_hands_part1(const DAR_DArray * lines /* contains SPN_Span */, DAR_DArray * hands) {
   CHECK(lines != NULL);
   CHECK(DAR_is_initialized(lines));
   CHECK(!DAR_is_empty(lines));
-  CHECK(lines->element_size == sizeof(DAR_DArray));
+  CHECK(lines->element_size == sizeof(SPN_Span));
   CHECK(hands != NULL);
   CHECK(DAR_is_initialized(hands));
   CHECK(DAR_is_empty(hands));
   CHECK(hands->element_size == sizeof(Hand));
 
-  for(const DAR_DArray * line = DAR_first(lines); line != DAR_end(lines); line++) {
-    Hand hand = parse_hand(DAR_to_span(line));
+  for(const SPN_Span * line = DAR_first(lines); line != DAR_end(lines); line++) {
+    Hand hand = parse_hand(*line);
     TRY(DAR_push_back(hands, &hand));
   }
 
   return OK;
 }
 
-STAT_Val parse_hands_part2(const DAR_DArray * lines, DAR_DArray * hands) {
+Hand replace_jacks_by_jokers(Hand hand) {
+  for(size_t i = 0; i < HAND_SIZE; i++) {
+    if(hand.cards[i] == JACK) hand.cards[i] = JOKER;
+  }
+
+  return hand;
+}
+
+STAT_Val parse_hands_part2(const DAR_DArray * lines /* contains SPN_Span */, DAR_DArray * hands) {
   TRY(parse_hands_part1(lines, hands));
 
-  for(Hand * hand = DAR_first(hands); hand != DAR_end(hands); hand++) {
-    for(size_t i = 0; i < HAND_SIZE; i++) {
-      if(hand->cards[i] == JACK) hand->cards[i] = JOKER;
-    }
-  }
+  for(Hand * hand = DAR_first(hands); hand != DAR_end(hands); hand++) { *hand = replace_jacks_by_jokers(*hand); }
 
   return OK;
 }
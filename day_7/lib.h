@@ -44,6 +44,8 @@ typedef enum HandType {
 
 Hand parse_hand(SPN_Span line);
 
+Hand replace_jacks_by_jokers(Hand hand);
+
 HandType get_hand_type(Hand hand);
 
 int compare_hands(Hand a, Hand b);
@@ -52,9 +54,9 @@ static inline bool hand_equals(Hand a, Hand b) { return compare_hands(a, b) == 0
 
 STAT_Val sort_hands_by_rank(SPN_MutSpan hands);
 
-STAT_Val parse_hands_part1(const DAR_DArray * lines, DAR_DArray * hands);
+STAT_Val parse_hands_part1(const DAR_DArray * lines /* contains SPN_Span */, DAR_DArray * hands);
 
-STAT_Val parse_hands_part2(const DAR_DArray * lines, DAR_DArray * hands);
+STAT_Val parse_hands_part2(const DAR_DArray * lines /* contains SPN_Span */, DAR_DArray * hands);
 
 STAT_Val get_total_winnings(SPN_MutSpan hands, size_t * out);
 
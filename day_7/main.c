@@ -6,64 +6,63 @@
 #include <cfac/stat.h>
 
 #include "common.h"
+#include "input.h"
 #include "lib.h"
+#include "metrics.h"
 
-static STAT_Val read_lines_from_file(const char * filename, DAR_DArray * lines) {
-  CHECK(lines != NULL);
-  CHECK(DAR_is_initialized(lines));
+int main(int argc, char ** argv) {
+  const char * filename = (argc > 1) ? argv[1] : "input.txt"; // "-" reads from stdin
 
-  FILE * file_ptr = fopen(filename, "r");
-  CHECK(file_ptr != NULL);
+  Metrics metrics = {0};
+  start_metrics(&metrics, "day_7");
 
-  char *  line_raw = NULL;
-  size_t  len      = 0;
-  ssize_t read     = 0;
-
-  while((read = getline(&line_raw, &len, file_ptr)) != -1) {
-    DAR_DArray line = {0};
-    TRY(DAR_create_from_cstr(&line, line_raw));
-    TRY(DAR_push_back(lines, &line));
-  }
-
-  fclose(file_ptr);
-  free(line_raw);
-
-  return OK;
-}
-
-static STAT_Val destroy_lines(DAR_DArray * lines) {
-  CHECK(lines != NULL);
-
-  for(DAR_DArray * p = DAR_first(lines); p != DAR_end(lines); p++) { TRY(DAR_destroy(p)); }
-
-  TRY(DAR_destroy(lines));
-
-  return OK;
-}
-
-int main(void) {
-  DAR_DArray lines = {0};
-  TRY(DAR_create(&lines, sizeof(DAR_DArray)));
-
-  TRY(read_lines_from_file("input.txt", &lines));
+  LineReader reader = {0};
+  begin_phase(&metrics, PHASE_READ);
+  TRY(open_line_reader(filename, &reader));
+  end_phase(&metrics);
 
   size_t total_winnings_part1 = 0;
   size_t total_winnings_part2 = 0;
 
+  // ranking needs all hands, but they are small, so the lines themselves are not kept around
   DAR_DArray hands_part1 = {0};
   DAR_DArray hands_part2 = {0};
   TRY(DAR_create(&hands_part1, sizeof(Hand)));
   TRY(DAR_create(&hands_part2, sizeof(Hand)));
 
-  TRY(parse_hands_part1(&lines, &hands_part1));
-  TRY(parse_hands_part2(&lines, &hands_part2));
+  SPN_Span line    = {0};
+  STAT_Val read_st = OK;
+  begin_phase(&metrics, PHASE_READ);
+  while((read_st = read_next_line(&reader, &line)) == OK) {
+    end_phase(&metrics);
+
+    begin_phase(&metrics, PHASE_PARSE);
+    const Hand hand = parse_hand(line);
+    TRY(DAR_push_back(&hands_part1, &hand));
 
+    const Hand hand_with_jokers = replace_jacks_by_jokers(hand);
+    TRY(DAR_push_back(&hands_part2, &hand_with_jokers));
+    end_phase(&metrics);
+
+    begin_phase(&metrics, PHASE_READ);
+  }
+  end_phase(&metrics);
+  TRY(read_st);
+
+  TRY(close_line_reader(&reader));
+
+  begin_phase(&metrics, PHASE_PART1);
   TRY(get_total_winnings(DAR_to_mut_span(&hands_part1), &total_winnings_part1));
+  end_phase(&metrics);
+
+  begin_phase(&metrics, PHASE_PART2);
   TRY(get_total_winnings(DAR_to_mut_span(&hands_part2), &total_winnings_part2));
+  end_phase(&metrics);
 
   TRY(DAR_destroy(&hands_part1));
   TRY(DAR_destroy(&hands_part2));
-  TRY(destroy_lines(&lines));
+
+  TRY(write_metrics(&metrics));
 
   return LOG_STAT(STAT_OK,
                   "total_winnings_part1: %zu, total_winnings_part2: %zu",
@@ -0,0 +1,65 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cfac/darray.h>
+#include <cfac/log.h>
+#include <cfac/stat.h>
+
+#include "common.h"
+#include "driver.h"
+#include "input.h"
+#include "lib.h"
+
+static STAT_Val solve_input(const InputFile * input, char * result, size_t result_size) {
+  CHECK(input->lines.size > 2);
+
+  DAR_DArray input_seq = {0};
+  TRY(DAR_create(&input_seq, sizeof(TransitionType)));
+  TRY(parse_input_sequence(*(const SPN_Span *)DAR_first(&input->lines), &input_seq));
+
+  StateMachine machine = {0};
+  TRY(parse_state_machine_cached(input, SPN_subspan(DAR_to_span(&input->lines), 2, input->lines.size - 2), &machine));
+
+  size_t number_of_steps_part1 = 0;
+  size_t number_of_steps_part2 = 0;
+  TRY(get_number_of_steps_for_input_on_state_machine_part1(&machine, DAR_to_span(&input_seq), &number_of_steps_part1));
+  TRY(get_number_of_steps_for_input_on_state_machine_part2(&machine, DAR_to_span(&input_seq), &number_of_steps_part2));
+
+  TRY(destroy_state_machine(&machine));
+  TRY(DAR_destroy(&input_seq));
+
+  snprintf(result,
+           result_size,
+           "number_of_steps_part1: %zu, number_of_steps_part2: %zu",
+           number_of_steps_part1,
+           number_of_steps_part2);
+
+  return OK;
+}
+
+static STAT_Val solve_file(const char * filename, char * result, size_t result_size) {
+  InputFile input = {0};
+  TRY(map_input_file(filename, &input));
+
+  // the mapping is released whether or not the input could be solved
+  const STAT_Val solve_st = solve_input(&input, result, result_size);
+  TRY(destroy_input_file(&input));
+  TRY(solve_st);
+
+  return OK;
+}
+
+int main(int argc, char ** argv) {
+  BatchConfig config = {0};
+  TRY(parse_batch_args(argc, argv, &config));
+
+  size_t num_failed = 0;
+  TRY(run_batch(&config, solve_file, &num_failed));
+
+  const size_t num_files = config.input_filenames.size;
+  TRY(destroy_batch_config(&config));
+
+  if(num_failed > 0) return LOG_STAT(STAT_ERR_INTERNAL, "failed to solve %zu of %zu files", num_failed, num_files);
+
+  return OK;
+}
@@ -0,0 +1,64 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cfac/darray.h>
+#include <cfac/log.h>
+#include <cfac/stat.h>
+
+#include "benchmark.h"
+#include "common.h"
+#include "input.h"
+#include "lib.h"
+
+typedef struct Context {
+  InputFile    input;
+  DAR_DArray   input_seq; // contains TransitionType
+  StateMachine machine;
+  size_t       number_of_steps_part1;
+  size_t       number_of_steps_part2;
+} Context;
+
+static STAT_Val parse(void * p) {
+  Context * ctx = p;
+  TRY(parse_input_sequence(*(const SPN_Span *)DAR_first(&ctx->input.lines), &ctx->input_seq));
+  TRY(parse_state_machine(SPN_subspan(DAR_to_span(&ctx->input.lines), 2, ctx->input.lines.size - 2), &ctx->machine));
+  return OK;
+}
+
+static STAT_Val unparse(void * p) {
+  Context * ctx = p;
+  TRY(destroy_state_machine(&ctx->machine));
+  TRY(DAR_clear(&ctx->input_seq));
+  return OK;
+}
+
+static STAT_Val solve(void * p) {
+  Context * ctx = p;
+
+  const SPN_Span input_seq = DAR_to_span(&ctx->input_seq);
+  TRY(get_number_of_steps_for_input_on_state_machine_part1(&ctx->machine, input_seq, &ctx->number_of_steps_part1));
+  TRY(get_number_of_steps_for_input_on_state_machine_part2(&ctx->machine, input_seq, &ctx->number_of_steps_part2));
+
+  return OK;
+}
+
+int main(int argc, char ** argv) {
+  BenchConfig config = {0};
+  TRY(parse_bench_args(argc, argv, &config));
+
+  Context ctx = {0};
+  TRY(map_input_file(config.input_filename, &ctx.input));
+  TRY(DAR_create(&ctx.input_seq, sizeof(TransitionType)));
+
+  const BenchPhase phases[] = {
+      {.name = "parse", .run = parse, .teardown = unparse},
+      {.name = "solve", .setup = parse, .run = solve, .teardown = unparse},
+  };
+
+  TRY(run_bench(&config, "day_8", phases, sizeof(phases) / sizeof(phases[0]), &ctx));
+
+  TRY(DAR_destroy(&ctx.input_seq));
+  TRY(destroy_input_file(&ctx.input));
+
+  return OK;
+}
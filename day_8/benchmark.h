@@ -0,0 +1,45 @@
+#ifndef benchmark_h
+#define benchmark_h
+
+#include <cfac/stat.h>
+
+#include <stdint.h>
+#include <stdio.h>
+
+typedef struct BenchConfig {
+  const char * input_filename;
+  const char * output_filename; // NULL writes to stdout
+  size_t       num_warmups;
+  size_t       num_iterations;
+} BenchConfig;
+
+typedef STAT_Val (*BenchFn)(void * context);
+
+typedef struct BenchPhase {
+  const char * name;
+  BenchFn      setup;    // untimed, before each run, may be NULL
+  BenchFn      run;      // timed
+  BenchFn      teardown; // untimed, after each run, may be NULL
+} BenchPhase;
+
+typedef struct BenchStats {
+  uint64_t min_ns;
+  uint64_t median_ns;
+  uint64_t p99_ns;
+} BenchStats;
+
+uint64_t get_monotonic_time_ns(void);
+
+// usage: bench [-w num_warmups] [-n num_iterations] [-o output.json] [input_file]
+STAT_Val parse_bench_args(int argc, char ** argv, BenchConfig * config);
+
+STAT_Val get_bench_stats(uint64_t * samples_ns, size_t num_samples, BenchStats * stats); // sorts samples in place
+
+// runs every phase for the configured warmups and iterations, then writes the results as a single JSON object
+STAT_Val run_bench(const BenchConfig * config,
+                   const char *        name,
+                   const BenchPhase *  phases,
+                   size_t              num_phases,
+                   void *              context);
+
+#endif
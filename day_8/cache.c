@@ -0,0 +1,285 @@
+#include <cfac/log.h>
+
+#include "cache.h"
+#include "common.h"
+
+#include <fcntl.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+typedef struct CacheHeader {
+  char     magic[4];
+  uint32_t version;
+  uint64_t input_hash;
+  uint64_t input_size; // guards against hash collisions between inputs of different sizes
+  uint64_t payload_size;
+} CacheHeader;
+
+static const char g_cache_magic[4] = {'P', 'C', 'A', 'C'};
+
+uint64_t hash_input(const char * data, size_t size) {
+  // 64-bit FNV-1a
+  uint64_t hash = 0xcbf29ce484222325ull;
+  for(size_t i = 0; i < size; i++) {
+    hash ^= (uint8_t)data[i];
+    hash *= 0x100000001b3ull;
+  }
+  return hash;
+}
+
+static CacheHeader make_header(uint64_t input_hash, uint64_t input_size, uint64_t payload_size) {
+  CacheHeader header = {
+      .version      = CACHE_FORMAT_VERSION,
+      .input_hash   = input_hash,
+      .input_size   = input_size,
+      .payload_size = payload_size,
+  };
+  memcpy(header.magic, g_cache_magic, sizeof(header.magic));
+  return header;
+}
+
+// returns NULL if caching is off
+static const char * get_cache_dir(void) {
+  const char * dir = getenv("PARSE_CACHE_DIR");
+  return (dir == NULL || dir[0] == '\0') ? NULL : dir;
+}
+
+static STAT_Val get_cache_filename(const char * dir,
+                                   const char * name,
+                                   uint64_t     input_hash,
+                                   char *       filename,
+                                   size_t       filename_size) {
+  const int len =
+      snprintf(filename, filename_size, "%s/%s-%016llx.bin", dir, name, (unsigned long long)input_hash);
+  if(len < 0 || (size_t)len >= filename_size) return LOG_STAT(STAT_ERR_ARGS, "cache directory name is too long");
+
+  return OK;
+}
+
+STAT_Val open_cache_reader(const char * name, const InputFile * input, CacheReader * reader) {
+  CHECK(name != NULL);
+  CHECK(input != NULL);
+  CHECK(reader != NULL);
+
+  *reader = (CacheReader){0};
+
+  const char * dir = get_cache_dir();
+  if(dir == NULL) return STAT_OK_NOT_FOUND;
+
+  // one pass over the input, shared by the entry name and the header check
+  const uint64_t input_hash = hash_input(input->data, input->size);
+
+  char filename[PATH_MAX] = {0};
+  TRY(get_cache_filename(dir, name, input_hash, filename, sizeof(filename)));
+
+  const int fd = open(filename, O_RDONLY);
+  if(fd < 0) return STAT_OK_NOT_FOUND; // first run on this input
+
+  struct stat file_stat = {0};
+  if(fstat(fd, &file_stat) != 0 || (size_t)file_stat.st_size < sizeof(CacheHeader)) {
+    close(fd);
+    LOG_STAT(STAT_ERR_READ, "ignoring unreadable cache entry '%s'", filename);
+    return STAT_OK_NOT_FOUND;
+  }
+
+  const size_t size = (size_t)file_stat.st_size;
+  void *       data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd); // the mapping keeps its own reference to the file
+
+  if(data == MAP_FAILED) {
+    LOG_STAT(STAT_ERR_READ, "ignoring cache entry '%s' that failed to map", filename);
+    return STAT_OK_NOT_FOUND;
+  }
+
+  CacheHeader header = {0};
+  memcpy(&header, data, sizeof(header));
+
+  const CacheHeader expected = make_header(input_hash, input->size, size - sizeof(CacheHeader));
+  if(memcmp(&header, &expected, sizeof(header)) != 0) {
+    munmap(data, size);
+    LOG_STAT(STAT_ERR_READ, "ignoring stale or truncated cache entry '%s'", filename);
+    return STAT_OK_NOT_FOUND;
+  }
+
+  reader->data = data;
+  reader->size = size;
+  reader->pos  = sizeof(CacheHeader);
+
+  return OK;
+}
+
+STAT_Val read_from_cache(CacheReader * reader, void * dst, size_t size) {
+  CHECK(dst != NULL || size == 0);
+
+  const void * view = NULL;
+  TRY(view_from_cache(reader, size, &view));
+  if(size > 0) memcpy(dst, view, size);
+
+  return OK;
+}
+
+STAT_Val view_from_cache(CacheReader * reader, size_t size, const void ** view) {
+  CHECK(reader != NULL);
+  CHECK(reader->data != NULL);
+  CHECK(view != NULL);
+
+  if(size > reader->size - reader->pos) return LOG_STAT(STAT_ERR_READ, "cache entry ends early");
+
+  *view = &reader->data[reader->pos];
+  reader->pos += size;
+
+  return OK;
+}
+
+STAT_Val read_darray_from_cache(CacheReader * reader, DAR_DArray * array) {
+  CHECK(array != NULL);
+  CHECK(DAR_is_initialized(array));
+  CHECK(DAR_is_empty(array));
+
+  uint64_t element_size = 0;
+  uint64_t num_elements = 0;
+  TRY(read_from_cache(reader, &element_size, sizeof(element_size)));
+  TRY(read_from_cache(reader, &num_elements, sizeof(num_elements)));
+  CHECK(element_size == array->element_size);
+
+  if(num_elements > (reader->size - reader->pos) / element_size) {
+    return LOG_STAT(STAT_ERR_READ, "cache entry ends early");
+  }
+
+  // straight from the mapping into the array, no intermediate copy
+  const void * elements = NULL;
+  TRY(view_from_cache(reader, num_elements * element_size, &elements));
+  TRY(DAR_push_back_array(array, elements, num_elements));
+
+  return OK;
+}
+
+STAT_Val check_cache_fully_read(const CacheReader * reader) {
+  CHECK(reader != NULL);
+
+  if(reader->pos != reader->size) return LOG_STAT(STAT_ERR_READ, "cache entry has trailing data");
+
+  return OK;
+}
+
+STAT_Val close_cache_reader(CacheReader * reader) {
+  CHECK(reader != NULL);
+
+  if(reader->data != NULL) CHECK(munmap((void *)reader->data, reader->size) == 0);
+
+  *reader = (CacheReader){0};
+
+  return OK;
+}
+
+STAT_Val open_cache_writer(const char * name, const InputFile * input, CacheWriter * writer) {
+  CHECK(name != NULL);
+  CHECK(input != NULL);
+  CHECK(writer != NULL);
+
+  *writer = (CacheWriter){0};
+
+  const char * dir = get_cache_dir();
+  if(dir == NULL) return STAT_OK_NOT_FOUND;
+
+  const uint64_t input_hash = hash_input(input->data, input->size);
+  TRY(get_cache_filename(dir, name, input_hash, writer->filename, sizeof(writer->filename)));
+
+  // unique per writer, since batch workers may write the entry for identical inputs at the same time
+  const int len = snprintf(writer->tmp_filename, sizeof(writer->tmp_filename), "%s.XXXXXX", writer->filename);
+  if(len < 0 || (size_t)len >= sizeof(writer->tmp_filename)) {
+    return LOG_STAT(STAT_ERR_ARGS, "cache directory name is too long");
+  }
+
+  const int fd = mkstemp(writer->tmp_filename);
+  if(fd < 0) {
+    LOG_STAT(STAT_ERR_ARGS, "not caching, failed to create '%s'", writer->tmp_filename);
+    return STAT_OK_NOT_FOUND;
+  }
+
+  writer->file = fdopen(fd, "wb");
+  if(writer->file == NULL) {
+    close(fd);
+    unlink(writer->tmp_filename);
+    return LOG_STAT(STAT_ERR_INTERNAL, "failed to open '%s'", writer->tmp_filename);
+  }
+
+  // the payload size is filled in once it is known
+  const CacheHeader header    = make_header(input_hash, input->size, 0);
+  const STAT_Val    header_st = write_to_cache(writer, &header, sizeof(header));
+  if(!STAT_is_OK(header_st)) TRY(abort_cache_writer(writer));
+  TRY(header_st);
+
+  return OK;
+}
+
+STAT_Val write_to_cache(CacheWriter * writer, const void * src, size_t size) {
+  CHECK(writer != NULL);
+  CHECK(writer->file != NULL);
+  CHECK(src != NULL || size == 0);
+
+  if(size > 0 && fwrite(src, 1, size, writer->file) != size) {
+    return LOG_STAT(STAT_ERR_INTERNAL, "failed to write '%s'", writer->tmp_filename);
+  }
+
+  return OK;
+}
+
+STAT_Val write_darray_to_cache(CacheWriter * writer, const DAR_DArray * array) {
+  CHECK(array != NULL);
+  CHECK(DAR_is_initialized(array));
+
+  const uint64_t element_size = array->element_size;
+  const uint64_t num_elements = array->size;
+  TRY(write_to_cache(writer, &element_size, sizeof(element_size)));
+  TRY(write_to_cache(writer, &num_elements, sizeof(num_elements)));
+  TRY(write_to_cache(writer, array->data, array->size * array->element_size));
+
+  return OK;
+}
+
+// the header is written with a zero payload size, which is filled in here once the payload is done
+static STAT_Val write_payload_size(CacheWriter * writer) {
+  const long end = ftell(writer->file);
+  CHECK(end >= (long)sizeof(CacheHeader));
+
+  const uint64_t payload_size = (uint64_t)end - sizeof(CacheHeader);
+  CHECK(fseek(writer->file, offsetof(CacheHeader, payload_size), SEEK_SET) == 0);
+  TRY(write_to_cache(writer, &payload_size, sizeof(payload_size)));
+
+  return OK;
+}
+
+STAT_Val commit_cache_writer(CacheWriter * writer) {
+  CHECK(writer != NULL);
+  CHECK(writer->file != NULL);
+
+  const STAT_Val payload_st = write_payload_size(writer);
+  if(!STAT_is_OK(payload_st)) TRY(abort_cache_writer(writer));
+  TRY(payload_st);
+
+  const bool is_written = (fclose(writer->file) == 0);
+  writer->file          = NULL;
+
+  if(!is_written || rename(writer->tmp_filename, writer->filename) != 0) {
+    unlink(writer->tmp_filename);
+    return LOG_STAT(STAT_ERR_INTERNAL, "failed to write cache entry '%s'", writer->filename);
+  }
+
+  return OK;
+}
+
+STAT_Val abort_cache_writer(CacheWriter * writer) {
+  CHECK(writer != NULL);
+
+  if(writer->file != NULL) fclose(writer->file);
+  writer->file = NULL;
+
+  unlink(writer->tmp_filename);
+
+  return OK;
+}
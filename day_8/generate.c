@@ -0,0 +1,163 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cfac/darray.h>
+#include <cfac/log.h>
+#include <cfac/stat.h>
+
+#include "common.h"
+#include "generator.h"
+
+#include <stdbool.h>
+
+// writes random instructions of instruction_length steps and a network of about num_nodes nodes, for six ghosts. Each
+// ghost (the first one being AAA -> ZZZ) walks a loop of instruction_length * p nodes, for a distinct prime p, that
+// contains its end node once. Every node in a loop is visited at only one position in the instructions, its exit for
+// that instruction leads on through the loop and its other exit leads anywhere. So like in the puzzle input, a ghost is
+// at its end node exactly every (instruction_length * p) steps, and the answer to part 2 is the product of all those.
+// Names have three letters, which caps the network at about 16k nodes.
+
+#define NUM_GHOSTS        6
+#define NUM_INNER_LETTERS 24 // the last letter of nodes that are neither start nor end node, B to Y
+#define MAX_NUM_NODES     (NUM_INNER_LETTERS * 26 * 26)
+
+typedef struct Node {
+  char   name[4];
+  size_t exits[2]; // left, right
+} Node;
+
+static bool is_prime(size_t n) {
+  if(n < 2) return false;
+  for(size_t d = 2; d * d <= n; d++) {
+    if(n % d == 0) return false;
+  }
+  return true;
+}
+
+static size_t get_next_prime(size_t n) {
+  while(!is_prime(n)) n++;
+  return n;
+}
+
+static void get_loop_primes(size_t num_loop_nodes, size_t instruction_length, size_t * primes) {
+  // the smallest run of consecutive primes that makes for at least the requested number of nodes
+  for(size_t first = 2;; first = get_next_prime(first + 1)) {
+    size_t sum = 0;
+    size_t p   = first;
+    for(size_t i = 0; i < NUM_GHOSTS; i++, p = get_next_prime(p + 1)) {
+      primes[i] = p;
+      sum += p;
+    }
+    if(sum * instruction_length >= num_loop_nodes) return;
+  }
+}
+
+static void set_name(Node * node, char first, char second, char last) {
+  node->name[0] = first;
+  node->name[1] = second;
+  node->name[2] = last;
+  node->name[3] = '\0';
+}
+
+static void set_inner_name(Node * node, size_t idx) {
+  set_name(node, 'A' + (char)((idx / NUM_INNER_LETTERS) / 26), 'A' + (char)((idx / NUM_INNER_LETTERS) % 26),
+           'B' + (char)(idx % NUM_INNER_LETTERS));
+}
+
+int main(int argc, char ** argv) {
+  GeneratorConfig config = {.seed = 1, .sizes = {750, 7}};
+  TRY(parse_generator_args(argc, argv, "[num_nodes [instruction_length]]", 2, &config));
+
+  const size_t num_nodes          = config.sizes[0];
+  const size_t instruction_length = config.sizes[1];
+
+  size_t primes[NUM_GHOSTS] = {0};
+  get_loop_primes(num_nodes, instruction_length, primes);
+
+  size_t total_num_nodes = 0;
+  for(size_t i = 0; i < NUM_GHOSTS; i++) { total_num_nodes += (primes[i] * instruction_length) + 1; }
+
+  if(total_num_nodes - (2 * NUM_GHOSTS) > MAX_NUM_NODES) {
+    return LOG_STAT(STAT_ERR_ARGS, "that needs %zu nodes, more than three-letter names allow", total_num_nodes);
+  }
+
+  Rng rng = {0};
+  seed_rng(&rng, config.seed);
+
+  DAR_DArray instructions = {0}; // contains size_t, 0 for left and 1 for right
+  DAR_DArray nodes        = {0}; // contains Node
+  TRY(DAR_create(&instructions, sizeof(size_t)));
+  TRY(DAR_create(&nodes, sizeof(Node)));
+  TRY(DAR_resize_zeroed(&nodes, total_num_nodes));
+
+  for(size_t i = 0; i < instruction_length; i++) {
+    const size_t direction = get_random_below(&rng, 2);
+    TRY(DAR_push_back(&instructions, &direction));
+  }
+
+  size_t node_idx       = 0;
+  size_t inner_name_idx = 0;
+  for(size_t ghost = 0; ghost < NUM_GHOSTS; ghost++) {
+    const size_t loop_length = primes[ghost] * instruction_length;
+
+    // node_idx is the start node, followed by the loop, of which the last node is the end node
+    const size_t start_idx = node_idx;
+    const size_t end_idx   = start_idx + loop_length;
+
+    Node * start = DAR_get(&nodes, start_idx);
+    Node * end   = DAR_get(&nodes, end_idx);
+    if(ghost == 0) {
+      set_name(start, 'A', 'A', 'A');
+      set_name(end, 'Z', 'Z', 'Z');
+    } else {
+      set_name(start, 'B' + (char)(ghost / 26), 'A' + (char)(ghost % 26), 'A');
+      set_name(end, 'B' + (char)(ghost / 26), 'A' + (char)(ghost % 26), 'Z');
+    }
+
+    for(size_t t = 0; t <= loop_length; t++) {
+      Node *       node      = DAR_get(&nodes, start_idx + t);
+      const size_t next_idx  = (t == loop_length) ? (start_idx + 1) : (start_idx + t + 1);
+      const size_t direction = *(const size_t *)DAR_get(&instructions, t % instruction_length);
+
+      if(t > 0 && t < loop_length) set_inner_name(node, inner_name_idx++);
+
+      node->exits[direction]     = next_idx;
+      node->exits[1 - direction] = get_random_below(&rng, total_num_nodes);
+    }
+
+    node_idx = end_idx + 1;
+  }
+
+  // write the nodes in random order, so the loops are not obvious from the file
+  DAR_DArray order = {0};
+  TRY(DAR_create(&order, sizeof(size_t)));
+  for(size_t i = 0; i < total_num_nodes; i++) { TRY(DAR_push_back(&order, &i)); }
+  for(size_t i = total_num_nodes; i > 1; i--) {
+    size_t *     a   = DAR_get(&order, i - 1);
+    size_t *     b   = DAR_get(&order, get_random_below(&rng, i));
+    const size_t tmp = *a;
+    *a               = *b;
+    *b               = tmp;
+  }
+
+  FILE * file = NULL;
+  TRY(open_generator_output(&config, &file));
+
+  for(const size_t * d = DAR_first(&instructions); d != DAR_end(&instructions); d++) { fputc("LR"[*d], file); }
+  fputs("\n\n", file);
+
+  for(const size_t * idx = DAR_first(&order); idx != DAR_end(&order); idx++) {
+    const Node * node  = DAR_get(&nodes, *idx);
+    const Node * left  = DAR_get(&nodes, node->exits[0]);
+    const Node * right = DAR_get(&nodes, node->exits[1]);
+    fprintf(file, "%s = (%s, %s)\n", node->name, left->name, right->name);
+  }
+
+  TRY(close_generator_output(file));
+
+  TRY(DAR_destroy(&order));
+  TRY(DAR_destroy(&nodes));
+  TRY(DAR_destroy(&instructions));
+
+  return OK;
+}
@@ -2,6 +2,7 @@
 #include <cfac/hashtable.h>
 #include <cfac/log.h>
 
+#include "cache.h"
 #include "common.h"
 #include "lib.h"
 
@@ -62,9 +63,9 @@ static STAT_Val parse_state_transitions(SPN_Span line, HT_HashTable * state_name
   return OK;
 }
 
-STAT_Val parse_state_machine(SPN_Span lines, StateMachine * machine) {
+STAT_Val parse_state_machine(SPN_Span lines /* contains SPN_Span */, StateMachine * machine) {
   CHECK(!SPN_is_empty(lines));
-  CHECK(lines.element_size == sizeof(DAR_DArray));
+  CHECK(lines.element_size == sizeof(SPN_Span));
   CHECK(machine != NULL);
 
   TRY(init_machine(machine));
@@ -76,7 +77,7 @@ STAT_Val parse_state_machine(SPN_Span lines, StateMachine * machine) {
 
   // first retrieve all the state names, this is so we can easily convert from name to index later
   for(size_t i = 0; i < lines.len; i++) {
-    const SPN_Span line      = DAR_to_span(SPN_get(lines, i));
+    const SPN_Span line      = *(const SPN_Span *)SPN_get(lines, i);
     const size_t   state_idx = i;
 
     State       state           = {0};
@@ -101,7 +102,7 @@ STAT_Val parse_state_machine(SPN_Span lines, StateMachine * machine) {
   }
 
   for(size_t i = 0; i < lines.len; i++) {
-    const SPN_Span line  = DAR_to_span(SPN_get(lines, i));
+    const SPN_Span line  = *(const SPN_Span *)SPN_get(lines, i);
     State *        state = DAR_get(&machine->states, i);
 
     TRY(parse_state_transitions(line, &state_name_idx_map, state));
@@ -114,6 +115,61 @@ STAT_Val parse_state_machine(SPN_Span lines, StateMachine * machine) {
   return OK;
 }
 
+static STAT_Val read_state_machine_from_cache(CacheReader * reader, StateMachine * machine) {
+  TRY(init_machine(machine));
+  TRY(read_darray_from_cache(reader, &machine->states));
+  TRY(read_from_cache(reader, &machine->initial_state, sizeof(machine->initial_state)));
+  TRY(read_from_cache(reader, &machine->end_state, sizeof(machine->end_state)));
+
+  TRY(check_cache_fully_read(reader));
+
+  return OK;
+}
+
+static STAT_Val write_state_machine_to_cache(CacheWriter * writer, const StateMachine * machine) {
+  TRY(write_darray_to_cache(writer, &machine->states));
+  TRY(write_to_cache(writer, &machine->initial_state, sizeof(machine->initial_state)));
+  TRY(write_to_cache(writer, &machine->end_state, sizeof(machine->end_state)));
+
+  return OK;
+}
+
+STAT_Val parse_state_machine_cached(const InputFile * input, SPN_Span lines, StateMachine * machine) {
+  CHECK(input != NULL);
+  CHECK(machine != NULL);
+
+  CacheReader    reader    = {0};
+  const STAT_Val reader_st = open_cache_reader("day_8", input, &reader);
+  TRY(reader_st);
+  if(reader_st == OK) {
+    // a bad entry is still an error, but neither the mapping nor what was read of it so far are left behind
+    const STAT_Val read_st = read_state_machine_from_cache(&reader, machine);
+    TRY(close_cache_reader(&reader));
+    if(!STAT_is_OK(read_st)) TRY(destroy_state_machine(machine));
+    TRY(read_st);
+    return OK;
+  }
+
+  TRY(parse_state_machine(lines, machine));
+
+  CacheWriter    writer    = {0};
+  const STAT_Val writer_st = open_cache_writer("day_8", input, &writer);
+  TRY(writer_st);
+  if(writer_st == OK) {
+    // likewise a failed write drops the partly written entry, and the parsed result with it
+    STAT_Val write_st = write_state_machine_to_cache(&writer, machine);
+    if(STAT_is_OK(write_st)) {
+      write_st = commit_cache_writer(&writer);
+    } else {
+      TRY(abort_cache_writer(&writer));
+    }
+    if(!STAT_is_OK(write_st)) TRY(destroy_state_machine(machine));
+    TRY(write_st);
+  }
+
+  return OK;
+}
+
 STAT_Val destroy_state_machine(StateMachine * machine) {
   CHECK(machine != NULL);
 
@@ -4,6 +4,8 @@
 #include <cfac/darray.h>
 #include <cfac/stat.h>
 
+#include "input.h"
+
 typedef enum TransitionType {
   LEFT,
   RIGHT,
@@ -21,7 +23,12 @@ typedef struct StateMachine {
   size_t     end_state;
 } StateMachine;
 
-STAT_Val parse_state_machine(SPN_Span lines, StateMachine * machine);
+STAT_Val parse_state_machine(SPN_Span lines /* contains SPN_Span */, StateMachine * machine);
+
+// same as parse_state_machine on lines of input, but reuses the machine from an earlier run when PARSE_CACHE_DIR is set
+STAT_Val parse_state_machine_cached(const InputFile * input,
+                                    SPN_Span          lines /* contains SPN_Span */,
+                                    StateMachine *    machine);
 
 STAT_Val destroy_state_machine(StateMachine * machine);
 
@@ -1,6 +1,8 @@
+#include "cache.h"
 #include "lib.h"
 
 #include <stdlib.h>
+#include <unistd.h>
 
 #include <cfac/test_utils.h>
 
@@ -13,20 +15,17 @@ static STAT_Val create_lines_arr(const char ** lines, size_t n, DAR_DArray * arr
   CHECK(lines != NULL);
   CHECK(arr != NULL);
 
-  TRY(DAR_create(arr, sizeof(DAR_DArray)));
+  TRY(DAR_create(arr, sizeof(SPN_Span)));
 
   for(size_t i = 0; i < n; i++) {
-    const char * line     = lines[i];
-    DAR_DArray   line_arr = {0};
-    TRY(DAR_create_from_cstr(&line_arr, line));
-    TRY(DAR_push_back(arr, &line_arr));
+    const SPN_Span line = SPN_from_cstr(lines[i]);
+    TRY(DAR_push_back(arr, &line));
   }
 
   return OK;
 }
 
 static STAT_Val destroy_lines_arr(DAR_DArray * arr) {
-  for(DAR_DArray * line = DAR_first(arr); line != DAR_end(arr); line++) { TRY(DAR_destroy(line)); }
   TRY(DAR_destroy(arr));
 
   return OK;
@@ -131,6 +130,77 @@ static Result tst_parse_state_machine_example(void) {
   return r;
 }
 
+static Result tst_parse_state_machine_cached(void) {
+  Result r = PASS;
+  const char raw_input[] = "RL\n"
+                           "\n"
+                           "AAA = (BBB, CCC)\n"
+                           "BBB = (DDD, EEE)\n"
+                           "CCC = (ZZZ, GGG)\n"
+                           "DDD = (DDD, DDD)\n"
+                           "EEE = (EEE, EEE)\n"
+                           "GGG = (GGG, GGG)\n"
+                           "ZZZ = (ZZZ, ZZZ)\n";
+
+  char dir[]            = "/tmp/day_8_cache_XXXXXX";
+  char input_filename[] = "/tmp/day_8_cache_XXXXXX/input.txt";
+  EXPECT_NE(&r, NULL, mkdtemp(dir));
+  if(HAS_FAILED(&r)) return r;
+  memcpy(input_filename, dir, strlen(dir));
+
+  FILE * file = fopen(input_filename, "w");
+  EXPECT_NE(&r, NULL, file);
+  if(HAS_FAILED(&r)) return r;
+  fputs(raw_input, file);
+  fclose(file);
+
+  InputFile input = {0};
+  EXPECT_OK(&r, map_input_file(input_filename, &input));
+
+  EXPECT_EQ(&r, 0, setenv("PARSE_CACHE_DIR", dir, 1));
+
+  const SPN_Span machine_lines = SPN_subspan(DAR_to_span(&input.lines), 2, input.lines.size - 2);
+
+  // first run parses and writes the entry, second run reads it back
+  StateMachine parsed = {0};
+  StateMachine cached = {0};
+  EXPECT_OK(&r, parse_state_machine_cached(&input, machine_lines, &parsed));
+  EXPECT_OK(&r, parse_state_machine_cached(&input, machine_lines, &cached));
+
+  EXPECT_EQ(&r, parsed.states.size, cached.states.size);
+  EXPECT_ARREQ(&r, State, parsed.states.data, cached.states.data, parsed.states.size);
+  EXPECT_EQ(&r, parsed.initial_state, cached.initial_state);
+  EXPECT_EQ(&r, parsed.end_state, cached.end_state);
+
+  DAR_DArray input_seq = {0};
+  EXPECT_OK(&r, DAR_create(&input_seq, sizeof(TransitionType)));
+  EXPECT_OK(&r, parse_input_sequence(*(const SPN_Span *)DAR_first(&input.lines), &input_seq));
+
+  size_t number_of_steps = 0;
+  EXPECT_OK(&r,
+            get_number_of_steps_for_input_on_state_machine_part1(&cached, DAR_to_span(&input_seq), &number_of_steps));
+  EXPECT_EQ(&r, 2, number_of_steps);
+
+  EXPECT_EQ(&r, 0, unsetenv("PARSE_CACHE_DIR"));
+
+  char cache_filename[sizeof(dir) + 32] = {0};
+  snprintf(cache_filename,
+           sizeof(cache_filename),
+           "%s/day_8-%016llx.bin",
+           dir,
+           (unsigned long long)hash_input(input.data, input.size));
+  EXPECT_EQ(&r, 0, unlink(cache_filename));
+  EXPECT_EQ(&r, 0, unlink(input_filename));
+  EXPECT_EQ(&r, 0, rmdir(dir));
+
+  EXPECT_OK(&r, DAR_destroy(&input_seq));
+  EXPECT_OK(&r, destroy_state_machine(&parsed));
+  EXPECT_OK(&r, destroy_state_machine(&cached));
+  EXPECT_OK(&r, destroy_input_file(&input));
+
+  return r;
+}
+
 static Result tst_parse_input_sequence(void) {
   Result r = PASS;
 
@@ -187,7 +257,7 @@ static Result tst_get_number_of_steps_for_input_on_state_machine_part1_example_1
   DAR_DArray input_seq = {0};
   EXPECT_OK(&r, DAR_create(&input_seq, sizeof(TransitionType)));
 
-  EXPECT_OK(&r, parse_input_sequence(DAR_to_span(DAR_first(&lines)), &input_seq));
+  EXPECT_OK(&r, parse_input_sequence(*(const SPN_Span *)DAR_first(&lines), &input_seq));
   EXPECT_EQ(&r, 2, input_seq.size);
 
   StateMachine machine = {0};
@@ -223,7 +293,7 @@ static Result tst_get_number_of_steps_for_input_on_state_machine_part1_example_2
   DAR_DArray input_seq = {0};
   EXPECT_OK(&r, DAR_create(&input_seq, sizeof(TransitionType)));
 
-  EXPECT_OK(&r, parse_input_sequence(DAR_to_span(DAR_first(&lines)), &input_seq));
+  EXPECT_OK(&r, parse_input_sequence(*(const SPN_Span *)DAR_first(&lines), &input_seq));
   EXPECT_EQ(&r, 3, input_seq.size);
 
   StateMachine machine = {0};
@@ -264,7 +334,7 @@ static Result tst_get_number_of_steps_for_input_on_state_machine_part2_example(v
   DAR_DArray input_seq = {0};
   EXPECT_OK(&r, DAR_create(&input_seq, sizeof(TransitionType)));
 
-  EXPECT_OK(&r, parse_input_sequence(DAR_to_span(DAR_first(&lines)), &input_seq));
+  EXPECT_OK(&r, parse_input_sequence(*(const SPN_Span *)DAR_first(&lines), &input_seq));
   EXPECT_EQ(&r, 2, input_seq.size);
 
   StateMachine machine = {0};
@@ -295,6 +365,7 @@ int main(void) {
   Test tests[] = {
       tst_parse_state_machine_basic,
       tst_parse_state_machine_example,
+      tst_parse_state_machine_cached,
       tst_parse_input_sequence,
       tst_get_number_of_steps_for_input_on_state_machine_part1_example_1,
       tst_get_number_of_steps_for_input_on_state_machine_part1_example_2,
@@ -6,63 +6,43 @@
 #include <cfac/stat.h>
 
 #include "common.h"
+#include "input.h"
 #include "lib.h"
-
-static STAT_Val read_lines_from_file(const char * filename, DAR_DArray * lines) {
-  CHECK(lines != NULL);
-  CHECK(DAR_is_initialized(lines));
-
-  FILE * file_ptr = fopen(filename, "r");
-  CHECK(file_ptr != NULL);
-
-  char *  line_raw = NULL;
-  size_t  len      = 0;
-  ssize_t read     = 0;
-
-  while((read = getline(&line_raw, &len, file_ptr)) != -1) {
-    DAR_DArray line = {0};
-    TRY(DAR_create_from_cstr(&line, line_raw));
-    TRY(DAR_push_back(lines, &line));
-  }
-
-  fclose(file_ptr);
-  free(line_raw);
-
-  return OK;
-}
-
-static STAT_Val destroy_lines(DAR_DArray * lines) {
-  CHECK(lines != NULL);
-
-  for(DAR_DArray * p = DAR_first(lines); p != DAR_end(lines); p++) { TRY(DAR_destroy(p)); }
-
-  TRY(DAR_destroy(lines));
-
-  return OK;
-}
+#include "metrics.h"
 
 int main(void) {
-  DAR_DArray lines = {0};
-  TRY(DAR_create(&lines, sizeof(DAR_DArray)));
+  Metrics metrics = {0};
+  start_metrics(&metrics, "day_8");
 
-  TRY(read_lines_from_file("input.txt", &lines));
+  begin_phase(&metrics, PHASE_READ);
+  InputFile input = {0};
+  TRY(map_input_file("input.txt", &input));
+  end_phase(&metrics);
 
+  begin_phase(&metrics, PHASE_PARSE);
   DAR_DArray input_seq = {0};
   TRY(DAR_create(&input_seq, sizeof(TransitionType)));
-  TRY(parse_input_sequence(DAR_to_span(DAR_first(&lines)), &input_seq));
+  TRY(parse_input_sequence(*(const SPN_Span *)DAR_first(&input.lines), &input_seq));
 
   StateMachine machine = {0};
-  TRY(parse_state_machine(SPN_subspan(DAR_to_span(&lines), 2, lines.size - 2), &machine));
+  TRY(parse_state_machine_cached(&input, SPN_subspan(DAR_to_span(&input.lines), 2, input.lines.size - 2), &machine));
+  end_phase(&metrics);
 
+  begin_phase(&metrics, PHASE_PART1);
   size_t number_of_steps_part1 = 0;
   TRY(get_number_of_steps_for_input_on_state_machine_part1(&machine, DAR_to_span(&input_seq), &number_of_steps_part1));
+  end_phase(&metrics);
 
+  begin_phase(&metrics, PHASE_PART2);
   size_t number_of_steps_part2 = 0;
   TRY(get_number_of_steps_for_input_on_state_machine_part2(&machine, DAR_to_span(&input_seq), &number_of_steps_part2));
+  end_phase(&metrics);
 
   TRY(destroy_state_machine(&machine));
   TRY(DAR_destroy(&input_seq));
-  TRY(destroy_lines(&lines));
+  TRY(destroy_input_file(&input));
+
+  TRY(write_metrics(&metrics));
 
   return LOG_STAT(STAT_OK,
                   "number_of_steps_part1: %zu, number_of_steps_part2: %zu",
@@ -0,0 +1,132 @@
+#include <cfac/log.h>
+
+#include "arena.h"
+#include "common.h"
+
+#include <stdalign.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ARENA_ALIGNMENT    alignof(max_align_t)
+#define ARENA_MIN_CAPACITY 4096
+
+struct ArenaBlock {
+  ArenaBlock * next;
+  size_t       capacity;
+  size_t       used;
+  alignas(max_align_t) unsigned char data[];
+};
+
+static size_t align_up(size_t size) { return (size + (ARENA_ALIGNMENT - 1)) & ~(ARENA_ALIGNMENT - 1); }
+
+// blocks double in size, so a solve that outgrows its arena only needs a few of them
+static size_t get_grown_capacity(size_t capacity) { return (capacity <= SIZE_MAX / 4) ? (capacity * 2) : capacity; }
+
+static STAT_Val add_block(Arena * arena, size_t capacity) {
+  CHECK(arena != NULL);
+  CHECK(capacity <= SIZE_MAX - sizeof(ArenaBlock));
+
+  ArenaBlock * block = malloc(sizeof(ArenaBlock) + capacity);
+  if(block == NULL) return LOG_STAT(STAT_ERR_ALLOC, "failed to allocate arena block of %zu bytes", capacity);
+
+  block->next     = arena->blocks;
+  block->capacity = capacity;
+  block->used     = 0;
+
+  arena->blocks = block;
+
+  return OK;
+}
+
+static void free_blocks(ArenaBlock * block) {
+  while(block != NULL) {
+    ArenaBlock * next = block->next;
+    free(block);
+    block = next;
+  }
+}
+
+STAT_Val create_arena(Arena * arena, size_t initial_capacity) {
+  CHECK(arena != NULL);
+
+  *arena = (Arena){0};
+
+  const size_t capacity = (initial_capacity < ARENA_MIN_CAPACITY) ? ARENA_MIN_CAPACITY : align_up(initial_capacity);
+  TRY(add_block(arena, capacity));
+
+  arena->next_capacity = get_grown_capacity(capacity);
+
+  return OK;
+}
+
+STAT_Val allocate_from_arena(Arena * arena, size_t size, void ** memory) {
+  CHECK(arena != NULL);
+  CHECK(arena->blocks != NULL);
+  CHECK(memory != NULL);
+  CHECK(size <= SIZE_MAX - ARENA_ALIGNMENT);
+
+  const size_t aligned_size = align_up(size);
+
+  ArenaBlock * block = arena->blocks;
+  if(block->capacity - block->used < aligned_size) {
+    const size_t capacity = (arena->next_capacity < aligned_size) ? aligned_size : arena->next_capacity;
+    TRY(add_block(arena, capacity));
+
+    block                = arena->blocks;
+    arena->next_capacity = get_grown_capacity(capacity);
+  }
+
+  *memory = &block->data[block->used];
+  block->used += aligned_size;
+
+  return OK;
+}
+
+STAT_Val allocate_span_from_arena(Arena * arena, size_t element_size, size_t len, SPN_MutSpan * span) {
+  CHECK(element_size > 0);
+  CHECK(len <= SIZE_MAX / element_size);
+  CHECK(span != NULL);
+
+  void * memory = NULL;
+  TRY(allocate_from_arena(arena, element_size * len, &memory));
+  memset(memory, 0, element_size * len);
+
+  *span = (SPN_MutSpan){.begin = memory, .element_size = element_size, .len = len};
+
+  return OK;
+}
+
+STAT_Val reset_arena(Arena * arena) {
+  CHECK(arena != NULL);
+  CHECK(arena->blocks != NULL);
+
+  if(arena->blocks->next != NULL) {
+    // it took several blocks to hold everything, replace them with one that fits it all from the start
+    size_t total_capacity = 0;
+    for(const ArenaBlock * block = arena->blocks; block != NULL; block = block->next) {
+      CHECK(block->capacity <= SIZE_MAX - total_capacity);
+      total_capacity += block->capacity;
+    }
+
+    free_blocks(arena->blocks);
+    arena->blocks = NULL;
+
+    TRY(add_block(arena, total_capacity));
+    arena->next_capacity = get_grown_capacity(total_capacity);
+  }
+
+  arena->blocks->used = 0;
+
+  return OK;
+}
+
+STAT_Val destroy_arena(Arena * arena) {
+  CHECK(arena != NULL);
+
+  free_blocks(arena->blocks);
+
+  *arena = (Arena){0};
+
+  return OK;
+}
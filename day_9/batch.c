@@ -0,0 +1,69 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cfac/darray.h>
+#include <cfac/log.h>
+#include <cfac/stat.h>
+
+#include "common.h"
+#include "driver.h"
+#include "input.h"
+#include "lib.h"
+
+static STAT_Val solve_input(const InputFile * input, char * result, size_t result_size) {
+  Arena arena = {0};
+  TRY(create_arena(&arena, 0));
+
+  DAR_DArray sequence = {0};
+  TRY(DAR_create(&sequence, sizeof(ssize_t)));
+
+  ssize_t next_value_sum = 0;
+  ssize_t prev_value_sum = 0;
+  for(const SPN_Span * line = DAR_first(&input->lines); line != DAR_end(&input->lines); line++) {
+    TRY(DAR_clear(&sequence));
+    TRY(parse_sequence_line(*line, &sequence));
+
+    ssize_t next_value = 0;
+    ssize_t prev_value = 0;
+    TRY(get_next_value_in_sequence_in_arena(DAR_to_span(&sequence), &arena, &next_value));
+    TRY(get_prev_value_in_sequence_in_arena(DAR_to_span(&sequence), &arena, &prev_value));
+    TRY(reset_arena(&arena));
+
+    next_value_sum += next_value;
+    prev_value_sum += prev_value;
+  }
+
+  TRY(DAR_destroy(&sequence));
+  TRY(destroy_arena(&arena));
+
+  snprintf(result, result_size, "next_value_sum: %zd, prev_value_sum: %zd", next_value_sum, prev_value_sum);
+
+  return OK;
+}
+
+static STAT_Val solve_file(const char * filename, char * result, size_t result_size) {
+  InputFile input = {0};
+  TRY(map_input_file(filename, &input));
+
+  // the mapping is released whether or not the input could be solved
+  const STAT_Val solve_st = solve_input(&input, result, result_size);
+  TRY(destroy_input_file(&input));
+  TRY(solve_st);
+
+  return OK;
+}
+
+int main(int argc, char ** argv) {
+  BatchConfig config = {0};
+  TRY(parse_batch_args(argc, argv, &config));
+
+  size_t num_failed = 0;
+  TRY(run_batch(&config, solve_file, &num_failed));
+
+  const size_t num_files = config.input_filenames.size;
+  TRY(destroy_batch_config(&config));
+
+  if(num_failed > 0) return LOG_STAT(STAT_ERR_INTERNAL, "failed to solve %zu of %zu files", num_failed, num_files);
+
+  return OK;
+}
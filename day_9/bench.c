@@ -0,0 +1,84 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cfac/darray.h>
+#include <cfac/log.h>
+#include <cfac/stat.h>
+
+#include "benchmark.h"
+#include "common.h"
+#include "input.h"
+#include "lib.h"
+
+typedef struct Context {
+  InputFile  input;
+  DAR_DArray sequences;      // contains DAR_DArray of ssize_t
+  DAR_DArray sequence_spans; // contains SPN_Span of ssize_t, pointing into sequences
+  ssize_t    next_value_sum;
+  ssize_t    prev_value_sum;
+} Context;
+
+static STAT_Val parse(void * p) {
+  Context * ctx = p;
+
+  for(const SPN_Span * line = DAR_first(&ctx->input.lines); line != DAR_end(&ctx->input.lines); line++) {
+    DAR_DArray sequence = {0};
+    TRY(DAR_create(&sequence, sizeof(ssize_t)));
+
+    TRY(parse_sequence_line(*line, &sequence));
+    TRY(DAR_push_back(&ctx->sequences, &sequence));
+  }
+
+  for(const DAR_DArray * sequence = DAR_first(&ctx->sequences); sequence != DAR_end(&ctx->sequences); sequence++) {
+    const SPN_Span span = DAR_to_span(sequence);
+    TRY(DAR_push_back(&ctx->sequence_spans, &span));
+  }
+
+  return OK;
+}
+
+static STAT_Val unparse(void * p) {
+  Context * ctx = p;
+
+  for(DAR_DArray * sequence = DAR_first(&ctx->sequences); sequence != DAR_end(&ctx->sequences); sequence++) {
+    TRY(DAR_destroy(sequence));
+  }
+
+  TRY(DAR_clear(&ctx->sequences));
+  TRY(DAR_clear(&ctx->sequence_spans));
+
+  return OK;
+}
+
+static STAT_Val solve(void * p) {
+  Context * ctx = p;
+
+  const SPN_Span sequences_span = DAR_to_span(&ctx->sequence_spans);
+  TRY(get_sum_of_next_values_in_sequences(sequences_span, &ctx->next_value_sum));
+  TRY(get_sum_of_prev_values_in_sequences(sequences_span, &ctx->prev_value_sum));
+
+  return OK;
+}
+
+int main(int argc, char ** argv) {
+  BenchConfig config = {0};
+  TRY(parse_bench_args(argc, argv, &config));
+
+  Context ctx = {0};
+  TRY(map_input_file(config.input_filename, &ctx.input));
+  TRY(DAR_create(&ctx.sequences, sizeof(DAR_DArray)));
+  TRY(DAR_create(&ctx.sequence_spans, sizeof(SPN_Span)));
+
+  const BenchPhase phases[] = {
+      {.name = "parse", .run = parse, .teardown = unparse},
+      {.name = "solve", .setup = parse, .run = solve, .teardown = unparse},
+  };
+
+  TRY(run_bench(&config, "day_9", phases, sizeof(phases) / sizeof(phases[0]), &ctx));
+
+  TRY(DAR_destroy(&ctx.sequences));
+  TRY(DAR_destroy(&ctx.sequence_spans));
+  TRY(destroy_input_file(&ctx.input));
+
+  return OK;
+}
@@ -0,0 +1,52 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cfac/log.h>
+#include <cfac/stat.h>
+
+#include "common.h"
+#include "generator.h"
+
+#include <sys/types.h>
+
+// writes num_sequences sequences of sequence_length values each. Every sequence is a polynomial of degree at most 5
+// with small coefficients, sampled at 0, 1, 2, ..., so it reduces to all zeroes like the puzzle input does.
+
+#define MAX_DEGREE 5
+
+int main(int argc, char ** argv) {
+  GeneratorConfig config = {.seed = 1, .sizes = {200, 21}};
+  TRY(parse_generator_args(argc, argv, "[num_sequences [sequence_length]]", 2, &config));
+
+  const size_t num_sequences   = config.sizes[0];
+  const size_t sequence_length = config.sizes[1];
+
+  if(sequence_length > 1000) {
+    return LOG_STAT(STAT_ERR_ARGS, "sequence_length can be at most 1000, longer ones overflow the values");
+  }
+
+  Rng rng = {0};
+  seed_rng(&rng, config.seed);
+
+  FILE * file = NULL;
+  TRY(open_generator_output(&config, &file));
+
+  for(size_t i = 0; i < num_sequences; i++) {
+    ssize_t coefficients[MAX_DEGREE + 1] = {0};
+
+    const size_t degree = get_random_below(&rng, MAX_DEGREE + 1);
+    for(size_t d = 0; d <= degree; d++) { coefficients[d] = (ssize_t)get_random_below(&rng, 21) - 10; }
+
+    for(size_t x = 0; x < sequence_length; x++) {
+      ssize_t value = 0;
+      for(size_t d = degree + 1; d > 0; d--) { value = (value * (ssize_t)x) + coefficients[d - 1]; }
+
+      fprintf(file, "%s%zd", (x == 0) ? "" : " ", value);
+    }
+    fputc('\n', file);
+  }
+
+  TRY(close_generator_output(file));
+
+  return OK;
+}
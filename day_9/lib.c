@@ -2,8 +2,7 @@
 
 #include "common.h"
 #include "lib.h"
-
-#include <stdio.h>
+#include "scan.h"
 
 STAT_Val get_delta_sequence(SPN_Span sequence, SPN_MutSpan deltas) {
   CHECK(!SPN_is_empty(sequence));
@@ -54,51 +53,95 @@ STAT_Val generate_histories_for_sequence(SPN_Span sequence, DAR_DArray * histori
   return OK;
 }
 
-STAT_Val get_next_value_in_sequence(SPN_Span sequence, ssize_t * next_value) {
+STAT_Val generate_histories_for_sequence_in_arena(SPN_Span      sequence,
+                                                  Arena *       arena,
+                                                  SPN_MutSpan * histories /* contains SPN_Span of ssize_t */) {
   CHECK(!SPN_is_empty(sequence));
   CHECK(sequence.element_size == sizeof(ssize_t));
-  CHECK(next_value != NULL);
+  CHECK(arena != NULL);
+  CHECK(histories != NULL);
+
+  // each history is one shorter than the one before, so there are fewer histories than elements in the sequence
+  TRY(allocate_span_from_arena(arena, sizeof(SPN_Span), sequence.len - 1, histories));
 
-  DAR_DArray histories = {0};
-  TRY(DAR_create(&histories, sizeof(DAR_DArray)));
+  size_t   num_histories = 0;
+  SPN_Span work_seq      = sequence;
+  while((work_seq.len > 1) && !is_sequence_all_zeroes(work_seq)) {
+    SPN_MutSpan history = {0};
+    TRY(allocate_span_from_arena(arena, sizeof(ssize_t), work_seq.len - 1, &history));
+
+    TRY(get_delta_sequence(work_seq, history));
+
+    work_seq = SPN_mut_to_const(history);
+
+    *(SPN_Span *)SPN_get(*histories, num_histories) = work_seq;
+    num_histories++;
+  }
 
-  TRY(generate_histories_for_sequence(sequence, &histories));
+  histories->len = num_histories;
+
+  return OK;
+}
+
+STAT_Val get_next_value_in_sequence_in_arena(SPN_Span sequence, Arena * arena, ssize_t * next_value) {
+  CHECK(!SPN_is_empty(sequence));
+  CHECK(sequence.element_size == sizeof(ssize_t));
+  CHECK(next_value != NULL);
+
+  SPN_MutSpan histories = {0};
+  TRY(generate_histories_for_sequence_in_arena(sequence, arena, &histories));
 
   ssize_t val = 0;
-  for(DAR_DArray * hist = DAR_first(&histories); hist != DAR_end(&histories); hist++) {
-    val += *(ssize_t *)DAR_last(hist);
+  for(const SPN_Span * hist = SPN_first(histories); hist != SPN_end(histories); hist++) {
+    val += *(const ssize_t *)SPN_last(*hist);
   }
 
   val += *(const ssize_t *)SPN_last(sequence);
 
   *next_value = val;
 
-  TRY(destroy_histories(&histories));
-
   return OK;
 }
 
-STAT_Val get_prev_value_in_sequence(SPN_Span sequence, ssize_t * prev_value) {
+STAT_Val get_prev_value_in_sequence_in_arena(SPN_Span sequence, Arena * arena, ssize_t * prev_value) {
   CHECK(!SPN_is_empty(sequence));
   CHECK(sequence.element_size == sizeof(ssize_t));
   CHECK(prev_value != NULL);
 
-  DAR_DArray histories = {0};
-  TRY(DAR_create(&histories, sizeof(DAR_DArray)));
-
-  TRY(generate_histories_for_sequence(sequence, &histories));
+  SPN_MutSpan histories = {0};
+  TRY(generate_histories_for_sequence_in_arena(sequence, arena, &histories));
 
   ssize_t val = 0;
 
-  for(ssize_t i = histories.size - 1; i >= 0; i--) {
-    val = *(ssize_t *)DAR_first((DAR_DArray *)DAR_get(&histories, i)) - val;
+  for(ssize_t i = histories.len - 1; i >= 0; i--) {
+    val = *(const ssize_t *)SPN_first(*(SPN_Span *)SPN_get(histories, i)) - val;
   }
 
-  val = *(ssize_t *)SPN_first(sequence) - val;
+  val = *(const ssize_t *)SPN_first(sequence) - val;
 
   *prev_value = val;
 
-  TRY(destroy_histories(&histories));
+  return OK;
+}
+
+STAT_Val get_next_value_in_sequence(SPN_Span sequence, ssize_t * next_value) {
+  Arena arena = {0};
+  TRY(create_arena(&arena, 0));
+
+  TRY(get_next_value_in_sequence_in_arena(sequence, &arena, next_value));
+
+  TRY(destroy_arena(&arena));
+
+  return OK;
+}
+
+STAT_Val get_prev_value_in_sequence(SPN_Span sequence, ssize_t * prev_value) {
+  Arena arena = {0};
+  TRY(create_arena(&arena, 0));
+
+  TRY(get_prev_value_in_sequence_in_arena(sequence, &arena, prev_value));
+
+  TRY(destroy_arena(&arena));
 
   return OK;
 }
@@ -108,13 +151,19 @@ STAT_Val get_sum_of_next_values_in_sequences(SPN_Span sequences /* SPN_Span of S
   CHECK(sequences.element_size == sizeof(SPN_Span));
   CHECK(sum != NULL);
 
+  Arena arena = {0};
+  TRY(create_arena(&arena, 0));
+
   *sum = 0;
   for(const SPN_Span * seq = SPN_first(sequences); seq != SPN_end(sequences); seq++) {
     ssize_t val = 0;
-    TRY(get_next_value_in_sequence(*seq, &val));
+    TRY(get_next_value_in_sequence_in_arena(*seq, &arena, &val));
     (*sum) += val;
+    TRY(reset_arena(&arena));
   }
 
+  TRY(destroy_arena(&arena));
+
   return OK;
 }
 
@@ -123,13 +172,19 @@ STAT_Val get_sum_of_prev_values_in_sequences(SPN_Span sequences /* SPN_Span of S
   CHECK(sequences.element_size == sizeof(SPN_Span));
   CHECK(sum != NULL);
 
+  Arena arena = {0};
+  TRY(create_arena(&arena, 0));
+
   *sum = 0;
   for(const SPN_Span * seq = SPN_first(sequences); seq != SPN_end(sequences); seq++) {
     ssize_t val = 0;
-    TRY(get_prev_value_in_sequence(*seq, &val));
+    TRY(get_prev_value_in_sequence_in_arena(*seq, &arena, &val));
     (*sum) += val;
+    TRY(reset_arena(&arena));
   }
 
+  TRY(destroy_arena(&arena));
+
   return OK;
 }
 
@@ -143,8 +198,9 @@ STAT_Val parse_sequence_line(SPN_Span line, DAR_DArray * sequence) {
 
   SPN_Span remaining = line;
   while(remaining.len > 0) {
-    ssize_t v = 0;
-    CHECK(sscanf(remaining.begin, "%zd", &v) == 1);
+    ssize_t v            = 0;
+    size_t  num_consumed = 0;
+    CHECK(scan_ssize(remaining, &v, &num_consumed) == OK);
 
     TRY(DAR_push_back(sequence, &v));
 
@@ -5,6 +5,8 @@
 #include <cfac/span.h>
 #include <cfac/stat.h>
 
+#include "arena.h"
+
 #include <sys/types.h>
 
 STAT_Val get_delta_sequence(SPN_Span sequence, SPN_MutSpan deltas);
@@ -15,6 +17,13 @@ STAT_Val get_next_value_in_sequence(SPN_Span sequence, ssize_t * next_value);
 
 STAT_Val get_prev_value_in_sequence(SPN_Span sequence, ssize_t * prev_value);
 
+// take all histories from arena, which the caller can reset once the sequence is done
+STAT_Val generate_histories_for_sequence_in_arena(SPN_Span      sequence,
+                                                  Arena *       arena,
+                                                  SPN_MutSpan * histories /* contains SPN_Span of ssize_t */);
+STAT_Val get_next_value_in_sequence_in_arena(SPN_Span sequence, Arena * arena, ssize_t * next_value);
+STAT_Val get_prev_value_in_sequence_in_arena(SPN_Span sequence, Arena * arena, ssize_t * prev_value);
+
 STAT_Val get_sum_of_next_values_in_sequences(SPN_Span sequences /* SPN_Span of SPN_Span of ssize_t*/, ssize_t * sum);
 STAT_Val get_sum_of_prev_values_in_sequences(SPN_Span sequences /* SPN_Span of SPN_Span of ssize_t*/, ssize_t * sum);
 
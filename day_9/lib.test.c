@@ -1,4 +1,5 @@
 #include "lib.h"
+#include "scan.h"
 
 #include <stdlib.h>
 
@@ -109,6 +110,48 @@ static Result tst_generate_histories_for_sequence_example(void) {
   return r;
 }
 
+static Result tst_generate_histories_for_sequence_in_arena_example(void) {
+  Result r = PASS;
+
+  const ssize_t start_seq[] = {10, 13, 16, 21, 30, 45};
+  const ssize_t seq_step1[] = {3, 3, 5, 9, 15};
+  const ssize_t seq_step4[] = {0, 0};
+
+  SPN_Span start_span = {.begin        = start_seq,
+                         .element_size = sizeof(ssize_t),
+                         .len          = (sizeof(start_seq) / sizeof(start_seq[0]))};
+
+  Arena arena = {0};
+  EXPECT_OK(&r, create_arena(&arena, 0));
+  if(HAS_FAILED(&r)) return r;
+
+  SPN_MutSpan histories = {0};
+  EXPECT_OK(&r, generate_histories_for_sequence_in_arena(start_span, &arena, &histories));
+
+  EXPECT_EQ(&r, 4, histories.len);
+  if(HAS_FAILED(&r)) return r;
+
+  const SPN_Span * first_hist = SPN_first(histories);
+  const SPN_Span * last_hist  = SPN_last(histories);
+  EXPECT_EQ(&r, (sizeof(seq_step1) / sizeof(ssize_t)), first_hist->len);
+  EXPECT_EQ(&r, (sizeof(seq_step4) / sizeof(ssize_t)), last_hist->len);
+  EXPECT_ARREQ(&r, ssize_t, seq_step1, first_hist->begin, first_hist->len);
+  EXPECT_ARREQ(&r, ssize_t, seq_step4, last_hist->begin, last_hist->len);
+
+  // the next and previous values come out the same when sharing the arena with a reset in between
+  ssize_t next_value = 0;
+  ssize_t prev_value = 0;
+  EXPECT_OK(&r, reset_arena(&arena));
+  EXPECT_OK(&r, get_next_value_in_sequence_in_arena(start_span, &arena, &next_value));
+  EXPECT_OK(&r, get_prev_value_in_sequence_in_arena(start_span, &arena, &prev_value));
+  EXPECT_EQ(&r, 68, next_value);
+  EXPECT_EQ(&r, 5, prev_value);
+
+  EXPECT_OK(&r, destroy_arena(&arena));
+
+  return r;
+}
+
 static Result tst_get_next_value_in_sequence_example(void) {
   Result r = PASS;
 
@@ -222,6 +265,36 @@ static Result tst_parse_sequence_line_example(void) {
   return r;
 }
 
+static Result tst_scan_ssize(void) {
+  Result r = PASS;
+
+  ssize_t v            = 0;
+  size_t  num_consumed = 0;
+
+  EXPECT_OK(&r, scan_ssize(SPN_from_cstr("  -17 4"), &v, &num_consumed));
+  EXPECT_EQ(&r, -17, v);
+  EXPECT_EQ(&r, 5, num_consumed);
+
+  EXPECT_OK(&r, scan_ssize(SPN_from_cstr("+8\n"), &v, &num_consumed));
+  EXPECT_EQ(&r, 8, v);
+  EXPECT_EQ(&r, 2, num_consumed);
+
+  EXPECT_OK(&r, scan_ssize(SPN_from_cstr("-9223372036854775808"), &v, &num_consumed));
+  EXPECT_EQ(&r, -SSIZE_MAX - 1, v);
+
+  // only the digits inside the span count
+  EXPECT_OK(&r, scan_ssize(SPN_subspan(SPN_from_cstr("1234"), 0, 2), &v, &num_consumed));
+  EXPECT_EQ(&r, 12, v);
+  EXPECT_EQ(&r, 2, num_consumed);
+
+  EXPECT_EQ(&r, STAT_OK_NOT_FOUND, scan_ssize(SPN_from_cstr(" -x"), &v, &num_consumed));
+  EXPECT_EQ(&r, 1, num_consumed);
+  EXPECT_EQ(&r, STAT_ERR_READ, scan_ssize(SPN_from_cstr("9223372036854775808"), &v, &num_consumed));
+  EXPECT_EQ(&r, STAT_ERR_READ, scan_ssize(SPN_from_cstr("-9223372036854775809"), &v, &num_consumed));
+
+  return r;
+}
+
 static Result tst_fixture(void * env) {
   Result r = PASS;
 
@@ -234,11 +307,13 @@ int main(void) {
   Test tests[] = {
       tst_get_delta_sequence_example,
       tst_generate_histories_for_sequence_example,
+      tst_generate_histories_for_sequence_in_arena_example,
       tst_get_next_value_in_sequence_example,
       tst_get_prev_value_in_sequence_example,
       tst_get_sum_of_next_values_in_sequences_example,
       tst_get_sum_of_prev_values_in_sequences_example,
       tst_parse_sequence_line_example,
+      tst_scan_ssize,
   };
 
   TestWithFixture tests_with_fixture[] = {
@@ -6,98 +6,69 @@
 #include <cfac/stat.h>
 
 #include "common.h"
+#include "input.h"
 #include "lib.h"
+#include "metrics.h"
 
-static STAT_Val read_lines_from_file(const char * filename, DAR_DArray * lines) {
-  CHECK(lines != NULL);
-  CHECK(DAR_is_initialized(lines));
+int main(int argc, char ** argv) {
+  const char * filename = (argc > 1) ? argv[1] : "input.txt"; // "-" reads from stdin
 
-  FILE * file_ptr = fopen(filename, "r");
-  CHECK(file_ptr != NULL);
+  Metrics metrics = {0};
+  start_metrics(&metrics, "day_9");
 
-  char *  line_raw = NULL;
-  size_t  len      = 0;
-  ssize_t read     = 0;
+  LineReader reader = {0};
+  begin_phase(&metrics, PHASE_READ);
+  TRY(open_line_reader(filename, &reader));
+  end_phase(&metrics);
 
-  while((read = getline(&line_raw, &len, file_ptr)) != -1) {
-    DAR_DArray line = {0};
-    TRY(DAR_create_from_cstr(&line, line_raw));
-    TRY(DAR_push_back(lines, &line));
-  }
-
-  fclose(file_ptr);
-  free(line_raw);
-
-  return OK;
-}
-
-static STAT_Val destroy_lines(DAR_DArray * lines) {
-  CHECK(lines != NULL);
+  // sequences are independent of each other, so one of them is kept at a time
+  DAR_DArray sequence = {0};
+  TRY(DAR_create(&sequence, sizeof(ssize_t)));
 
-  for(DAR_DArray * p = DAR_first(lines); p != DAR_end(lines); p++) { TRY(DAR_destroy(p)); }
+  // the histories of one sequence are all released at once before the next
+  Arena arena = {0};
+  TRY(create_arena(&arena, 0));
 
-  TRY(DAR_destroy(lines));
-
-  return OK;
-}
-
-STAT_Val make_spans_for_sequences(const DAR_DArray * sequences, DAR_DArray * spans) {
-  CHECK(sequences != NULL);
-  CHECK(DAR_is_initialized(sequences));
-  CHECK(!DAR_is_empty(sequences));
-  CHECK(spans != NULL);
-  CHECK(DAR_is_initialized(spans));
-  CHECK(DAR_is_empty(spans));
+  ssize_t next_value_sum = 0;
+  ssize_t prev_value_sum = 0;
 
-  TRY(DAR_reserve(spans, sequences->size));
+  SPN_Span line    = {0};
+  STAT_Val read_st = OK;
+  begin_phase(&metrics, PHASE_READ);
+  while((read_st = read_next_line(&reader, &line)) == OK) {
+    end_phase(&metrics);
 
-  for(size_t i = 0; i < sequences->size; i++) {
-    const DAR_DArray * e    = DAR_get(sequences, i);
-    SPN_Span           span = DAR_to_span(e);
-    TRY(DAR_push_back(spans, &span));
-  }
+    begin_phase(&metrics, PHASE_PARSE);
+    TRY(DAR_clear(&sequence));
+    TRY(parse_sequence_line(line, &sequence));
+    end_phase(&metrics);
 
-  return OK;
-}
+    ssize_t next_value = 0;
+    ssize_t prev_value = 0;
 
-int main(void) {
-  DAR_DArray lines = {0};
-  TRY(DAR_create(&lines, sizeof(DAR_DArray)));
+    begin_phase(&metrics, PHASE_PART1);
+    TRY(get_next_value_in_sequence_in_arena(DAR_to_span(&sequence), &arena, &next_value));
+    end_phase(&metrics);
 
-  TRY(read_lines_from_file("input.txt", &lines));
+    begin_phase(&metrics, PHASE_PART2);
+    TRY(get_prev_value_in_sequence_in_arena(DAR_to_span(&sequence), &arena, &prev_value));
+    end_phase(&metrics);
 
-  DAR_DArray sequences = {0};
-  TRY(DAR_create(&sequences, sizeof(DAR_DArray)));
-  TRY(DAR_reserve(&sequences, lines.size));
+    TRY(reset_arena(&arena));
 
-  for(const DAR_DArray * line = DAR_first(&lines); line != DAR_end(&lines); line++) {
-    DAR_DArray sequence = {0};
-    TRY(DAR_create(&sequence, sizeof(ssize_t)));
+    next_value_sum += next_value;
+    prev_value_sum += prev_value;
 
-    TRY(parse_sequence_line(DAR_to_span(line), &sequence));
-    TRY(DAR_push_back(&sequences, &sequence));
+    begin_phase(&metrics, PHASE_READ);
   }
+  end_phase(&metrics);
+  TRY(read_st);
 
-  DAR_DArray sequence_spans = {0};
-  TRY(DAR_create(&sequence_spans, sizeof(SPN_Span)));
-
-  TRY(make_spans_for_sequences(&sequences, &sequence_spans));
-
-  SPN_Span sequences_span = DAR_to_span(&sequence_spans);
-
-  ssize_t next_value_sum = 0;
-  ssize_t prev_value_sum = 0;
-  TRY(get_sum_of_next_values_in_sequences(sequences_span, &next_value_sum));
-  TRY(get_sum_of_prev_values_in_sequences(sequences_span, &prev_value_sum));
-
-  TRY(DAR_destroy(&sequence_spans));
-
-  for(DAR_DArray * sequence = DAR_first(&sequences); sequence != DAR_end(&sequences); sequence++) {
-    TRY(DAR_destroy(sequence));
-  }
+  TRY(close_line_reader(&reader));
+  TRY(DAR_destroy(&sequence));
+  TRY(destroy_arena(&arena));
 
-  TRY(DAR_destroy(&sequences));
-  TRY(destroy_lines(&lines));
+  TRY(write_metrics(&metrics));
 
   return LOG_STAT(STAT_OK, "next_value_sum: %zd, prev_value_sum: %zd", next_value_sum, prev_value_sum);
 }
@@ -0,0 +1,28 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cfac/log.h>
+#include <cfac/stat.h>
+
+#include "benchmark.h"
+#include "common.h"
+#include "lib.h"
+
+static STAT_Val solve(void * p) {
+  (void)p;
+  TRY(do_a_thing());
+  return OK;
+}
+
+int main(int argc, char ** argv) {
+  BenchConfig config = {0};
+  TRY(parse_bench_args(argc, argv, &config));
+
+  const BenchPhase phases[] = {
+      {.name = "solve", .run = solve},
+  };
+
+  TRY(run_bench(&config, "template", phases, sizeof(phases) / sizeof(phases[0]), NULL));
+
+  return OK;
+}
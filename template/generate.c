@@ -0,0 +1,33 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cfac/log.h>
+#include <cfac/stat.h>
+
+#include "common.h"
+#include "generator.h"
+
+// writes num_lines lines of random letters, to be replaced by the format of the day's input
+
+int main(int argc, char ** argv) {
+  GeneratorConfig config = {.seed = 1, .sizes = {1000}};
+  TRY(parse_generator_args(argc, argv, "[num_lines]", 1, &config));
+
+  const size_t num_lines = config.sizes[0];
+
+  Rng rng = {0};
+  seed_rng(&rng, config.seed);
+
+  FILE * file = NULL;
+  TRY(open_generator_output(&config, &file));
+
+  for(size_t i = 0; i < num_lines; i++) {
+    const size_t length = get_random_in_range(&rng, 1, 40);
+    for(size_t c = 0; c < length; c++) { fputc('a' + (int)get_random_below(&rng, 26), file); }
+    fputc('\n', file);
+  }
+
+  TRY(close_generator_output(file));
+
+  return OK;
+}
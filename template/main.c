@@ -3,8 +3,19 @@
 #include <cfac/stat.h>
 #include <cfac/log.h>
 
+#include "common.h"
 #include "lib.h"
+#include "metrics.h"
 
 int main(void) {
-  return LOG_STAT(do_a_thing(), "so amaze");
-}
\ No newline at end of file
+  Metrics metrics = {0};
+  start_metrics(&metrics, "template");
+
+  begin_phase(&metrics, PHASE_PART1);
+  const STAT_Val res = do_a_thing();
+  end_phase(&metrics);
+
+  TRY(write_metrics(&metrics));
+
+  return LOG_STAT(res, "so amaze");
+}